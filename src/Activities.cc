@@ -67,6 +67,7 @@ Age_Map* Activities::Hospitalization_prob = NULL;
 Age_Map* Activities::Outpatient_healthcare_prob = NULL;
 
 Activities_Tracking_Data Activities::Tracking_data;
+Activities::HAZEL_Counters Activities::HAZEL_counters;
 
 // Childhood Presenteeism parameters
 double Activities::Sim_based_prob_stay_home_not_needed = 0.0;
@@ -202,10 +203,10 @@ Activities::Activities() {
 
 void Activities::setup(Person* self, Place* house, Place* school, Place* work) {
 
+  this->myself = self;
   FRED_VERBOSE(1, "ACTIVITIES_SETUP: person %d age %d household %s\n",
 	       this->myself->get_id(), this->myself->get_age(), house->get_label());
 
-  this->myself = self;
   clear_daily_activity_locations();
 
   FRED_VERBOSE(1, "set household %s\n", get_label_for_place(house));
@@ -394,18 +395,31 @@ void Activities::update(int sim_day) {
   Activities::is_weekday = Date::is_weekday();
 
   if(Global::Enable_HAZEL) {
-    Global::Daily_Tracker->set_index_key_pair(sim_day, SEEK_HC, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, PRIMARY_HC_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, HC_ACCEP_INS_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, HC_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, MEDICARE_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, ASTHMA_HC_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, DIABETES_HC_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, HTN_HC_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, MEDICAID_UNAV, 0);
-    Global::Daily_Tracker->set_index_key_pair(sim_day, MEDICARE_UNAV, 0);
-    Global::Daily_Tracker->increment_index_key_pair(sim_day, PRIVATE_UNAV, 1);
-    Global::Daily_Tracker->increment_index_key_pair(sim_day, UNINSURED_UNAV, 1);
+    Tracker<int>* tracker = Global::Daily_Tracker;
+    HAZEL_Counters &counters = Activities::HAZEL_counters;
+    counters.day = tracker->add_index(sim_day);
+    counters.seek_hc = tracker->get_key_handle(SEEK_HC, "int");
+    counters.primary_hc_unav = tracker->get_key_handle(PRIMARY_HC_UNAV, "int");
+    counters.hc_accep_ins_unav = tracker->get_key_handle(HC_ACCEP_INS_UNAV, "int");
+    counters.hc_unav = tracker->get_key_handle(HC_UNAV, "int");
+    counters.asthma_hc_unav = tracker->get_key_handle(ASTHMA_HC_UNAV, "int");
+    counters.diabetes_hc_unav = tracker->get_key_handle(DIABETES_HC_UNAV, "int");
+    counters.htn_hc_unav = tracker->get_key_handle(HTN_HC_UNAV, "int");
+    counters.medicaid_unav = tracker->get_key_handle(MEDICAID_UNAV, "int");
+    counters.medicare_unav = tracker->get_key_handle(MEDICARE_UNAV, "int");
+    counters.private_unav = tracker->get_key_handle(PRIVATE_UNAV, "int");
+    counters.uninsured_unav = tracker->get_key_handle(UNINSURED_UNAV, "int");
+    tracker->set_value(counters.day, counters.seek_hc, 0);
+    tracker->set_value(counters.day, counters.primary_hc_unav, 0);
+    tracker->set_value(counters.day, counters.hc_accep_ins_unav, 0);
+    tracker->set_value(counters.day, counters.hc_unav, 0);
+    tracker->set_value(counters.day, counters.medicare_unav, 0);
+    tracker->set_value(counters.day, counters.asthma_hc_unav, 0);
+    tracker->set_value(counters.day, counters.diabetes_hc_unav, 0);
+    tracker->set_value(counters.day, counters.htn_hc_unav, 0);
+    tracker->set_value(counters.day, counters.medicaid_unav, 0);
+    tracker->increment_value(counters.day, counters.private_unav, 1);
+    tracker->increment_value(counters.day, counters.uninsured_unav, 1);
   }
 
   // print out absenteeism/presenteeism counts
@@ -505,7 +519,7 @@ void Activities::update_schedule(int sim_day) {
     // only visit the hospital
     this->on_schedule[Activity_index::HOSPITAL_ACTIVITY] = true;
     if(Global::Enable_HAZEL) {
-      Global::Daily_Tracker->increment_index_key_pair(sim_day, SEEK_HC, 1);
+      Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.seek_hc, 1);
       Household* hh = static_cast<Household*>(this->myself->get_permanent_household());
       assert(hh != NULL);
       hh->set_count_seeking_hc(hh->get_count_seeking_hc() + 1);
@@ -1048,7 +1062,7 @@ void Activities::decide_whether_to_seek_healthcare(int sim_day) {
         assert(hh != NULL);
 
         if(Global::Enable_HAZEL) {
-          Global::Daily_Tracker->increment_index_key_pair(sim_day, SEEK_HC, 1);
+          Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.seek_hc, 1);
           hh->set_count_seeking_hc(hh->get_count_seeking_hc() + 1);
           if(!hh->is_seeking_healthcare()) {
             hh->set_seeking_healthcare(true);
@@ -1061,25 +1075,25 @@ void Activities::decide_whether_to_seek_healthcare(int sim_day) {
             //Update all of the statistics to reflect that primary care is not available
             hh->set_is_primary_healthcare_available(false);
             if(this->myself->is_asthmatic()) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, ASTHMA_HC_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.asthma_hc_unav, 1);
             }
             if(this->myself->is_diabetic()) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, DIABETES_HC_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.diabetes_hc_unav, 1);
             }
             if(this->myself->has_hypertension()) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, HTN_HC_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.htn_hc_unav, 1);
             }
             if(this->myself->get_health()->get_insurance_type() == Insurance_assignment_index::MEDICAID) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, MEDICAID_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.medicaid_unav, 1);
             } else if(this->myself->get_health()->get_insurance_type() == Insurance_assignment_index::MEDICARE) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, MEDICARE_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.medicare_unav, 1);
             } else if(this->myself->get_health()->get_insurance_type() == Insurance_assignment_index::PRIVATE) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, PRIVATE_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.private_unav, 1);
             } else if(this->myself->get_health()->get_insurance_type() == Insurance_assignment_index::UNINSURED) {
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, UNINSURED_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.uninsured_unav, 1);
             }
 
-            Global::Daily_Tracker->increment_index_key_pair(sim_day, PRIMARY_HC_UNAV, 1);
+            Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.primary_hc_unav, 1);
             hh->set_count_primary_hc_unav(hh->get_count_primary_hc_unav() + 1);
 
             //Now, try to Find an open health care provider that accepts agent's insurance
@@ -1087,12 +1101,12 @@ void Activities::decide_whether_to_seek_healthcare(int sim_day) {
             if(hosp == NULL) {
               hh->set_other_healthcare_location_that_accepts_insurance_available(false);
               hh->set_count_hc_accept_ins_unav(hh->get_count_hc_accept_ins_unav() + 1);
-              Global::Daily_Tracker->increment_index_key_pair(sim_day, HC_ACCEP_INS_UNAV, 1);
+              Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.hc_accep_ins_unav, 1);
 
               hosp = Global::Places.get_random_open_healthcare_facility_matching_criteria(sim_day, this->myself, false, false);
               if(hosp == NULL) {
                 hh->set_is_healthcare_available(false);
-                Global::Daily_Tracker->increment_index_key_pair(sim_day, HC_UNAV, 1);
+                Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.hc_unav, 1);
               }
             }
 
@@ -1219,23 +1233,23 @@ void Activities::start_hospitalization(int sim_day, int length_of_stay) {
     }
 
     if(Global::Enable_HAZEL) {
-      Global::Daily_Tracker->increment_index_key_pair(sim_day, SEEK_HC, 1);
+      Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.seek_hc, 1);
       hh->set_count_seeking_hc(hh->get_count_seeking_hc() + 1);
       if(!hosp->should_be_open(sim_day) || (hosp->get_occupied_bed_count() >= hosp->get_bed_count(sim_day))) {
         hh->set_is_primary_healthcare_available(false);
         hh->set_count_primary_hc_unav(hh->get_count_primary_hc_unav() + 1);
-        Global::Daily_Tracker->increment_index_key_pair(sim_day, PRIMARY_HC_UNAV, 1);
+        Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.primary_hc_unav, 1);
 
         //Find an open healthcare provider
         hosp = Global::Places.get_random_open_hospital_matching_criteria(sim_day, this->myself, true, false);
         if(hosp == NULL) {
           hh->set_other_healthcare_location_that_accepts_insurance_available(false);
           hh->set_count_hc_accept_ins_unav(hh->get_count_hc_accept_ins_unav() + 1);
-          Global::Daily_Tracker->increment_index_key_pair(sim_day, HC_ACCEP_INS_UNAV, 1);
+          Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.hc_accep_ins_unav, 1);
           hosp = Global::Places.get_random_open_hospital_matching_criteria(sim_day, this->myself, false, false);
           if(hosp == NULL) {
             hh->set_is_healthcare_available(false);
-            Global::Daily_Tracker->increment_index_key_pair(sim_day, HC_UNAV, 1);
+            Global::Daily_Tracker->increment_value(Activities::HAZEL_counters.day, Activities::HAZEL_counters.hc_unav, 1);
           }
         }
       }
@@ -1993,6 +2007,15 @@ void Activities::update_enrollee_index(Mixing_Group* mixing_group, int new_index
   assert(0);
 }
 
+int Activities::get_enrollee_index(Mixing_Group* mixing_group) {
+  for(int i = 0; i < Activity_index::DAILY_ACTIVITY_LOCATIONS; ++i) {
+    if(mixing_group == get_daily_activity_location(i) && this->link[i].is_enrolled()) {
+      return this->link[i].get_enrollee_index();
+    }
+  }
+  return -1;
+}
+
 ///////////////////////////////////
 
 void Activities::clear_daily_activity_locations() {
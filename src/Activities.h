@@ -613,6 +613,24 @@ private:
   
   static Activities_Tracking_Data Tracking_data;
 
+  // Daily_Tracker handles of today's index and of the HAZEL counters
+  // (ER_visit is added by its first increment), set in update()
+  struct HAZEL_Counters {
+    int day;
+    int seek_hc;
+    int primary_hc_unav;
+    int hc_accep_ins_unav;
+    int hc_unav;
+    int asthma_hc_unav;
+    int diabetes_hc_unav;
+    int htn_hc_unav;
+    int medicaid_unav;
+    int medicare_unav;
+    int private_unav;
+    int uninsured_unav;
+  };
+  static HAZEL_Counters HAZEL_counters;
+
   // sick days statistics
   static double Standard_sicktime_allocated_per_child;
 
@@ -638,6 +656,7 @@ private:
   void enroll_in_daily_activity_location(int i);
   void enroll_in_daily_activity_locations();
   void update_enrollee_index(Mixing_Group* mixing_group, int new_index);
+  int get_enrollee_index(Mixing_Group* mixing_group);
   void unenroll_from_daily_activity_location(int i);
   void unenroll_from_daily_activity_locations();
   void store_daily_activity_locations();
@@ -15,6 +15,7 @@
 //
 #include <iostream>
 #include <iomanip>
+#include <math.h>
 
 #include "Age_Map.h"
 #include "Params.h"
@@ -75,6 +76,7 @@ void Age_Map::read_from_input(string input) {
 
   Params::get_param_vector(ages_string, this->ages);
   Params::get_param_vector(values_string, this->values);
+  build_year_table();
 
   // restore requiring parameters
   Params::set_abort_on_failure();
@@ -94,6 +96,7 @@ void Age_Map::read_from_string(string ages_string, string values_string) {
   std::strcpy (vstr, values_string.c_str());
   Params::get_param_vector_from_string(astr, this->ages);
   Params::get_param_vector_from_string(vstr, this->values);
+  build_year_table();
 
   return;
 }
@@ -107,16 +110,52 @@ void Age_Map::set_all_values(double val) {
   }
   this->ages.push_back(Demographics::MAX_AGE);
   this->values.push_back(val);
+  build_year_table();
 }
 
-double Age_Map::find_value(double age) {
-  // printf("find_value: age = %.1f  groups %d \n", age, (int) this->ages.size());
+bool Age_Map::has_nonzero_value(double low, double high) const {
+  bool in_order = true;
+  for(unsigned int i = 1; i < this->ages.size(); i++) {
+    if(this->ages[i] < this->ages[i-1]) {
+      in_order = false;
+    }
+  }
   for(unsigned int i = 0; i < this->ages.size(); i++) {
-    if (age < this->ages[i]) {
-      return this->values[i];
+    if(this->values[i] == 0.0) {
+      continue;
+    }
+    // group i holds the ages from the previous upper age up to its own
+    if(!in_order || ((i == 0 || this->ages[i-1] <= high) && low < this->ages[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Age_Map::build_year_table() {
+  this->first_group_by_year.clear();
+  if(this->ages.empty()) {
+    return;
+  }
+  for(unsigned int i = 1; i < this->ages.size(); i++) {
+    if(this->ages[i] < this->ages[i-1]) {
+      // find_value scans every group
+      return;
+    }
+  }
+  double last_age = this->ages.back();
+  int years = (last_age < Demographics::MAX_AGE + 1 ? static_cast<int>(ceil(last_age)) : Demographics::MAX_AGE + 1);
+  if(years <= 0) {
+    return;
+  }
+  this->first_group_by_year.resize(years);
+  unsigned int i = 0;
+  for(int year = 0; year < years; year++) {
+    while(i < this->ages.size() && this->ages[i] <= year) {
+      i++;
     }
+    this->first_group_by_year[year] = i;
   }
-  return 0.0;
 }
 
 void Age_Map::print() const {
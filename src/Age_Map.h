@@ -16,6 +16,10 @@
 // Age_Map is a class that holds a set of age-specific ranged values
 // The age ranges must be mutually exclusive.
 //
+// Whenever the ages change, the map builds a table giving, for each whole
+// year of age, the first age group that can hold that year, so find_value
+// goes straight to the right group instead of scanning from the first.
+//
 #ifndef _FRED_AGEMAP_H
 #define _FRED_AGEMAP_H
 
@@ -96,6 +100,7 @@ public:
   
   void set_ages(vector<double> input_ages){
     ages = input_ages;
+    build_year_table();
   }
   
   void set_values(vector<double> input_values){
@@ -111,7 +116,24 @@ public:
    * @param (double) age the age to find
    * @return the found value
    */
-  double find_value(double age);
+  double find_value(double age) const {
+    unsigned int i = 0;
+    int years = this->first_group_by_year.size();
+    if(years > 0 && age >= 0.0) {
+      i = this->first_group_by_year[age < years ? static_cast<int>(age) : years - 1];
+    }
+    for(; i < this->ages.size(); i++) {
+      if (age < this->ages[i]) {
+        return this->values[i];
+      }
+    }
+    return 0.0;
+  }
+
+  /**
+   * @return whether find_value may be nonzero for an age from low to high
+   */
+  bool has_nonzero_value(double low, double high) const;
 
   // Utility functions
   /**
@@ -130,9 +152,16 @@ public:
   bool quality_control() const;
 
 private:
+  void build_year_table();
+
   string name;
   vector<double> ages; // vector to hold the upper age for each age group
   vector<double> values; // vector to hold the values for each age range
+
+  // for each whole year of age up to the last upper age (at most
+  // Demographics::MAX_AGE + 1 years), the first group whose upper age is
+  // above it; empty if the ages are not in increasing order
+  vector<int> first_group_by_year;
 };
 
 #endif
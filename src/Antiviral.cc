@@ -49,6 +49,7 @@ Antiviral::Antiviral(int _disease, int _course_length, double _reduce_infectivit
   efficacy                      = _efficacy;
   av_course_start_day           = _av_course_start_day;
   max_av_course_start_day       = _max_av_course_start_day;
+  course_start_day_table.set_cdf(_av_course_start_day, _max_av_course_start_day + 1);
   start_day                     = _start_day;
   prophylaxis                   = _prophylaxis;
   percent_symptomatics          = _percent_symptomatics;
@@ -64,7 +65,7 @@ int Antiviral::roll_efficacy() const {
 
 int Antiviral::roll_course_start_day() const {
   int days = 0;
-  days = Random::draw_from_distribution(max_av_course_start_day, av_course_start_day);
+  days = course_start_day_table.draw();
   return days;
 }
 
@@ -18,6 +18,7 @@
 #define _FRED_ANTIVIRAL_H
 
 #include "Global.h"
+#include "Random.h"
 #include <vector>
 #include <stdio.h>
 #include <iostream>
@@ -124,7 +125,7 @@ public:
   int roll_efficacy()                 const;
 
   /**
-   * Randomly determine the day to start (<code>draw_from_distribution(max_av_course_start_day, av_course_start_day)</code>)
+   * Randomly determine the day to start from the cdf av_course_start_day
    *
    * @return the number of days drawn
    */
@@ -295,6 +296,7 @@ private:
   double efficacy;                 // The effectiveness of the AV (resistance)
   int max_av_course_start_day;     // Maximum start day
   double* av_course_start_day;     // Probabilistic AV start
+  Alias_Table course_start_day_table; // draws from av_course_start_day
 
 private:
   //Logistics
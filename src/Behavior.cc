@@ -213,6 +213,8 @@ void Behavior::get_parameters_for_behavior(char* behavior_name, int j) {
     params->behavior_change_model_cdf[i] += cumm;
     cumm = params->behavior_change_model_cdf[i];
   }
+  params->behavior_change_model_table.set_cdf(params->behavior_change_model_cdf,
+					      params->behavior_change_model_cdf_size);
 
   printf("BEHAVIOR %s behavior_change_model_cdf: ", params->name);
   for(int i = 0; i < Behavior_change_model_enum::NUM_BEHAVIOR_CHANGE_MODELS; i++) {
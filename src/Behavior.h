@@ -19,6 +19,7 @@
 
 #include <stdio.h>
 #include "Global.h"
+#include "Random.h"
 
 class Intention;
 class Person;
@@ -61,6 +62,7 @@ typedef struct {
   int frequency;
   int behavior_change_model_cdf_size;
   double behavior_change_model_cdf[Behavior_change_model_enum::NUM_BEHAVIOR_CHANGE_MODELS];
+  Alias_Table behavior_change_model_table;	// draws from behavior_change_model_cdf
   int behavior_change_model_population[Behavior_change_model_enum::NUM_BEHAVIOR_CHANGE_MODELS];
   // FLIP
   double min_prob;
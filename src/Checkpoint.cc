@@ -0,0 +1,194 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Checkpoint.cc
+//
+
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Checkpoint.h"
+#include "Disease_List.h"
+#include "Global.h"
+#include "Infection_Log.h"
+#include "Log_Sink.h"
+#include "Params.h"
+#include "Random.h"
+#include "Utils.h"
+
+int Checkpoint::Runs = 0;
+int Checkpoint::Jobs = 1;
+bool Checkpoint::Runs_on_command_line = false;
+bool Checkpoint::Jobs_on_command_line = false;
+char Checkpoint::Run_params[FRED_STRING_SIZE];
+int Checkpoint::Threads = 1;
+
+void Checkpoint::parse_command_line(int &argc, char* argv[]) {
+  int n = 1;
+  for(int i = 1; i < argc; ++i) {
+    if(strcmp(argv[i], "--realizations") == 0 || strcmp(argv[i], "--jobs") == 0) {
+      if(i + 1 == argc) {
+        Utils::fred_abort("%s needs a value\n", argv[i]);
+      }
+      if(strcmp(argv[i], "--realizations") == 0) {
+        Checkpoint::Runs = atoi(argv[i + 1]);
+        Checkpoint::Runs_on_command_line = true;
+      } else {
+        Checkpoint::Jobs = atoi(argv[i + 1]);
+        Checkpoint::Jobs_on_command_line = true;
+      }
+      ++i;
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+}
+
+void Checkpoint::get_parameters() {
+  if(!Checkpoint::Runs_on_command_line) {
+    Params::get_param_from_string("checkpoint_runs", &Checkpoint::Runs);
+  }
+  if(!Checkpoint::Jobs_on_command_line) {
+    Params::get_param_from_string("checkpoint_jobs", &Checkpoint::Jobs);
+  }
+  if(Checkpoint::Jobs < 1) {
+    Checkpoint::Jobs = 1;
+  }
+  if(Checkpoint::Runs > 1 && get_checkpoint_day() >= Global::Days) {
+    FRED_WARNING("checkpoint day %d is after the last day; checkpoint_runs ignored\n", get_checkpoint_day());
+    Checkpoint::Runs = 0;
+  }
+  Params::get_param_from_string("checkpoint_run_params", Checkpoint::Run_params);
+#ifdef _OPENMP
+  // the OpenMP thread pool does not survive fork (a child blocks in its
+  // first parallel region), so the process runs with one thread up to the
+  // checkpoint and each run gets the threads back; the per-thread tables
+  // set up before then are sized for all of them
+  if(Checkpoint::Runs > 1 && fred::omp_get_max_threads() > 1) {
+    Checkpoint::Threads = fred::omp_get_max_threads();
+    fred::Max_threads = Checkpoint::Threads;
+    FRED_STATUS(0, "checkpoint_runs = %d: using one OpenMP thread until the checkpoint\n", Checkpoint::Runs);
+    fred::omp_set_num_threads(1);
+  }
+#endif
+}
+
+int Checkpoint::get_checkpoint_day() {
+  return Global::Reseed_day > 0 ? Global::Reseed_day : 0;
+}
+
+void Checkpoint::restore_runs(int day) {
+  if(Checkpoint::Runs <= 1 || day != get_checkpoint_day()) {
+    return;
+  }
+  int first_run = Global::Simulation_run_number;
+  int last_run = first_run + Checkpoint::Runs - 1;
+  Utils::fred_print_wall_time("FRED checkpoint at day %d for runs %d-%d, %d at a time", day, first_run, last_run,
+			      Checkpoint::Jobs);
+  // each run starts with the output written so far (and the infection
+  // log's writer thread, which would not survive fork, has finished)
+  Infection_Log::finish();
+  Log_Sink::finish();
+  for(int run = first_run; run <= last_run; ++run) {
+    char directory[FRED_STRING_SIZE];
+    sprintf(directory, "%s/RUN%d", Global::Simulation_directory, run);
+    Utils::fred_make_directory(directory);
+    Utils::fred_copy_output_files(directory, run);
+  }
+  // nothing buffered may be inherited, or each child would write it again
+  fflush(NULL);
+
+  std::map<pid_t, int> running;
+  int failures = 0;
+  int next_run = first_run;
+  while(next_run <= last_run || !running.empty()) {
+    if(next_run <= last_run && static_cast<int>(running.size()) < Checkpoint::Jobs) {
+      pid_t pid = fork();
+      if(pid < 0) {
+        Utils::fred_abort("Help! fork failed for run %d\n", next_run);
+      }
+      if(pid == 0) {
+        start_run(next_run, day);
+        return;
+      }
+      running[pid] = next_run;
+      ++next_run;
+      continue;
+    }
+    int status = 0;
+    pid_t pid = wait(&status);
+    if(pid < 0) {
+      Utils::fred_abort("Help! wait failed with %d runs left\n", static_cast<int>(running.size()));
+    }
+    int run = running[pid];
+    running.erase(pid);
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      FRED_WARNING("run %d did not finish normally (status %d)\n", run, status);
+      ++failures;
+    } else {
+      Utils::fred_print_wall_time("FRED run %d finished", run);
+    }
+  }
+  // the runs have complete copies of what this process wrote
+  Utils::fred_remove_output_files();
+  Utils::fred_print_wall_time("FRED checkpoint runs finished with %d failures", failures);
+  exit(failures == 0 ? 0 : 1);
+}
+
+void Checkpoint::start_run(int run, int day) {
+  char directory[FRED_STRING_SIZE];
+  sprintf(directory, "%s/RUN%d", Global::Simulation_directory, run);
+  char log_file[FRED_STRING_SIZE];
+  sprintf(log_file, "%s/LOG%d", directory, run);
+  if(freopen(log_file, "w", stdout) == NULL) {
+    Utils::fred_abort("Can't open %s\n", log_file);
+  }
+  Utils::fred_reopen_output_files(directory, run);
+  strcpy(Global::Simulation_directory, directory);
+  strcpy(Global::Output_directory, directory);
+#ifdef _OPENMP
+  fred::omp_set_num_threads(Checkpoint::Threads);
+#endif
+  if(run != Global::Simulation_run_number) {
+    Global::Simulation_run_number = run;
+    if(Global::Reseed_day == -1) {
+      // the same seed a separate invocation of this run would use
+      Global::Simulation_seed = Global::Seed * 100 + (run - 1);
+      Random::set_seed(Global::Simulation_seed);
+    }
+  }
+  read_run_parameters(run);
+  Utils::fred_print_wall_time("FRED run %d restored from checkpoint at day %d", run, day);
+}
+
+void Checkpoint::read_run_parameters(int run) {
+  if(strcmp(Checkpoint::Run_params, "none") == 0) {
+    return;
+  }
+  char paramfile[FRED_STRING_SIZE];
+  sprintf(paramfile, Checkpoint::Run_params, run);
+  // a run without its own file keeps the parameters of the checkpoint
+  FILE* fp = Utils::fred_open_file(paramfile);
+  if(fp == NULL) {
+    return;
+  }
+  fclose(fp);
+  // later entries override earlier ones, so this file takes precedence
+  // over the defaults and the params file
+  Params::read_parameter_file(paramfile);
+  Global::Diseases.get_run_parameters();
+}
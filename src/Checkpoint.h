@@ -0,0 +1,77 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Checkpoint.h
+//
+// Runs several realizations from one initialization.  When more than one
+// run is requested (checkpoint_runs, or --realizations on the command
+// line), the process stops at the checkpoint (the start of day
+// reseed_day, or the end of initialization if reseed_day = -1) and forks
+// one child per run, keeping up to checkpoint_jobs (--jobs) of them
+// running at once.  Each child is a copy-on-write image of the simulation
+// state at that point: it takes its run number, reseeds, moves its output
+// (including its log) to OUT/RUN<n> and carries on with fred_step.  The
+// parent waits and exits when all runs are done.
+//
+// With reseed_day >= 0, every run is identical to a separate invocation
+// with the same run number, since those share all days before the reseed.
+// With reseed_day = -1, the first run is identical to a separate
+// invocation and the later runs share its initialization (synthetic
+// population assignments) but are reseeded from day 0 with their own seed.
+//
+// The runs can differ in their epidemic parameters: if checkpoint_run_params
+// names a file (a pattern with %d for the run number), each run reads it
+// after the fork, if it exists, and takes the transmissibility and primary
+// cases of each disease from it.  Parameters the state at the checkpoint
+// was built from (the population, places, etc.) can't change.
+//
+// The OpenMP thread pool does not survive a fork, so OpenMP builds run
+// with a single thread up to the checkpoint, and each run then goes on
+// with the full number of threads.
+//
+
+#ifndef _FRED_CHECKPOINT_H
+#define _FRED_CHECKPOINT_H
+
+class Checkpoint {
+public:
+  /**
+   * Take --realizations N and --jobs K out of the command line, leaving
+   * the positional arguments.
+   */
+  static void parse_command_line(int &argc, char* argv[]);
+
+  static void get_parameters();
+
+  /**
+   * Called at the start of each day.  On the checkpoint day this returns
+   * once in each child process, set up as its run; the parent does not
+   * return.
+   */
+  static void restore_runs(int day);
+
+  static int get_checkpoint_day();
+
+private:
+  static void start_run(int run, int day);
+  static void read_run_parameters(int run);
+
+  static int Runs;
+  static int Jobs;
+  static bool Runs_on_command_line;
+  static bool Jobs_on_command_line;
+  static char Run_params[];
+  static int Threads;
+};
+
+#endif // _FRED_CHECKPOINT_H
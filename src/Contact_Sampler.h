@@ -0,0 +1,203 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Contact_Sampler.h
+//
+// Contact_Sampler places a number of contacts uniformly, with
+// replacement, among a range of slots, without drawing each contact.
+// It visits only the slots that receive at least one contact, in
+// increasing order, together with the number of contacts each received.
+// The result has exactly the distribution of drawing every contact
+// separately and counting the draws per slot, but it takes at most two
+// random draws per visited slot and no storage.
+//
+// The lowest slot hit by c draws over m slots is floor(m * (1 - U^(1/c)));
+// the number of draws landing on it is Binomial(c, 1/(m - offset))
+// conditioned on at least one; the rest are uniform over the slots above.
+//
+// The contact processes of Respiratory_Transmission's default and
+// skip-sampling models live here as well (draw_contacts and
+// Contact_Targets), so that TestSuite/Transmission validates the code
+// the models run.
+//
+
+#ifndef _FRED_CONTACT_SAMPLER_H
+#define _FRED_CONTACT_SAMPLER_H
+
+#include <math.h>
+#include <map>
+#include <vector>
+
+#include "Random.h"
+
+class Contact_Sampler {
+public:
+  Contact_Sampler(int contacts, int slots) {
+    this->remaining = contacts;
+    this->slots = slots;
+    this->next_slot = 0;
+    this->slot = -1;
+    this->hits = 0;
+  }
+
+  /**
+   * Move to the next slot that receives a contact.  Returns false once
+   * every contact has been placed.
+   */
+  bool next() {
+    if(this->remaining <= 0 || this->next_slot >= this->slots) {
+      return false;
+    }
+    int m = this->slots - this->next_slot;
+    double u = Random::draw_random();
+    if(this->remaining > 1) {
+      u = pow(u, 1.0 / this->remaining);
+    }
+    int offset = static_cast<int>(m * (1.0 - u));
+    if(offset >= m) {
+      offset = m - 1;
+    }
+    this->slot = this->next_slot + offset;
+    this->hits = draw_hits(this->remaining, 1.0 / (m - offset));
+    this->remaining -= this->hits;
+    this->next_slot = this->slot + 1;
+    return true;
+  }
+
+  int get_slot() const {
+    return this->slot;
+  }
+
+  int get_hits() const {
+    return this->hits;
+  }
+
+  /**
+   * The contacts of one infector in the default model, one draw per
+   * contact: a draw below the number of susceptibles is a contact with
+   * that susceptible, and sampling_map counts the draws per position.
+   * A draw on the infector itself is redrawn, or ends the draws if the
+   * infector is the only susceptible.
+   */
+  template <class T>
+  static void draw_contacts(int contact_count, int number_targets, const std::vector<T> &susceptibles,
+			    const T &infector, std::map<int, int> &sampling_map) {
+    int number_of_susceptibles = susceptibles.size();
+    for(int c = 0; c < contact_count; ++c) {
+      // select a target infectee from among susceptibles with replacement
+      int pos = Random::draw_random_int(0, number_targets - 1);
+      if(pos < number_of_susceptibles) {
+        if(infector == susceptibles[pos]) {
+          if(number_of_susceptibles > 1) {
+            --(c); // redo
+            continue;
+          } else {
+            break; // give up
+          }
+        }
+        sampling_map[pos]++;
+      }
+    }
+  }
+
+  /**
+   * The probability that at least one of several independent attempts
+   * with probability prob succeeds.
+   */
+  static double prob_of_any(double prob, int attempts) {
+    if(attempts > 1 && prob < 1.0) {
+      return 1.0 - pow(1.0 - prob, attempts);
+    }
+    return prob;
+  }
+
+private:
+  // Binomial(n, p) conditioned on at least one success, by inversion
+  static int draw_hits(int n, double p) {
+    if(n == 1 || p >= 1.0) {
+      return n;
+    }
+    double q = 1.0 - p;
+    double q_n1 = pow(q, n - 1);
+    double u = Random::draw_random() * (1.0 - q * q_n1);
+    double prob = n * p * q_n1;
+    int k = 1;
+    while(u >= prob && k < n) {
+      u -= prob;
+      prob *= static_cast<double>(n - k) / (k + 1) * p / q;
+      ++k;
+    }
+    return k;
+  }
+
+  int remaining;
+  int slots;
+  int next_slot;
+  int slot;
+  int hits;
+};
+
+// The contacts of one infector in the skip-sampling model: the same
+// contact process as draw_contacts, over the number_targets slots other
+// than the infector's own (self, or -1 if the infector is not among the
+// susceptibles).  Visits the susceptibles contacted, in increasing
+// position.
+class Contact_Targets {
+public:
+  Contact_Targets(int contacts, int number_targets, int number_of_susceptibles, int self)
+    : sampler(contacts, self >= 0 ? number_targets - 1 : number_targets) {
+    this->number_of_susceptibles = number_of_susceptibles;
+    this->self = self;
+    this->target = -1;
+    // no one else to contact
+    this->done = (self >= 0 && number_of_susceptibles == 1);
+  }
+
+  /**
+   * Move to the next susceptible contacted.  Returns false once the
+   * contacts are used up or fall beyond the susceptibles.
+   */
+  bool next() {
+    if(this->done || this->sampler.next() == false) {
+      return false;
+    }
+    int pos = this->sampler.get_slot();
+    if(this->self >= 0 && pos >= this->self) {
+      ++pos;
+    }
+    if(pos >= this->number_of_susceptibles) {
+      // the remaining slots are empty
+      this->done = true;
+      return false;
+    }
+    this->target = pos;
+    return true;
+  }
+
+  int get_target() const {
+    return this->target;
+  }
+
+  int get_hits() const {
+    return this->sampler.get_hits();
+  }
+
+private:
+  Contact_Sampler sampler;
+  int number_of_susceptibles;
+  int self;
+  int target;
+  bool done;
+};
+
+#endif // _FRED_CONTACT_SAMPLER_H
@@ -69,6 +69,13 @@ public:
    */
   double get_real_age() const;
 
+  /**
+   * @return the agent's birthday in simulation time
+   */
+  int get_birthday_sim_day() const {
+    return this->birthday_sim_day;
+  }
+
   /**
    * @return the agent's age
    */
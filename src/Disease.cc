@@ -71,6 +71,10 @@ Disease::Disease() {
 Disease::~Disease() {
   delete this->epidemic;
   delete this->residual_immunity;
+  for(std::map<int, Age_Map*>::iterator i = this->residual_immunity_by_FIPS.begin();
+      i != this->residual_immunity_by_FIPS.end(); ++i) {
+    delete i->second;
+  }
   if (this->at_risk != NULL) {
     delete this->at_risk;
   }
@@ -97,13 +101,7 @@ void Disease::get_parameters(int disease_id, string name) {
   FRED_VERBOSE(0, "disease %d %s read_parameters entered\n", this->id, this->disease_name);
   
   // contagiousness
-  // Note: the following tries first to find "trans" but falls back to "transmissibility":
-  Params::disable_abort_on_failure();
-  int found = Params::get_indexed_param(this->disease_name, "trans", &(this->transmissibility));
-  Params::set_abort_on_failure();
-  if (found == 0) {
-    Params::get_indexed_param(this->disease_name, "transmissibility", &(this->transmissibility));
-  }
+  read_transmissibility();
   
   // type of natural history and transmission mode
   Params::get_indexed_param(this->disease_name, "natural_history_model", this->natural_history_model);
@@ -119,16 +117,6 @@ void Disease::get_parameters(int disease_id, string name) {
   Params::set_abort_on_failure();
 
 
-  // convenience parameters (for single disease simulations only)
-  if (this->id == 0) {
-    Params::get_param_from_string("R0", &this->R0);
-    Params::get_param_from_string("R0_a", &this->R0_a);
-    Params::get_param_from_string("R0_b", &this->R0_b);
-    if(this->R0 > 0) {
-      this->transmissibility = this->R0_a * this->R0 * this->R0 + this->R0_b * this->R0;
-    }
-  }
-
   // variation over time of year
   if(Global::Enable_Climate) {
     Params::get_indexed_param(this->disease_name, "seasonality_multiplier_min",
@@ -214,6 +202,36 @@ void Disease::get_parameters(int disease_id, string name) {
   FRED_VERBOSE(0, "disease %d %s read_parameters finished\n", this->id, this->disease_name);
 }
 
+void Disease::read_transmissibility() {
+  // Note: the following tries first to find "trans" but falls back to "transmissibility":
+  Params::disable_abort_on_failure();
+  int found = Params::get_indexed_param(this->disease_name, "trans", &(this->transmissibility));
+  Params::set_abort_on_failure();
+  if (found == 0) {
+    Params::get_indexed_param(this->disease_name, "transmissibility", &(this->transmissibility));
+  }
+
+  // convenience parameters (for single disease simulations only)
+  if (this->id == 0) {
+    Params::get_param_from_string("R0", &this->R0);
+    Params::get_param_from_string("R0_a", &this->R0_a);
+    Params::get_param_from_string("R0_b", &this->R0_b);
+    if(this->R0 > 0) {
+      this->transmissibility = this->R0_a * this->R0 * this->R0 + this->R0_b * this->R0;
+    }
+  }
+}
+
+void Disease::get_run_parameters() {
+  double old_transmissibility = this->transmissibility;
+  read_transmissibility();
+  if(old_transmissibility == 0.0 && this->transmissibility > 0.0) {
+    // the transmission mode was never set up
+    Utils::fred_abort("Help! %s can't become transmissible after the checkpoint\n", this->disease_name);
+  }
+  this->epidemic->read_time_step_map();
+}
+
 void Disease::setup() {
 
   FRED_VERBOSE(0, "disease %d %s setup entered\n", this->id, this->disease_name);
@@ -291,12 +309,26 @@ void Disease::read_residual_immunity_by_FIPS() {
     }
     std::vector<double> temp_vector;
     Params::get_param_vector_from_string(values_string, temp_vector);
-    this->residual_immunity_by_FIPS.insert(std::pair<int, vector<double> > (fips_int,temp_vector) );
+    // built once here rather than for each person in the county
+    Age_Map* temp_map = new Age_Map("Residual Immunity by FIPS");
+    temp_map->set_ages(this->residual_immunity->get_ages());
+    temp_map->set_values(temp_vector);
+    std::pair<std::map<int, Age_Map*>::iterator, bool> inserted =
+      this->residual_immunity_by_FIPS.insert(std::pair<int, Age_Map*>(fips_int, temp_map));
+    if(!inserted.second) {
+      // the first line for a county wins, as before
+      delete temp_map;
+    }
   }
+  fclose(fp);
 }
 
-vector<double> Disease::get_residual_immunity_values_by_FIPS(int FIPS_int) {
-  return residual_immunity_by_FIPS[FIPS_int];
+Age_Map* Disease::get_residual_immunity_by_FIPS(int FIPS_int) {
+  std::map<int, Age_Map*>::iterator found = this->residual_immunity_by_FIPS.find(FIPS_int);
+  if(found == this->residual_immunity_by_FIPS.end()) {
+    return NULL;
+  }
+  return found->second;
 }
 
 void Disease::print_stats(int day) {
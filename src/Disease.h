@@ -41,6 +41,12 @@ public:
 
   void get_parameters(int disease, string name);
 
+  /**
+   * Read again the parameters a checkpoint run may change: the
+   * transmissibility and the primary cases.
+   */
+  void get_run_parameters();
+
   /**
    * Set all of the attributes for the Disease
    */
@@ -158,8 +164,13 @@ public:
   }
 
   void read_residual_immunity_by_FIPS();
+  void read_transmissibility();
   
-  vector<double> get_residual_immunity_values_by_FIPS(int FIPS_string);
+  /**
+   * @return the residual immunity by age for a county, or NULL if the
+   * residual_immunity_by_FIPS_file has no line for it
+   */
+  Age_Map* get_residual_immunity_by_FIPS(int FIPS_int);
    
   char* get_natural_history_model() {
     return this->natural_history_model;
@@ -220,7 +231,8 @@ private:
   Epidemic* epidemic;
   Age_Map* at_risk;
   Age_Map* residual_immunity;
-  std::map<int, vector<double> > residual_immunity_by_FIPS;
+  // one map per county, over the residual_immunity ages
+  std::map<int, Age_Map*> residual_immunity_by_FIPS;
 
   // variation over time of year
   double seasonality_max, seasonality_min;
@@ -45,6 +45,12 @@ void Disease_List::get_parameters() {
   }
 }
 
+void Disease_List::get_run_parameters() {
+  for(int disease_id = 0; disease_id < this->number_of_diseases; ++disease_id) {
+    this->diseases[disease_id]->get_run_parameters();
+  }
+}
+
 void Disease_List::setup() {
   for(int disease_id = 0; disease_id < this->number_of_diseases; ++disease_id) {
     this->diseases[disease_id]->setup();
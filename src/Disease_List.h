@@ -34,6 +34,8 @@ public:
 
   void get_parameters();
 
+  void get_run_parameters();
+
   void setup();
 
   Disease* get_disease(int disease_id) {
@@ -15,6 +15,7 @@
 //
 #include <stdlib.h>
 #include <stdio.h>
+#include <algorithm>
 #include <new>
 #include <iostream>
 #include <vector>
@@ -38,7 +39,9 @@ using namespace std;
 #include "Place.h"
 #include "Place_List.h"
 #include "Population.h"
+#include "Profile.h"
 #include "Random.h"
+#include "Respiratory_Transmission.h"
 #include "School.h"
 #include "Sexual_Transmission_Network.h"
 #include "Tracker.h"
@@ -229,49 +232,45 @@ void Epidemic::terminate_person(Person* person, int day) {
 	       person->get_id(), day);
 
   // cancel any events for this person
-  int date = person->get_symptoms_start_date(this->id);
-  if(date > day) {
-    FRED_VERBOSE(0, "EPIDEMIC CANCEL symptoms_start_date %d %d\n", date, day);
-    cancel_symptoms_start(date, person);
-  }
-  else if (date > -1) {
-    date = person->get_symptoms_end_date(this->id);
-    if(date > day) {
-      FRED_VERBOSE(0, "EPIDEMIC CANCEL symptoms_end_date %d %d\n", date, day);
-      cancel_symptoms_end(date, person);
-    }
-  }
-
-  date = person->get_infectious_start_date(this->id);
-  if(date > day) {
-    FRED_VERBOSE(0, "EPIDEMIC CANCEL infectious_start_date %d %d\n", date, day);
-    cancel_infectious_start(date, person);
-  }
-  else if (date > -1) {
-    date = person->get_infectious_end_date(this->id);
-    if(date > day) {
-      FRED_VERBOSE(0, "EPIDEMIC CANCEL infectious_end_date %d %d\n", date, day);
-      cancel_infectious_end(date, person);
-    }
-  }
+  cancel_infection_events(person);
 
-  date = person->get_immunity_end_date(this->id);
+  int date = person->get_immunity_end_date(this->id);
   if(date > day) {
     FRED_VERBOSE(0, "EPIDEMIC CANCEL immunity_end_date %d %d\n", date, day);
     cancel_immunity_end(date, person);
   }
 
+  remove_from_active_sets(person);
+
   FRED_VERBOSE(1, "EPIDEMIC TERMINATE finished\n");
 }
 
+void Epidemic::cancel_infection_events(Person* person) {
+  // whatever is still queued for this infection: the dates alone do not
+  // tell whether today's events have run, or whether become_exposed
+  // moved a start to the next day
+  this->symptoms_start_event_queue->delete_pending_event(person);
+  this->symptoms_end_event_queue->delete_pending_event(person);
+  this->infectious_start_event_queue->delete_pending_event(person);
+  this->infectious_end_event_queue->delete_pending_event(person);
+}
 
-void Epidemic::setup() {
-  using namespace Utils;
-  char paramstr[FRED_STRING_SIZE];
+void Epidemic::remove_from_active_sets(Person* person) {
+  // the active sets are keyed by population index, which will be reused
+  this->infected_people.erase(person);
+  this->potentially_infectious_people.erase(person);
+}
+
+
+void Epidemic::read_time_step_map() {
   char map_file_name[FRED_STRING_SIZE];
   int temp;
 
-  // read time_step_map
+  for(int i = 0; i < this->imported_cases_map.size(); ++i) {
+    delete this->imported_cases_map[i];
+  }
+  this->imported_cases_map.clear();
+
   Params::get_param_from_string("primary_cases_file", map_file_name);
   // If this parameter is "none", then there is no map
   if(strncmp(map_file_name, "none", 4) != 0){
@@ -326,6 +325,15 @@ void Epidemic::setup() {
   this->import_by_age = (temp == 0 ? false : true);
   Params::get_param_from_string("seed_age_lower_bound", &import_age_lower_bound);
   Params::get_param_from_string("seed_age_upper_bound", &import_age_upper_bound);
+}
+
+void Epidemic::setup() {
+  using namespace Utils;
+  char paramstr[FRED_STRING_SIZE];
+  int temp;
+
+  // read time_step_map
+  read_time_step_map();
   Params::get_param_from_string("report_generation_time", &temp);
   this->report_generation_time = (temp > 0);
   Params::get_param_from_string("report_transmission_by_age", &temp);
@@ -879,7 +887,7 @@ void Epidemic::report_incidence_by_county(int day) {
   int infected = this->people_becoming_infected_today;
   for(int i = 0; i < infected; ++i) {
     Person* infectee = this->daily_infections_list[i];
-    FRED_VERBOSE(0, "person %d is %d out of %d\n", infectee->get_id(), i, infected);
+    FRED_VERBOSE(1, "person %d is %d out of %d\n", infectee->get_id(), i, infected);
     Household* hh = static_cast<Household*>(infectee->get_household());
     if(hh == NULL) {
       if(Global::Enable_Hospitals && infectee->is_hospitalized() && infectee->get_permanent_household() != NULL) {
@@ -890,7 +898,7 @@ void Epidemic::report_incidence_by_county(int day) {
     int c = hh->get_county_index();
     assert(0 <= c && c < this->counties);
     this->county_incidence[c]++;
-    FRED_VERBOSE(0, "county %d incidence %d %d out of %d person %d \n", c, this->county_incidence[c], i, infected, infectee->get_id());
+    FRED_VERBOSE(1, "county %d incidence %d %d out of %d person %d \n", c, this->county_incidence[c], i, infected, infectee->get_id());
   }
   FRED_VERBOSE(1, "county incidence day %d\n", day);
   for(int c = 0; c < this->counties; ++c) {
@@ -1762,19 +1770,27 @@ void Epidemic::process_immunity_end_events(int day) {
   this->immunity_end_event_queue->clear_events(day);
 }
 
+// profile region names of the active place types
+static const char* Active_place_type_name[] = {
+  "household", "neighborhood", "school", "classroom", "workplace", "office", "hospital"
+};
+
 void Epidemic::update(int day) {
 
   FRED_VERBOSE(0, "epidemic update for disease %d day %d\n", id, day);
-  Utils::fred_start_epidemic_timer();
+  FRED_PROFILE("epidemic_update", this->id);
+  FRED_PROFILE_PHASES(phases);
 
   // import infections from unknown sources
+  FRED_PROFILE_PHASE(phases, "imported_infections");
   get_imported_infections(day);
-  // Utils::fred_print_epidemic_timer("imported infections");
 
   // update markov transitions
+  FRED_PROFILE_PHASE(phases, "markov_updates");
   markov_updates(day);
 
   // transition to infectious
+  FRED_PROFILE_PHASE(phases, "transition_events");
   process_infectious_start_events(day);
 
   // transition to noninfectious
@@ -1792,50 +1808,29 @@ void Epidemic::update(int day) {
   // transition to susceptible
   process_immunity_end_events(day);
 
-  // Utils::fred_print_epidemic_timer("transition events");
 
   // update list of infected people
-  for(std::set<Person*>::iterator it = this->infected_people.begin(); it != this->infected_people.end(); ) {
-    Person* person = (*it);
-    FRED_VERBOSE(1, "update_infection for person %d day %d\n", person->get_id(), day);
-    person->update_infection(day, this->id);
-
-    // handle case fatality
-    if(person->is_case_fatality(this->id)) {
-      // update epidemic fatality counters
-      this->daily_case_fatality_count++;
-      this->total_case_fatality_count++;
-      // record removed person
-      this->removed_people++;
-    }
-
-    // note: case fatalities will be uninfected at this point
-    if(person->is_infected(this->id) == false) {
-      FRED_VERBOSE(1, "update_infection for person %d day %d - deleting from infected_people list\n", person->get_id(), day);
-      // delete from infected list
-      this->infected_people.erase(it++);
-    } else {
-      // update person's mixing group infection counters
-      person->update_household_counts(day, this->id);
-      person->update_school_counts(day, this->id);
-      // move on the next infected person    
-      ++it;
-    }
+  FRED_PROFILE_PHASE(phases, "update_infected_people");
+  if(Global::Enable_Parallel_Infection_Update) {
+    update_infected_people_in_parallel(day);
+  } else {
+    update_infected_people(day);
   }
 
   // get list of actually infectious people
+  FRED_PROFILE_PHASE(phases, "find_infectious_people");
   this->actually_infectious_people.clear();
-  for(std::set<Person*>::iterator it = this->potentially_infectious_people.begin(); it != this->potentially_infectious_people.end(); ++it) {
-    Person* person = (*it);
+  for(int i = 0; i < this->potentially_infectious_people.size(); ++i) {
+    Person* person = this->potentially_infectious_people.get_member(i);
     if(person->is_infectious(this->id)) {
       this->actually_infectious_people.push_back(person);
       FRED_VERBOSE(1, "ACTUALLY INF person %d\n", person->get_id());
     }
   }
   this->infectious_people = this->actually_infectious_people.size();
-  // Utils::fred_print_epidemic_timer("identifying actually infections people");
 
   // update the daily activities of infectious people
+  FRED_PROFILE_PHASE(phases, "update_schedules");
   for(int i = 0; i < this->infectious_people; ++i) {
     Person* person = this->actually_infectious_people[i];
 
@@ -1847,23 +1842,24 @@ void Epidemic::update(int day) {
     } else {
       FRED_VERBOSE(1, "updating activities of infectious person %d -- %d out of %d\n", person->get_id(), i, this->infectious_people);
       person->update_activities_of_infectious_person(day);
-      // note: infectious person will be added to the daily places in find_active_places_of_type()
+      // note: infectious person will be added to the daily places in find_active_places()
     }
   }
-  Utils::fred_print_epidemic_timer("scheduled updated");
 
   if(strcmp("sexual", this->disease->get_transmission_mode()) == 0) {
+    FRED_PROFILE_PHASE(phases, "spread_infection");
     Sexual_Transmission_Network* st_network = Global::Sexual_Partner_Network;
     this->disease->get_transmission()->spread_infection(day, this->id, st_network);
     st_network->clear_infectious_people(this->id);
   } else {
     // spread infection in places attended by actually infectious people
-    for(int type = 0; type < 7; ++type) {
-      find_active_places_of_type(day, type);
-      spread_infection_in_active_places(day);
-      char msg[80];
-      sprintf(msg, "spread_infection for type %d", type);
-      Utils::fred_print_epidemic_timer(msg);
+    FRED_PROFILE_PHASE(phases, "find_active_places");
+    find_active_places(day);
+    FRED_PROFILE_PHASE(phases, "spread_infection");
+    for(int type = 0; type < ACTIVE_PLACE_TYPES; ++type) {
+      FRED_PROFILE(Active_place_type_name[type]);
+      fill_active_places(type);
+      spread_infection_in_active_places(day, type);
     }
   }
 
@@ -1871,100 +1867,193 @@ void Epidemic::update(int day) {
   return;
 }
 
-void Epidemic::find_active_places_of_type(int day, int place_type) {
-
-  FRED_VERBOSE(1, "find_active_places_of_type %d\n", place_type);
-  this->active_places.clear();
-  FRED_VERBOSE(1, "find_active_places_of_type %d actual %d\n", place_type, this->infectious_people);
-  for(int i = 0; i < this->infectious_people; i++) {
-    Person* person =  this->actually_infectious_people[i];
-    assert(person!=NULL);
-    Place* place = NULL;
-    switch(place_type) {
-    case 0:
-      place = person->get_household();
-      break;
-    case 1:
-      place = person->get_neighborhood();
-      break;
-    case 2:
-      place = person->get_school();
-      break;
-    case 3:
-      place = person->get_classroom();
-      break;
-    case 4:
-      place = person->get_workplace();
-      break;
-    case 5:
-      place = person->get_office();
-      break;
-    case 6:
-      place = person->get_hospital();
-      break;
+void Epidemic::update_infected_people(int day) {
+  for(int i = 0; i < this->infected_people.size(); ) {
+    Person* person = this->infected_people.get_member(i);
+    FRED_VERBOSE(1, "update_infection for person %d day %d\n", person->get_id(), day);
+    person->update_infection(day, this->id);
+
+    // handle case fatality
+    if(person->is_case_fatality(this->id)) {
+      // update epidemic fatality counters
+      this->daily_case_fatality_count++;
+      this->total_case_fatality_count++;
+      // record removed person
+      this->removed_people++;
     }
-    FRED_VERBOSE(1, "find_active_places_of_type %d person %d place %s\n", place_type, person->get_id(), place? place->get_label() : "NULL");
-    if(place != NULL && person->is_present(day, place) && person->is_infectious(this->id)) {
-      FRED_VERBOSE(1, "add_infection_person %d place %s\n", person->get_id(), place->get_label());
-      place->add_infectious_person(this->id, person);
-      this->active_places.insert(place);
+
+    // note: case fatalities will be uninfected at this point
+    if(person->is_infected(this->id) == false) {
+      FRED_VERBOSE(1, "update_infection for person %d day %d - deleting from infected_people list\n", person->get_id(), day);
+      // delete from infected list (the last member moves into slot i)
+      this->infected_people.erase(person);
+    } else {
+      // update person's mixing group infection counters
+      person->update_household_counts(day, this->id);
+      person->update_school_counts(day, this->id);
+      // move on the next infected person    
+      ++i;
     }
   }
-  
-  // vector transmission mode (for dengue and chikungunya)
-  if(strcmp("vector",this->disease->get_transmission_mode()) == 0) {
-
-    // add all places that have any infectious vectors
-    int size = 0;
-    switch (place_type) {
-    case 0:
-      // add households
-      size = Global::Places.get_number_of_households();
-      for(int i = 0; i < size; ++i) {
-	      Place* place = Global::Places.get_household(i);
-	      if(place->get_infectious_vectors(this->id) > 0) {
-	        this->active_places.insert(place);
-	      }
-      }
-      break;
-    case 2:
-      // add schools
-      size = Global::Places.get_number_of_schools();
-      for(int i = 0; i < size; ++i) {
-	      Place* place = Global::Places.get_school(i);
-	      if(place->get_infectious_vectors(this->id) > 0) {
-	        this->active_places.insert(place);
-	      }
+}
+
+void Epidemic::update_infected_people_in_parallel(int day) {
+  int size = this->infected_people.size();
+  FRED_VERBOSE(1, "update_infected_people_in_parallel day %d disease %d size %d\n", day, this->id, size);
+
+  // Advancing an infection only changes the person's own state, so it
+  // runs in parallel; anything shared is left to the serial pass below.
+  std::vector<char> fatal(size);
+#pragma omp parallel for schedule(dynamic, 256)
+  for(int i = 0; i < size; ++i) {
+    Person* person = this->infected_people.get_member(i);
+    Random::begin_person_stream(day, this->id, person->get_id());
+    fatal[i] = person->advance_infection(day, this->id);
+    Random::end_stream();
+  }
+
+  // Collect the case fatalities in list order before committing any: a
+  // commit may erase the person from infected_people, which moves the
+  // last member into the freed slot.
+  std::vector<Person*> fatalities;
+  for(int i = 0; i < size; ++i) {
+    if(fatal[i]) {
+      fatalities.push_back(this->infected_people.get_member(i));
+    }
+  }
+  for(int i = 0; i < static_cast<int>(fatalities.size()); ++i) {
+    fatalities[i]->become_case_fatality(day, this->disease);
+    this->daily_case_fatality_count++;
+    this->total_case_fatality_count++;
+    this->removed_people++;
+  }
+
+  // drop the people who are no longer infected in the same order as
+  // update_infected_people(), so the list stays the same
+  for(int i = 0; i < this->infected_people.size(); ) {
+    Person* person = this->infected_people.get_member(i);
+    if(person->is_infected(this->id) == false) {
+      this->infected_people.erase(person);
+    } else {
+      person->update_household_counts(day, this->id);
+      person->update_school_counts(day, this->id);
+      ++i;
+    }
+  }
+}
+
+static Place* get_place_of_type(Person* person, int place_type) {
+  switch(place_type) {
+  case 0:
+    return person->get_household();
+  case 1:
+    return person->get_neighborhood();
+  case 2:
+    return person->get_school();
+  case 3:
+    return person->get_classroom();
+  case 4:
+    return person->get_workplace();
+  case 5:
+    return person->get_office();
+  case 6:
+    return person->get_hospital();
+  }
+  return NULL;
+}
+
+void Epidemic::find_active_places(int day) {
+
+  FRED_VERBOSE(1, "find_active_places day %d actual %d\n", day, this->infectious_people);
+  for(int type = 0; type < ACTIVE_PLACE_TYPES; ++type) {
+    this->infectious_visits[type].clear();
+  }
+
+  // one pass over the infectious people finds the places of every type
+  // they attend today
+  for(int i = 0; i < this->infectious_people; ++i) {
+    Person* person = this->actually_infectious_people[i];
+    assert(person != NULL);
+    if(person->is_infectious(this->id) == false) {
+      continue;
+    }
+    for(int type = 0; type < ACTIVE_PLACE_TYPES; ++type) {
+      Place* place = get_place_of_type(person, type);
+      if(place != NULL && person->is_present(day, place)) {
+        this->infectious_visits[type].push_back(std::pair<Place*, Person*>(place, person));
       }
-      break;
-    case 4:
-      // add workplaces
-      size = Global::Places.get_number_of_workplaces();
-      for(int i = 0; i < size; ++i) {
-	      Place* place = Global::Places.get_workplace(i);
-	      if(place->get_infectious_vectors(this->id) > 0) {
-	        this->active_places.insert(place);
-	      }
+    }
+  }
+}
+
+void Epidemic::fill_active_places(int place_type) {
+  // A place reachable under two types (a hospital that is also a
+  // hospitalized person's household, say) is spread in once for each type,
+  // with only the infectious people who reach it under that type, so the
+  // infectious lists are filled one type at a time, just before spreading.
+  // The lists of the previous type were cleared by its spread.
+  std::vector<Place*> &places = this->active_places[place_type];
+  places.clear();
+  std::vector<std::pair<Place*, Person*> > &visits = this->infectious_visits[place_type];
+  for(int i = 0; i < visits.size(); ++i) {
+    Place* place = visits[i].first;
+    Person* person = visits[i].second;
+    FRED_VERBOSE(1, "add_infection_person %d place %s\n", person->get_id(), place->get_label());
+    if(place->has_infectious_people(this->id) == false) {
+      places.push_back(place);
+    }
+    place->add_infectious_person(this->id, person);
+  }
+
+  // vector transmission mode (for dengue and chikungunya): add the places
+  // with infectious vectors found by Place_List::update()
+  if(strcmp("vector", this->disease->get_transmission_mode()) == 0) {
+    std::vector<Place*> &vector_places = this->infectious_vector_places[place_type];
+    for(int i = 0; i < vector_places.size(); ++i) {
+      if(vector_places[i]->has_infectious_people(this->id) == false) {
+        places.push_back(vector_places[i]);
       }
-      break;
     }
   }
 
-  FRED_VERBOSE(1, "find_active_places_of_type %d found %d\n", place_type, this->active_places.size());
+  // same processing order as the std::set<Place*> this replaces
+  std::sort(places.begin(), places.end());
+  FRED_VERBOSE(0, "find_active_places type %d found %d\n", place_type, places.size());
+}
 
-  // convert active set to vector
-  this->active_place_vec.clear();
-  for(std::set<Place*>::iterator it = active_places.begin(); it != this->active_places.end(); ++it) {
-    this->active_place_vec.push_back(*it);
+void Epidemic::clear_infectious_vector_places() {
+  for(int type = 0; type < ACTIVE_PLACE_TYPES; ++type) {
+    this->infectious_vector_places[type].clear();
   }
-  FRED_VERBOSE(0, "find_active_places_of_type %d day %d found %d\n", place_type, day,  this->active_place_vec.size());
+}
 
+void Epidemic::add_infectious_vector_place(Place* place) {
+  // only households, schools and workplaces have vector transmission
+  if(place->is_household()) {
+    this->infectious_vector_places[0].push_back(place);
+  } else if(place->is_school()) {
+    this->infectious_vector_places[2].push_back(place);
+  } else if(place->is_workplace()) {
+    this->infectious_vector_places[4].push_back(place);
+  }
 }
   
-void Epidemic::spread_infection_in_active_places(int day) {
-  FRED_VERBOSE(0, "spread_infection__active_places day %d\n", day);
-  for(int i = 0; i < this->active_place_vec.size(); ++i) {
-    Place* place = this->active_place_vec[i];
+static bool compare_place_id(Place* p1, Place* p2) {
+  return p1->get_id() < p2->get_id();
+}
+
+void Epidemic::spread_infection_in_active_places(int day, int place_type) {
+  FRED_VERBOSE(0, "spread_infection__active_places day %d type %d\n", day, place_type);
+  std::vector<Place*> &places = this->active_places[place_type];
+  if(Global::Enable_Parallel_Transmission && strcmp("respiratory", this->disease->get_transmission_mode()) == 0) {
+    // new infections are committed in this order, so it must not depend on heap addresses
+    std::sort(places.begin(), places.end(), compare_place_id);
+    Respiratory_Transmission* transmission = static_cast<Respiratory_Transmission*>(this->disease->get_transmission());
+    transmission->spread_infection_in_parallel(day, this->id, places);
+    return;
+  }
+  for(int i = 0; i < places.size(); ++i) {
+    Place* place = places[i];
     this->disease->get_transmission()->spread_infection(day, this->id, place);
     place->clear_infectious_people(this->id);
   }
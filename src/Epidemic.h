@@ -25,6 +25,7 @@
 using namespace std;
 
 #include "Global.h"
+#include "Person_Set.h"
 
 #define SEED_USER 'U'
 #define SEED_RANDOM 'R'
@@ -135,9 +136,20 @@ public:
 
   virtual void update(int day);
   virtual void markov_updates(int day) {}
+  void update_infected_people(int day);
+  void update_infected_people_in_parallel(int day);
 
-  void find_active_places_of_type(int day, int place_type);
-  void spread_infection_in_active_places(int day);
+  void find_active_places(int day);
+  void fill_active_places(int place_type);
+  void spread_infection_in_active_places(int day, int place_type);
+
+  /**
+   * Called by Place_List::update() after the vector populations change:
+   * the places with infectious vectors are collected here, so that the
+   * epidemic does not have to scan every place for them.
+   */
+  void clear_infectious_vector_places();
+  void add_infectious_vector_place(Place* place);
 
   int get_susceptible_people() {
     return this->susceptible_people;
@@ -249,6 +261,8 @@ public:
   void cancel_immunity_end(int day, Person* person);
   virtual void end_of_run() {}
   virtual void terminate_person(Person* person, int day);
+  void cancel_infection_events(Person* person);
+  void remove_from_active_sets(Person* person);
 
 protected:
   Disease* disease;
@@ -268,11 +282,18 @@ protected:
   Events* immunity_end_event_queue;
 
   // active sets
-  std::set<Person*> infected_people;
-  std::set<Person*> potentially_infectious_people;
+  Person_Set infected_people;
+  Person_Set potentially_infectious_people;
   std::vector<Person*> actually_infectious_people;
-  std::set<Place*> active_places;
-  std::vector<Place*> active_place_vec;
+
+  // places of each type (household, neighborhood, school, classroom,
+  // workplace, office, hospital) where infection may spread today
+  static const int ACTIVE_PLACE_TYPES = 7;
+  std::vector<Place*> active_places[ACTIVE_PLACE_TYPES];
+  // today's (place, infectious person) visits of each type, in the order
+  // of actually_infectious_people
+  std::vector<std::pair<Place*, Person*> > infectious_visits[ACTIVE_PLACE_TYPES];
+  std::vector<Place*> infectious_vector_places[ACTIVE_PLACE_TYPES];
 
   // seeding imported cases
   std::vector<Time_Step_Map*> imported_cases_map;
@@ -17,26 +17,37 @@
 #include "Events.h"
 #include "Utils.h"
 
-Events::Events() {
+int Events::horizon = MAX_DAYS;
 
-  for (int day = 0; day < MAX_DAYS; ++day) {
-    clear_events(day);
-  }
+Events::Events() {
+  this->events.clear();
+  this->handle_item.clear();
+  this->handle_day.clear();
+  this->handle_pos.clear();
+  this->handles = 0;
+}
 
+void Events::set_horizon(int days) {
+  assert(0 <= days);
+  Events::horizon = (days < MAX_DAYS ? days : MAX_DAYS);
 }
 
 void Events::add_event(int day, event_t item) {
 
-  if (day < 0 || MAX_DAYS <= day) {
+  if (day < 0 || Events::horizon <= day) {
     // won't happen during this simulation
     return;
   }
+  if(static_cast<int>(this->events.size()) <= day) {
+    this->events.resize(day + 1);
+  }
   if(this->events[day].size() == this->events[day].capacity()) {
     if(this->events[day].capacity() < 4) {
       this->events[day].reserve(4);
     }
     this->events[day].reserve(2 * this->events[day].capacity());
   }
+  set_handle(item, day, static_cast<int>(this->events[day].size()));
   this->events[day].push_back(item);
   // printf("\nadd_event day %d new size %d\n", day, get_size(day));
   // print_events(day);
@@ -44,31 +55,70 @@ void Events::add_event(int day, event_t item) {
 
 void Events::delete_event(int day, event_t item) {
 
-  if(day < 0 || MAX_DAYS <= day) {
+  if(day < 0 || Events::horizon <= day) {
     // won't happen during this simulation
     return;
   }
-  // find item in the list
   int size = get_size(day);
-  for(int pos = 0; pos < size; ++pos) {
-    if(this->events[day][pos] == item) {
-      // copy last item in list into this slot
-      this->events[day][pos] = this->events[day].back();
-      // delete last slot
-      this->events[day].pop_back();
-      // printf("\ndelete_event day %d final size %d\n", day, get_size(day));
-      // print_events(day);
-      return;
+  int pos = -1;
+
+  // the handle may refer to another event for the same item
+  int slot = find_handle(item);
+  if(0 <= slot && this->handle_day[slot] == day) {
+    assert(this->events[day][this->handle_pos[slot]] == item);
+    pos = this->handle_pos[slot];
+    erase_handle(slot);
+  } else {
+    // item has more than one pending event in this queue; find it in the list
+    for(int i = 0; i < size; ++i) {
+      if(this->events[day][i] == item) {
+        pos = i;
+        break;
+      }
     }
   }
-  // item not found
-  FRED_WARNING("delete_events: item not found\n");
-  assert(false);
+
+  if(pos < 0) {
+    // item not found
+    FRED_WARNING("delete_events: item not found\n");
+    assert(false);
+    return;
+  }
+
+  // copy last item in list into this slot
+  this->events[day][pos] = this->events[day].back();
+  // delete last slot
+  this->events[day].pop_back();
+  if(pos < size - 1) {
+    slot = find_handle(this->events[day][pos]);
+    if(0 <= slot && this->handle_day[slot] == day && this->handle_pos[slot] == size - 1) {
+      this->handle_pos[slot] = pos;
+    }
+  }
+  // printf("\ndelete_event day %d final size %d\n", day, get_size(day));
+  // print_events(day);
+}
+
+void Events::delete_pending_event(event_t item) {
+  int slot = find_handle(item);
+  if(0 <= slot) {
+    delete_event(this->handle_day[slot], item);
+  }
 }
 
 void Events::clear_events(int day) {
 
   assert(0 <= day && day < MAX_DAYS);
+  if(static_cast<int>(this->events.size()) <= day) {
+    return;
+  }
+  int size = get_size(day);
+  for(int i = 0; i < size; ++i) {
+    int slot = find_handle(this->events[day][i]);
+    if(0 <= slot && this->handle_day[slot] == day) {
+      erase_handle(slot);
+    }
+  }
   this->events[day] = events_t();
   // printf("clear_events day %d size %d\n", day, get_size(day));
 }
@@ -76,20 +126,94 @@ void Events::clear_events(int day) {
 int Events::get_size(int day) {
 
   assert(0 <= day && day < MAX_DAYS);
+  if(static_cast<int>(this->events.size()) <= day) {
+    return 0;
+  }
   return static_cast<int>(this->events[day].size());
 }
 
 event_t Events::get_event(int day, int i) {
 
-  assert(0 <= day && day < MAX_DAYS);
+  assert(0 <= day && day < static_cast<int>(this->events.size()));
   assert(0 <= i && i < static_cast<int>(this->events[day].size()));
   return this->events[day][i];
 }
 
+int Events::find_handle(event_t item) {
+  if(this->handles == 0) {
+    return -1;
+  }
+  int mask = static_cast<int>(this->handle_item.size()) - 1;
+  for(int slot = home_slot(item); this->handle_item[slot] != NULL; slot = (slot + 1) & mask) {
+    if(this->handle_item[slot] == item) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+void Events::set_handle(event_t item, int day, int pos) {
+  // keep the table at most half full
+  if(2 * (this->handles + 1) > static_cast<int>(this->handle_item.size())) {
+    std::vector<event_t> old_item;
+    std::vector<int> old_day;
+    std::vector<int> old_pos;
+    old_item.swap(this->handle_item);
+    old_day.swap(this->handle_day);
+    old_pos.swap(this->handle_pos);
+    int size = (old_item.size() < 16 ? 16 : 2 * old_item.size());
+    this->handle_item.assign(size, NULL);
+    this->handle_day.assign(size, -1);
+    this->handle_pos.assign(size, -1);
+    this->handles = 0;
+    for(unsigned i = 0; i < old_item.size(); ++i) {
+      if(old_item[i] != NULL) {
+        set_handle(old_item[i], old_day[i], old_pos[i]);
+      }
+    }
+  }
+  int mask = static_cast<int>(this->handle_item.size()) - 1;
+  int slot = home_slot(item);
+  while(this->handle_item[slot] != NULL && this->handle_item[slot] != item) {
+    slot = (slot + 1) & mask;
+  }
+  if(this->handle_item[slot] == NULL) {
+    this->handle_item[slot] = item;
+    ++this->handles;
+  }
+  this->handle_day[slot] = day;
+  this->handle_pos[slot] = pos;
+}
+
+void Events::erase_handle(int slot) {
+  // backward-shift deletion keeps every probe chain unbroken
+  int mask = static_cast<int>(this->handle_item.size()) - 1;
+  int hole = slot;
+  for(int next = (hole + 1) & mask; this->handle_item[next] != NULL; next = (next + 1) & mask) {
+    int home = home_slot(this->handle_item[next]);
+    // move the entry back unless its home lies cyclically in (hole, next]
+    bool stays = (hole < next) ? (hole < home && home <= next) : (hole < home || home <= next);
+    if(!stays) {
+      this->handle_item[hole] = this->handle_item[next];
+      this->handle_day[hole] = this->handle_day[next];
+      this->handle_pos[hole] = this->handle_pos[next];
+      hole = next;
+    }
+  }
+  this->handle_item[hole] = NULL;
+  this->handle_day[hole] = -1;
+  this->handle_pos[hole] = -1;
+  --this->handles;
+}
 
 void Events::print_events(FILE* fp, int day) {
 
   assert(0 <= day && day < MAX_DAYS);
+  if(static_cast<int>(this->events.size()) <= day) {
+    fprintf(fp, "events[%d] = 0 : \n", day);
+    fflush(fp);
+    return;
+  }
   events_itr_t itr_end = this->events[day].end();
   fprintf(fp, "events[%d] = %d : ", day, get_size(day));
   for(events_itr_t itr = this->events[day].begin(); itr != itr_end; ++itr) {
@@ -41,14 +41,40 @@ public:
 
   void add_event(int day, event_t item);
   void delete_event(int day, event_t item);
+
+  // delete the most recently added event for item, if any is queued
+  void delete_pending_event(event_t item);
+
   void clear_events(int day);
   int get_size(int day);
   event_t get_event(int day, int i);
   void print_events(FILE* fp, int day);
   void print_events(int day);
 
+  // events on or after the horizon day are never processed, so they are
+  // dropped instead of stored (MAX_DAYS until set)
+  static void set_horizon(int days);
+
 private:
-  events_t events[MAX_DAYS];
+  // calendar of day buckets, grown on demand up to the horizon
+  std::vector<events_t> events;
+
+  // handles for O(1) cancellation: day and position of each item's most
+  // recently added event, kept in an open-addressing table (linear
+  // probing) sized to the number of pending events
+  std::vector<event_t> handle_item;
+  std::vector<int> handle_day;
+  std::vector<int> handle_pos;
+  int handles;
+  int find_handle(event_t item);
+  void set_handle(event_t item, int day, int pos);
+  void erase_handle(int slot);
+  int home_slot(event_t item) {
+    unsigned long key = reinterpret_cast<unsigned long>(item) >> 3;
+    return static_cast<int>((key * 0x9E3779B97F4A7C15UL) >> 32) & (static_cast<int>(this->handle_item.size()) - 1);
+  }
+
+  static int horizon;
 };
 
 
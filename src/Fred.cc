@@ -16,20 +16,25 @@
 #include "Activities.h"
 #include "AV_Manager.h"
 #include "Behavior.h"
+#include "Checkpoint.h"
 #include "Date.h"
 #include "Demographics.h"
 #include "Disease.h"
 #include "Disease_List.h"
 #include "Evolution.h"
 #include "Epidemic.h"
+#include "Events.h"
 #include "Fred.h"
 #include "Global.h"
 #include "Health.h"
+#include "Infection_Log.h"
+#include "Log_Sink.h"
 #include "Neighborhood_Layer.h"
 #include "Network.h"
 #include "Params.h"
 #include "Place_List.h"
 #include "Population.h"
+#include "Profile.h"
 #include "Random.h"
 #include "Regional_Layer.h"
 #include "Seasonality.h"
@@ -57,6 +62,7 @@ class Place;
 int main(int argc, char* argv[]) {
   fred_setup(argc, argv);
   for(Global::Simulation_Day = 0; Global::Simulation_Day < Global::Days; Global::Simulation_Day++) {
+    Checkpoint::restore_runs(Global::Simulation_Day);
     fred_step(Global::Simulation_Day);
   }
   fred_finish();
@@ -73,6 +79,9 @@ void fred_setup(int argc, char* argv[]) {
   Utils::fred_start_initialization_timer();
   Utils::fred_start_timer();
 
+  // take out the options for several runs (--realizations N --jobs K)
+  Checkpoint::parse_command_line(argc, argv);
+
   // read optional param file name from command line
   if(argc > 1) {
     strcpy(paramfile, argv[1]);
@@ -100,8 +109,16 @@ void fred_setup(int argc, char* argv[]) {
   Params::read_parameters(paramfile);
   Global::get_global_parameters();
   Date::setup_dates(Global::Start_date);
+  Events::set_horizon(Global::Days);
+  Checkpoint::get_parameters();
+  Profile::get_parameters();
+  Infection_Log::get_parameters();
+  Log_Sink::get_parameters();
+  FRED_PROFILE("setup");
+  FRED_PROFILE_PHASES(phases);
 
   // create diseases and read parameters
+  FRED_PROFILE_PHASE(phases, "get_parameters");
   Global::Diseases.get_parameters();
   Transmission::get_parameters();
 
@@ -126,6 +143,7 @@ void fred_setup(int argc, char* argv[]) {
   Utils::fred_open_output_files();
 
   // set random number seed based on run number
+  FRED_PROFILE_PHASE(phases, "rng_setup");
   if(Global::Simulation_run_number > 1 && Global::Reseed_day == -1) {
     Global::Simulation_seed = Global::Seed * 100 + (Global::Simulation_run_number - 1);
   } else {
@@ -152,6 +170,7 @@ void fred_setup(int argc, char* argv[]) {
 
   // Loop over all Demes and read in the household, schools and workplaces
   // and setup geographical layers
+  FRED_PROFILE_PHASE(phases, "read_places");
   Utils::fred_print_wall_time("\nFRED read_places started");
   Global::Places.read_all_places(Global::Pop.get_demes());
   Utils::fred_print_lap_time("Places.read_places");
@@ -168,6 +187,7 @@ void fred_setup(int argc, char* argv[]) {
   }
 
   // initialize parameters and other static variables
+  FRED_PROFILE_PHASE(phases, "initialize_static_variables");
   Demographics::initialize_static_variables();
   Activities::initialize_static_variables();
   Behavior::initialize_static_variables();
@@ -175,15 +195,18 @@ void fred_setup(int argc, char* argv[]) {
   Utils::fred_print_lap_time("initialize_static_variables");
 
   // finished setting up Diseases
+  FRED_PROFILE_PHASE(phases, "setup_diseases");
   Global::Diseases.setup();
   Utils::fred_print_lap_time("Diseases.setup");
 
   // read in the population and have each person enroll
   // in each daily activity location identified in the population file
+  FRED_PROFILE_PHASE(phases, "setup_population");
   Utils::fred_print_wall_time("\nFRED Pop.setup started");
   Global::Pop.setup();
   Utils::fred_print_wall_time("FRED Pop.setup finished");
   Utils::fred_print_lap_time("Pop.setup");
+  FRED_PROFILE_PHASE(phases, "setup_places");
   Global::Places.setup_group_quarters();
   Utils::fred_print_lap_time("Places.setup_group_quarters");
   Global::Places.setup_households();
@@ -225,6 +248,7 @@ void fred_setup(int argc, char* argv[]) {
   Global::Places.delete_place_label_map();
   FRED_STATUS(0, "prepare places finished\n", "");
   
+  FRED_PROFILE_PHASE(phases, "setup_networks");
   if(Global::Enable_Vector_Layer) {
     Global::Vectors->setup();
     Utils::fred_print_lap_time("Vectors->setup");
@@ -251,6 +275,7 @@ void fred_setup(int argc, char* argv[]) {
   }
 
   if(Global::Quality_control) {
+    FRED_PROFILE_PHASE(phases, "quality_control");
     Global::Pop.quality_control();
     Global::Places.quality_control();
     Global::Simulation_Region->quality_control();
@@ -269,6 +294,7 @@ void fred_setup(int argc, char* argv[]) {
     Utils::fred_print_lap_time("quality control");
   }
 
+  FRED_PROFILE_PHASE(phases, "setup_reports");
   if(Global::Track_age_distribution) {
     /*
       Global::Pop.print_age_distribution(Global::Simulation_directory,
@@ -327,6 +353,7 @@ void fred_setup(int argc, char* argv[]) {
   Global::Daily_Tracker = new Tracker<int>("Main Daily Tracker","Day");
   
   // prepare diseases after population is all set up
+  FRED_PROFILE_PHASE(phases, "prepare_diseases");
   FRED_VERBOSE(0, "prepare diseases\n");
   Global::Diseases.prepare_diseases();
   Utils::fred_print_lap_time("prepare_diseases");
@@ -340,6 +367,7 @@ void fred_setup(int argc, char* argv[]) {
   }
 
   // initialize visualization data if desired
+  FRED_PROFILE_PHASE(phases, "before_run");
   if(Global::Enable_Visualization_Layer) {
     Global::Visualization->initialize();
   }
@@ -362,6 +390,8 @@ void fred_setup(int argc, char* argv[]) {
 void fred_step(int day) {
 
   Utils::fred_start_day_timer();
+  FRED_PROFILE("fred_step");
+  FRED_PROFILE_PHASES(phases);
 
   // optional: reseed the random number generator to create alternative
   // simulation form a given initial point
@@ -384,11 +414,13 @@ void fred_step(int day) {
   }
 
   // reset lists of infectious, susceptibles; update vector population, if any
+  FRED_PROFILE_PHASE(phases, "update_places");
   Global::Places.update(day);
   Utils::fred_print_lap_time("day %d update places", day);
 
   // optional: update population dynamics 
   if(Global::Enable_Population_Dynamics) {
+    FRED_PROFILE_PHASE(phases, "update_demographics");
     Demographics::update(day);
     Utils::fred_print_lap_time("day %d update demographics", day);
     Global::Places.update_population_dynamics(day);
@@ -396,11 +428,13 @@ void fred_step(int day) {
   }
 
   // update everyone's health intervention status
+  FRED_PROFILE_PHASE(phases, "update_interventions");
   if(Global::Enable_Vaccination || Global::Enable_Antivirals) {
     Global::Pop.update_health_interventions(day);
   }
 
   // remove dead from population
+  FRED_PROFILE_PHASE(phases, "remove_dead");
   Global::Pop.remove_dead_from_population(day);
 
   // update activity profiles on July 1
@@ -409,10 +443,12 @@ void fred_step(int day) {
 
   // Update vector dynamics
   if(Global::Enable_Vector_Layer) {
+    FRED_PROFILE_PHASE(phases, "update_vectors");
     Global::Vectors->update(day);
   }
 
   // update travel decisions
+  FRED_PROFILE_PHASE(phases, "update_travel");
   Travel::update_travel(day);
 
   if(Global::Enable_Behaviors) {
@@ -420,6 +456,7 @@ void fred_step(int day) {
   }
 
   // distribute vaccines
+  FRED_PROFILE_PHASE(phases, "distribute_vaccines_and_antivirals");
   Global::Pop.vacc_manager->update(day);
 
   // distribute AVs
@@ -427,6 +464,7 @@ void fred_step(int day) {
 
   // update generic activities (individual activities updated only if
   // needed -- see below)
+  FRED_PROFILE_PHASE(phases, "update_activities");
   Activities::update(day);
 
   // shuffle the order of diseases to reduce systematic bias
@@ -440,6 +478,7 @@ void fred_step(int day) {
   }
 
   // transmit each disease in turn
+  FRED_PROFILE_PHASE(phases, "update_epidemics");
   for(int d = 0; d < Global::Diseases.get_number_of_diseases(); ++d) {
     int disease_id = order[d];
     Disease* disease = Global::Diseases.get_disease(disease_id);
@@ -448,6 +487,7 @@ void fred_step(int day) {
   }
 
   // print daily report
+  FRED_PROFILE_PHASE(phases, "report");
   Global::Pop.report(day);
   Utils::fred_print_lap_time("day %d report population", day);
 
@@ -473,14 +513,9 @@ void fred_step(int day) {
     Global::Places.report_county_populations();
   }
 
-#pragma omp parallel sections
-  {
-#pragma omp section
-    {
-      // flush infections file buffer
-      fflush(Global::Infectionfp);
-    }
-  }
+  // flush infections file buffer
+  Infection_Log::flush();
+  Log_Sink::flush();
 
   // print daily reports
   Utils::fred_print_resource_usage(day);
@@ -495,7 +530,7 @@ void fred_step(int day) {
 
 void fred_finish() {
   //Global::Daily_Tracker->create_full_log(10,cout);
-  fflush(Global::Infectionfp);
+  Infection_Log::flush();
   
   // final reports
   if(Global::Report_Mean_Household_Stats_Per_Income_Category && Global::Report_Epidemic_Data_By_Census_Tract) {
@@ -506,7 +541,26 @@ void fred_finish() {
   } else if(Global::Report_Epidemic_Data_By_Census_Tract) {
     Global::Tract_Tracker->output_csv_report_format(Global::Tractfp);
   }
+  if(strcmp(Global::Daily_tracker_format, "none") != 0) {
+    // all the daily values as one table
+    bool binary = (strcmp(Global::Daily_tracker_format, "binary") == 0);
+    char filename[FRED_STRING_SIZE];
+    sprintf(filename, "%s/daily%d.%s", Global::Simulation_directory, Global::Simulation_run_number,
+	    binary ? "bin" : "csv");
+    FILE* fp = fopen(filename, binary ? "wb" : "w");
+    if(fp == NULL) {
+      Utils::fred_abort("Can't open %s\n", filename);
+    }
+    if(binary) {
+      Global::Daily_Tracker->output_binary_report_format(fp);
+    } else {
+      Global::Daily_Tracker->output_csv_report_format(fp);
+    }
+    fclose(fp);
+  }
   Activities::end_of_run();
+  Params::report_parameter_use();
+  Profile::report(Global::Simulation_directory, Global::Simulation_run_number);
 
   // report timing info
   Utils::fred_print_lap_time(&Global::Simulation_start_time,
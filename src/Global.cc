@@ -21,6 +21,15 @@
 #include "Disease_List.h"
 #include "Place_List.h"
 
+#ifdef _OPENMP
+int fred::Max_threads = 0;
+
+int fred::omp_get_max_threads() {
+  int threads = ::omp_get_max_threads();
+  return threads < Max_threads ? Max_threads : threads;
+}
+#endif
+
 // global simulation variables
 char Global::Simulation_directory[FRED_STRING_SIZE];
 int Global::Simulation_run_number = 1;
@@ -31,10 +40,12 @@ int Global::Simulation_Day = 0;
 // global runtime parameters
 char Global::Synthetic_population_directory[FRED_STRING_SIZE];
 char Global::Synthetic_population_id[FRED_STRING_SIZE];
+char Global::Population_cache_directory[FRED_STRING_SIZE];
 char Global::Synthetic_population_version[FRED_STRING_SIZE];
 char Global::Output_directory[FRED_STRING_SIZE];
 char Global::Tracefilebase[FRED_STRING_SIZE];
 char Global::VaccineTracefilebase[FRED_STRING_SIZE];
+char Global::Daily_tracker_format[FRED_STRING_SIZE];
 int Global::Trace_Headers = 0;
 int Global::Rotate_start_date = 0;
 int Global::Quality_control = 0;
@@ -79,6 +90,10 @@ bool Global::Enable_Transmission_Network = false;
 bool Global::Enable_Sexual_Partner_Network = false;
 bool Global::Enable_Transmission_Bias = false;
 bool Global::Enable_New_Transmission_Model = false;
+bool Global::Enable_Parallel_Transmission = false;
+bool Global::Enable_Parallel_Infection_Update = false;
+bool Global::Enable_Alias_Sampling = false;
+bool Global::Enable_Markov_Transition_Tables = false;
 bool Global::Enable_Hospitals = false;
 bool Global::Enable_Health_Insurance = false;
 bool Global::Enable_Group_Quarters = false;
@@ -177,6 +192,11 @@ void Global::get_global_parameters() {
   Params::get_param_from_string("outdir", Global::Output_directory);
   Params::get_param_from_string("tracefile", Global::Tracefilebase);
   Params::get_param_from_string("track_infection_events", &Global::Track_infection_events);
+  Params::get_param_from_string("daily_tracker_format", Global::Daily_tracker_format);
+  if(strcmp(Global::Daily_tracker_format, "none") != 0 && strcmp(Global::Daily_tracker_format, "csv") != 0 &&
+     strcmp(Global::Daily_tracker_format, "binary") != 0) {
+    Utils::fred_abort("Unknown daily_tracker_format %s (use none, csv or binary)\n", Global::Daily_tracker_format);
+  }
 
   Params::get_param_from_string("vaccine_tracefile", Global::VaccineTracefilebase);
   Params::get_param_from_string("trace_headers", &Global::Trace_Headers);
@@ -214,6 +234,14 @@ void Global::get_global_parameters() {
   Global::Enable_Transmission_Bias = (temp_int == 0 ? false : true);
   Params::get_param_from_string("enable_new_transmission_model", &temp_int);
   Global::Enable_New_Transmission_Model = (temp_int == 0 ? false : true);
+  Params::get_param_from_string("enable_parallel_transmission", &temp_int);
+  Global::Enable_Parallel_Transmission = (temp_int == 0 ? false : true);
+  Params::get_param_from_string("enable_parallel_infection_update", &temp_int);
+  Global::Enable_Parallel_Infection_Update = (temp_int == 0 ? false : true);
+  Params::get_param_from_string("enable_alias_sampling", &temp_int);
+  Global::Enable_Alias_Sampling = (temp_int == 0 ? false : true);
+  Params::get_param_from_string("enable_markov_transition_tables", &temp_int);
+  Global::Enable_Markov_Transition_Tables = (temp_int == 0 ? false : true);
   Params::get_param_from_string("report_mean_household_stats_per_income_category", &temp_int);
   Global::Report_Mean_Household_Stats_Per_Income_Category = (temp_int == 0 ? false : true);
   Params::get_param_from_string("report_epidemic_data_by_census_tract", &temp_int);
@@ -26,6 +26,10 @@
 #include <map>
 #include <chrono>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace std::chrono;
 
@@ -185,10 +189,12 @@ public:
   static char Synthetic_population_directory[];
   static char Synthetic_population_id[];
   static char Synthetic_population_version[];
+  static char Population_cache_directory[];
   static char Population_directory[];
   static char Output_directory[];
   static char Tracefilebase[];
   static char VaccineTracefilebase[];
+  static char Daily_tracker_format[];
   static int Trace_Headers;
   static int Rotate_start_date;
   static int Quality_control;
@@ -234,6 +240,10 @@ public:
   static bool Enable_Sexual_Partner_Network;
   static bool Enable_Transmission_Bias;
   static bool Enable_New_Transmission_Model;
+  static bool Enable_Parallel_Transmission;
+  static bool Enable_Parallel_Infection_Update;
+  static bool Enable_Alias_Sampling;
+  static bool Enable_Markov_Transition_Tables;
   static bool Enable_Hospitals;
   static bool Enable_Health_Insurance;
   static bool Enable_Group_Quarters;
@@ -415,7 +425,17 @@ namespace fred {
 
 #ifdef _OPENMP
   
-#include <omp.h>
+  // Per-thread tables are sized for omp_get_max_threads().  A process
+  // that lowers its thread count and raises it again later (see
+  // Checkpoint.h) sets Max_threads to the higher count.
+  extern int Max_threads;
+
+  int omp_get_max_threads();
+
+  using ::omp_get_num_threads;
+  using ::omp_get_thread_num;
+  using ::omp_set_num_threads;
+
   struct Mutex {
     Mutex() {
       omp_init_lock(&lock);
@@ -553,15 +573,4 @@ typedef std::vector<Place*> place_vector_t;
 
 #define VECTOR_DISEASE_TYPES 4
 
-typedef struct {
-  double vectors_per_host;
-  int N_vectors;
-  int S_vectors;
-  int E_vectors[VECTOR_DISEASE_TYPES];
-  int I_vectors[VECTOR_DISEASE_TYPES];
-  int place_seeds[VECTOR_DISEASE_TYPES];
-  int day_start_seed[VECTOR_DISEASE_TYPES];
-  int day_end_seed[VECTOR_DISEASE_TYPES];
-} vector_disease_data_t;
-
 #endif // _FRED_GLOBAL_H
@@ -79,8 +79,7 @@ double Health::Hand_washing_compliance = 0.0;
 
 double Health::Hh_income_susc_mod_floor = 0.0;
 
-double Health::health_insurance_distribution[Insurance_assignment_index::UNSET];
-int Health::health_insurance_cdf_size = 0;
+Alias_Table Health::health_insurance_distribution;
 
 // static method called in main (Fred.cc)
 
@@ -156,22 +155,24 @@ void Health::initialize_static_variables() {
 
     if(Global::Enable_Health_Insurance) {
 
-      Health::health_insurance_cdf_size = Params::get_param_vector((char*)"health_insurance_distribution", Health::health_insurance_distribution);
+      double distribution[Insurance_assignment_index::UNSET];
+      int size = Params::get_param_vector((char*)"health_insurance_distribution", distribution);
 
       // convert to cdf
       double stotal = 0;
-      for(int i = 0; i < Health::health_insurance_cdf_size; ++i) {
-        stotal += Health::health_insurance_distribution[i];
+      for(int i = 0; i < size; ++i) {
+        stotal += distribution[i];
       }
       if(stotal != 100.0 && stotal != 1.0) {
         Utils::fred_abort("Bad distribution health_insurance_distribution params_str\nMust sum to 1.0 or 100.0\n");
       }
       double cumm = 0.0;
-      for(int i = 0; i < Health::health_insurance_cdf_size; ++i) {
-        Health::health_insurance_distribution[i] /= stotal;
-        Health::health_insurance_distribution[i] += cumm;
-        cumm = Health::health_insurance_distribution[i];
+      for(int i = 0; i < size; ++i) {
+        distribution[i] /= stotal;
+        distribution[i] += cumm;
+        cumm = distribution[i];
       }
+      Health::health_insurance_distribution.set_cdf(distribution, size);
     }
 
     Health::is_initialized = true;
@@ -180,7 +181,7 @@ void Health::initialize_static_variables() {
 
 Insurance_assignment_index::e Health::get_health_insurance_from_distribution() {
   if(Global::Enable_Health_Insurance && Health::is_initialized) {
-    int i = Random::draw_from_distribution(Health::health_insurance_cdf_size, Health::health_insurance_distribution);
+    int i = Health::health_insurance_distribution.draw();
     return Health::get_insurance_type_from_int(i);
   } else {
     return Insurance_assignment_index::UNSET;
@@ -253,15 +254,8 @@ Health::Health() {
   this->days_symptomatic = 0;
   this->previous_infection_serotype = 0;
   this->insurance_type = Insurance_assignment_index::UNSET;
-  this->infection = NULL;
-  this->immunity_end_date = NULL;
-  this->infectee_count = NULL;
-  this->susceptibility_multp = NULL;
-  this->exposure_date = NULL;
-  this->infector_id = NULL;
-  this->infected_in_mixing_group = NULL;
-  this->health_condition = NULL;
-  this->health_state.clear();
+  this->idx = -1;
+  clear_immunity_cache();
 }
 
 void Health::setup(Person* self) {
@@ -269,17 +263,13 @@ void Health::setup(Person* self) {
   FRED_VERBOSE(1, "Health::setup for person %d\n", myself->get_id());
   this->alive = true;
   this->intervention_flags = intervention_flags_type();
-  // infection pointers stored in statically allocated array (length of which
-  // is determined by static constant Global::MAX_NUM_DISEASES)
-  this->susceptible = fred::disease_bitset();
-  this->infectious = fred::disease_bitset();
-  this->symptomatic = fred::disease_bitset();
-  this->recovered = fred::disease_bitset();
-  this->immunity = fred::disease_bitset();
-
-  // Determines if the agent is at risk
-  this->at_risk = fred::disease_bitset();
-  
+
+  // per-disease state lives in the population-wide Health_Store
+  this->idx = myself->get_pop_index();
+  int diseases = Global::Diseases.get_number_of_diseases();
+  FRED_VERBOSE(1, "Health::setup diseases %d\n", diseases);
+  Health_Store::add_person(this->idx, diseases);
+
   // Determine if the agent washes hands
   this->washes_hands = false;
   if(Health::Hand_washing_compliance > 0.0) {
@@ -297,35 +287,11 @@ void Health::setup(Person* self) {
     // printf("FACEMASK: has_face_mask_behavior = %d\n", this->has_face_mask_behavior?1:0);
   }
 
-  this->case_fatality = fred::disease_bitset();
-  int diseases = Global::Diseases.get_number_of_diseases();
-  FRED_VERBOSE(1, "Health::setup diseases %d\n", diseases);
-  this->infection = new Infection* [diseases];
-  this->susceptibility_multp = new double [diseases];
-  this->infectee_count = new int [diseases];
-  this->exposure_date = new int [diseases];
-  this->infector_id = new int [diseases];
-  this->infected_in_mixing_group = new Mixing_Group*[diseases];
-  this->immunity_end_date = new int [diseases];
   this->past_infections = new past_infections_type [diseases];
-  this->health_condition = new health_condition_t [diseases];
+  clear_immunity_cache();
 
   for(int disease_id = 0; disease_id < diseases; ++disease_id) {
-    this->recovered.reset(disease_id);
-    this->susceptible.reset(disease_id);
-    this->case_fatality.reset(disease_id);
-    this->infection[disease_id] = NULL;
-    this->susceptibility_multp[disease_id] = 1.0;
-    this->infectee_count[disease_id] = 0;
-    this->exposure_date[disease_id] = -1;
-    this->infector_id[disease_id] = -1;
-    this->infected_in_mixing_group[disease_id] = NULL;
-    this->immunity_end_date[disease_id] = -1;
     this->past_infections[disease_id].clear();
-    this->health_condition[disease_id].state = -1;
-    this->health_condition[disease_id].last_transition_day = -1;
-    this->health_condition[disease_id].next_state = -1;
-    this->health_condition[disease_id].next_transition_day = -1;
 
     Disease* disease = Global::Diseases.get_disease(disease_id);
     if (disease->assume_susceptible()) {
@@ -376,9 +342,12 @@ void Health::setup(Person* self) {
 }
 
 Health::~Health() {
-  for(size_t i = 0; i < Global::Diseases.get_number_of_diseases(); ++i) {
-    if(this->infection[i] != NULL) {
-      delete this->infection[i];
+  if(0 <= this->idx) {
+    for(int i = 0; i < Global::Diseases.get_number_of_diseases(); ++i) {
+      if(store(i).infection[this->idx] != NULL) {
+        delete store(i).infection[this->idx];
+        store(i).infection[this->idx] = NULL;
+      }
     }
   }
 
@@ -404,18 +373,18 @@ Health::~Health() {
 }
 
 void Health::become_susceptible(int disease_id) {
-  if(this->susceptible.test(disease_id)) {
+  if(store(disease_id).susceptible.test(this->idx)) {
     FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			    "HEALTH CHART: %s person %d is already SUSCEPTIBLE for disease %d\n",
 			    Date::get_date_string().c_str(),
 			    myself->get_id(), disease_id);
     return;
   }
-  assert(this->infection[disease_id] == NULL);
-  this->susceptibility_multp[disease_id] = 1.0;
-  this->susceptible.set(disease_id);
+  assert(store(disease_id).infection[this->idx] == NULL);
+  store(disease_id).susceptibility_multp[this->idx] = 1.0;
+  store(disease_id).susceptible.set(this->idx);
   assert(is_susceptible(disease_id));
-  this->recovered.reset(disease_id);
+  store(disease_id).recovered.reset(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is SUSCEPTIBLE for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -423,13 +392,13 @@ void Health::become_susceptible(int disease_id) {
 }
 
 void Health::become_susceptible_by_vaccine_waning(int disease_id) {
-  if(this->susceptible.test(disease_id)) {
+  if(store(disease_id).susceptible.test(this->idx)) {
     return;
   }
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     // not already infected
-    this->susceptibility_multp[disease_id] = 1.0;
-    this->susceptible.set(disease_id);
+    store(disease_id).susceptibility_multp[this->idx] = 1.0;
+    store(disease_id).susceptible.set(this->idx);
     FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			    "HEALTH CHART: %s person %d is SUSCEPTIBLE for disease %d\n",
 			    Date::get_date_string().c_str(),
@@ -447,7 +416,7 @@ void Health::become_exposed(int disease_id, Person* infector, Mixing_Group* mixi
    FRED_VERBOSE(0, "become_exposed: person %d is exposed to disease %d day %d\n",
 		            myself->get_id(), disease_id, day);
 
-  if(this->infection[disease_id] != NULL) {
+  if(store(disease_id).infection[this->idx] != NULL) {
     Utils::fred_abort("DOUBLE EXPOSURE: person %d dis_id %d day %d\n", myself->get_id(), disease_id, day);
   }
 
@@ -465,24 +434,24 @@ void Health::become_exposed(int disease_id, Person* infector, Mixing_Group* mixi
     }
   }
 
-  this->infectious.reset(disease_id);
-  this->symptomatic.reset(disease_id);
+  store(disease_id).infectious.reset(this->idx);
+  store(disease_id).symptomatic.reset(this->idx);
   Disease* disease = Global::Diseases.get_disease(disease_id);
-  this->infection[disease_id] = Infection::get_new_infection(disease, infector, myself, mixing_group, day);
+  store(disease_id).infection[this->idx] = Infection::get_new_infection(disease, infector, myself, mixing_group, day);
   FRED_VERBOSE(1, "setup infection: person %d dis_id %d day %d\n", myself->get_id(), disease_id, day);
-  this->infection[disease_id]->setup();
-  this->infection[disease_id]->report_infection(day);
+  store(disease_id).infection[this->idx]->setup();
+  store(disease_id).infection[this->idx]->report_infection(day);
   become_unsusceptible(disease);
-  this->immunity_end_date[disease_id] = -1;
+  store(disease_id).immunity_end_date[this->idx] = -1;
   if(myself->get_household() != NULL) {
     myself->get_household()->set_exposed(disease_id);
     myself->set_exposed_household(myself->get_household()->get_index());
   }
   if(infector != NULL) {
-    this->infector_id[disease_id] = infector->get_id();
+    store(disease_id).infector_id[this->idx] = infector->get_id();
   }
-  this->exposure_date[disease_id] = day;
-  this->infected_in_mixing_group[disease_id] = mixing_group;
+  store(disease_id).exposure_date[this->idx] = day;
+  store(disease_id).infected_in_mixing_group[this->idx] = mixing_group;
 
   if(Global::Enable_Transmission_Network) {
     FRED_VERBOSE(1, "Joining transmission network: %d\n", myself->get_id());
@@ -522,7 +491,7 @@ void Health::become_exposed(int disease_id, Person* infector, Mixing_Group* mixi
 }
 
 void Health::become_unsusceptible(int disease_id) {
-  this->susceptible.reset(disease_id);
+  store(disease_id).susceptible.reset(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is UNSUSCEPTIBLE for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -536,8 +505,8 @@ void Health::become_unsusceptible(Disease* disease) {
 
 void Health::become_infectious(Disease* disease) {
   int disease_id = disease->get_id();
-  assert(this->infection[disease_id] != NULL);
-  this->infectious.set(disease_id);
+  assert(store(disease_id).infection[this->idx] != NULL);
+  store(disease_id).infectious.set(this->idx);
   int household_index = myself->get_exposed_household_index();
   Household* h = Global::Places.get_household_ptr(household_index);
   assert(h != NULL);
@@ -550,8 +519,8 @@ void Health::become_infectious(Disease* disease) {
 
 void Health::become_noninfectious(Disease* disease) {
   int disease_id = disease->get_id();
-  assert(this->infection[disease_id] != NULL);
-  this->infectious.reset(disease_id);
+  assert(store(disease_id).infection[this->idx] != NULL);
+  store(disease_id).infectious.reset(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is NONINFECTIOUS for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -560,18 +529,18 @@ void Health::become_noninfectious(Disease* disease) {
 
 void Health::become_symptomatic(Disease* disease) {
   int disease_id = disease->get_id();
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     FRED_STATUS(1, "Help: becoming symptomatic with no infection: person %d, disease_id %d\n", myself->get_id(), disease_id);
   }
-  assert(this->infection[disease_id] != NULL);
-  if(this->symptomatic.test(disease_id)) {
+  assert(store(disease_id).infection[this->idx] != NULL);
+  if(store(disease_id).symptomatic.test(this->idx)) {
     FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			    "HEALTH CHART: %s person %d is ALREADY SYMPTOMATIC for disease %d\n",
 			    Date::get_date_string().c_str(),
 			    myself->get_id(), disease_id);
     return;
   }
-  this->symptomatic.set(disease_id);
+  store(disease_id).symptomatic.set(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is SYMPTOMATIC for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -580,9 +549,9 @@ void Health::become_symptomatic(Disease* disease) {
 
 void Health::resolve_symptoms(Disease* disease) {
   int disease_id = disease->get_id();
-  // assert(this->infection[disease_id] != NULL);
-  if(this->symptomatic.test(disease_id)) {
-    this->symptomatic.reset(disease_id);
+  // assert(store(disease_id).infection[this->idx] != NULL);
+  if(store(disease_id).symptomatic.test(this->idx)) {
+    store(disease_id).symptomatic.reset(this->idx);
   }
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d RESOLVES SYMPTOMS for disease %d\n",
@@ -593,30 +562,30 @@ void Health::resolve_symptoms(Disease* disease) {
 
 void Health::recover(Disease* disease, int day) {
   int disease_id = disease->get_id();
-  // assert(this->infection[disease_id] != NULL);
+  // assert(store(disease_id).infection[this->idx] != NULL);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			   "HEALTH CHART: %s person %d is RECOVERED from disease %d\n",
 			   Date::get_date_string().c_str(),
 			   myself->get_id(), disease_id);
-  this->recovered.set(disease_id);
+  store(disease_id).recovered.set(this->idx);
   int household_index = myself->get_exposed_household_index();
   Household* h = Global::Places.get_household_ptr(household_index);
   h->set_recovered(disease_id);
   h->reset_human_infectious();
   myself->reset_neighborhood();
 
-  this->immunity_end_date[disease_id] = this->infection[disease_id]->get_immunity_end_date();
-  if (this->immunity_end_date[disease_id] > -1) {
-    this->immunity_end_date[disease_id] += day;
+  store(disease_id).immunity_end_date[this->idx] = store(disease_id).infection[this->idx]->get_immunity_end_date();
+  if (store(disease_id).immunity_end_date[this->idx] > -1) {
+    store(disease_id).immunity_end_date[this->idx] += day;
   }
   become_removed(disease_id, day);
 }
 
 void Health::become_removed(int disease_id, int day) {
   terminate_infection(disease_id, day);
-  this->susceptible.reset(disease_id);
-  this->infectious.reset(disease_id);
-  this->symptomatic.reset(disease_id);
+  store(disease_id).susceptible.reset(this->idx);
+  store(disease_id).infectious.reset(this->idx);
+  store(disease_id).symptomatic.reset(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			   "HEALTH CHART: %s person %d is REMOVED for disease %d\n",
 			   Date::get_date_string().c_str(),
@@ -625,12 +594,12 @@ void Health::become_removed(int disease_id, int day) {
 
 void Health::become_immune(Disease* disease) {
   int disease_id = disease->get_id();
-  disease->become_immune(myself, this->susceptible.test(disease_id),
-      this->infectious.test(disease_id), this->symptomatic.test(disease_id));
-  this->immunity.set(disease_id);
-  this->susceptible.reset(disease_id);
-  this->infectious.reset(disease_id);
-  this->symptomatic.reset(disease_id);
+  disease->become_immune(myself, store(disease_id).susceptible.test(this->idx),
+      store(disease_id).infectious.test(this->idx), store(disease_id).symptomatic.test(this->idx));
+  store(disease_id).immunity.set(this->idx);
+  store(disease_id).susceptible.reset(this->idx);
+  store(disease_id).infectious.reset(this->idx);
+  store(disease_id).symptomatic.reset(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is IMMUNE for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -640,11 +609,12 @@ void Health::become_immune(Disease* disease) {
 
 void Health::become_case_fatality(int disease_id, int day) {
   FRED_VERBOSE(0, "DISEASE %d is FATAL: day %d person %d\n", disease_id, day, myself->get_id());
-  this->case_fatality.set(disease_id);
+  store(disease_id).case_fatality.set(this->idx);
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			   "HEALTH CHART: %s person %d is CASE_FATALITY for disease %d\n",
 			   Date::get_date_string().c_str(),
 			   myself->get_id(), disease_id);
+  cancel_infection_events(disease_id);
   become_removed(disease_id, day);
 
   // update household counts
@@ -664,17 +634,23 @@ void Health::become_case_fatality(int disease_id, int day) {
 }
 
 void Health::update_infection(int day, int disease_id) {
+  if(advance_infection(day, disease_id)) {
+    become_case_fatality(disease_id, day);
+  }
+} // end Health::update_infection //
+
+bool Health::advance_infection(int day, int disease_id) {
 
   if(this->has_face_mask_behavior) {
     update_face_mask_decision(day);
   }
   
-  if(this->infection[disease_id] == NULL) {
-    return;
+  if(store(disease_id).infection[this->idx] == NULL) {
+    return false;
   }
   
   FRED_VERBOSE(1, "update_infection %d on day %d person %d\n", disease_id, day, myself->get_id());
-  this->infection[disease_id]->update(day);
+  store(disease_id).infection[this->idx]->update(day);
   
   // update days_symptomatic if needed
   if(this->is_symptomatic(disease_id)) {
@@ -684,29 +660,26 @@ void Health::update_infection(int day, int disease_id) {
     }
   }
 
-  // case_fatality?
-  if(this->infection[disease_id]->is_fatal(day)) {
-    become_case_fatality(disease_id, day);
-  }
-  
   FRED_VERBOSE(1,"update_infection %d FINISHED on day %d person %d\n",
 	       disease_id, day, myself->get_id());
 
-} // end Health::update_infection //
+  // case_fatality?
+  return store(disease_id).infection[this->idx]->is_fatal(day);
+} // end Health::advance_infection //
 
 
 void Health::update_face_mask_decision(int day) {
   // printf("update_face_mask_decision entered on day %d for person %d\n", day, myself->get_id());
 
   // should we start use face mask?
-  if(this->is_symptomatic(day) && this->days_wearing_face_mask == 0) {
+  if(this->is_symptomatic() && this->days_wearing_face_mask == 0) {
     FRED_VERBOSE(1, "FACEMASK: person %d starts wearing face mask on day %d\n", myself->get_id(), day);
     this->start_wearing_face_mask();
   }
 
   // should we stop using face mask?
   if(this->is_wearing_face_mask()) {
-    if (this->is_symptomatic(day) && this->days_wearing_face_mask < Health::Days_to_wear_face_masks) {
+    if (this->is_symptomatic() && this->days_wearing_face_mask < Health::Days_to_wear_face_masks) {
       this->days_wearing_face_mask++;
     } else {
       FRED_VERBOSE(1, "FACEMASK: person %d stops wearing face mask on day %d\n", myself->get_id(), day);
@@ -740,73 +713,82 @@ void Health::update_interventions(int day) {
 
 void Health::declare_at_risk(Disease* disease) {
   int disease_id = disease->get_id();
-  this->at_risk.set(disease_id);
+  store(disease_id).at_risk.set(this->idx);
 }
 
 void Health::advance_seed_infection(int disease_id, int days_to_advance) {
-  assert(this->infection[disease_id] != NULL);
-  this->infection[disease_id]->advance_seed_infection(days_to_advance);
+  assert(store(disease_id).infection[this->idx] != NULL);
+  store(disease_id).infection[this->idx]->advance_seed_infection(days_to_advance);
 }
 
 int Health::get_exposure_date(int disease_id) const {
-  return this->exposure_date[disease_id];
+  return store(disease_id).exposure_date[this->idx];
 }
 
 int Health::get_infectious_start_date(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return -1;
   } else {
-    return this->infection[disease_id]->get_infectious_start_date();
+    return store(disease_id).infection[this->idx]->get_infectious_start_date();
   }
 }
 
 int Health::get_infectious_end_date(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return -1;
   } else {
-    return this->infection[disease_id]->get_infectious_end_date();
+    return store(disease_id).infection[this->idx]->get_infectious_end_date();
   }
 }
 
 int Health::get_symptoms_start_date(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return -1;
   } else {
-    return this->infection[disease_id]->get_symptoms_start_date();
+    return store(disease_id).infection[this->idx]->get_symptoms_start_date();
   }
 }
 
 int Health::get_symptoms_end_date(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return -1;
   } else {
-    return this->infection[disease_id]->get_symptoms_end_date();
+    return store(disease_id).infection[this->idx]->get_symptoms_end_date();
   }
 }
 
 int Health::get_immunity_end_date(int disease_id) const {
-  return this->immunity_end_date[disease_id];
+  return store(disease_id).immunity_end_date[this->idx];
+}
+
+bool Health::is_symptomatic() const {
+  for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
+    if(store(disease_id).symptomatic.test(this->idx)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool Health::is_recovered(int disease_id) {
-  return this->recovered.test(disease_id);
+  return store(disease_id).recovered.test(this->idx);
 }
 
 
 int Health::get_infector_id(int disease_id) const {
-  return infector_id[disease_id];
+  return store(disease_id).infector_id[this->idx];
 }
 
 Person* Health::get_infector(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return NULL;
   } else {
-    return this->infection[disease_id]->get_infector();
+    return store(disease_id).infection[this->idx]->get_infector();
   }
 }
 
 Mixing_Group* Health::get_infected_mixing_group(int disease_id) const {
-  return this->infected_in_mixing_group[disease_id];
+  return store(disease_id).infected_in_mixing_group[this->idx];
 }
 
 int Health::get_infected_mixing_group_id(int disease_id) const {
@@ -829,7 +811,7 @@ char Health::get_infected_mixing_group_type(int disease_id) const {
 
 char dummy_label[8];
 char* Health::get_infected_mixing_group_label(int disease_id) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     strcpy(dummy_label, "-");
     return dummy_label;
   }
@@ -843,33 +825,33 @@ char* Health::get_infected_mixing_group_label(int disease_id) const {
 }
 
 int Health::get_infectees(int disease_id) const {
-  return this->infectee_count[disease_id];
+  return store(disease_id).infectee_count[this->idx];
 }
 
 double Health::get_susceptibility(int disease_id) const {
-  double suscep_multp = this->susceptibility_multp[disease_id];
+  double suscep_multp = store(disease_id).susceptibility_multp[this->idx];
 
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return suscep_multp;
   } else {
-    return this->infection[disease_id]->get_susceptibility() * suscep_multp;
+    return store(disease_id).infection[this->idx]->get_susceptibility() * suscep_multp;
   }
 }
 
 double Health::get_infectivity(int disease_id, int day) const {
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return 0.0;
   } else {
-    return this->infection[disease_id]->get_infectivity(day);
+    return store(disease_id).infection[this->idx]->get_infectivity(day);
   }
 }
 
 double Health::get_symptoms(int disease_id, int day) const {
 
-  if(this->infection[disease_id] == NULL) {
+  if(store(disease_id).infection[this->idx] == NULL) {
     return 0.0;
   } else {
-    return this->infection[disease_id]->get_symptoms(day);
+    return store(disease_id).infection[this->idx]->get_symptoms(day);
   }
 }
 
@@ -925,41 +907,41 @@ double Health::get_susceptibility_modifier_due_to_household_income(int hh_income
 }
 
 void Health::modify_susceptibility(int disease_id, double multp) {
-  this->susceptibility_multp[disease_id] *= multp;
+  store(disease_id).susceptibility_multp[this->idx] *= multp;
 }
 
 void Health::modify_infectivity(int disease_id, double multp) {
-  if(this->infection[disease_id] != NULL) {
-    this->infection[disease_id]->modify_infectivity(multp);
+  if(store(disease_id).infection[this->idx] != NULL) {
+    store(disease_id).infection[this->idx]->modify_infectivity(multp);
   }
 }
 
 void Health::modify_infectious_period(int disease_id, double multp, int cur_day) {
-  if(this->infection[disease_id] != NULL) {
-    this->infection[disease_id]->modify_infectious_period(multp, cur_day);
+  if(store(disease_id).infection[this->idx] != NULL) {
+    store(disease_id).infection[this->idx]->modify_infectious_period(multp, cur_day);
   }
 }
 
 void Health::modify_asymptomatic_period(int disease_id, double multp, int cur_day) {
-  if(this->infection[disease_id] != NULL) {
-    this->infection[disease_id]->modify_asymptomatic_period(multp, cur_day);
+  if(store(disease_id).infection[this->idx] != NULL) {
+    store(disease_id).infection[this->idx]->modify_asymptomatic_period(multp, cur_day);
   }
 }
 
 void Health::modify_symptomatic_period(int disease_id, double multp, int cur_day) {
-  if(this->infection[disease_id] != NULL) {
-    this->infection[disease_id]->modify_symptomatic_period(multp, cur_day);
+  if(store(disease_id).infection[this->idx] != NULL) {
+    store(disease_id).infection[this->idx]->modify_symptomatic_period(multp, cur_day);
   }
 }
 
 void Health::modify_develops_symptoms(int disease_id, bool symptoms, int cur_day) {
-  if(this->infection[disease_id] != NULL
-     && ((this->infection[disease_id]->is_infectious(cur_day)
-	        && !this->infection[disease_id]->is_symptomatic(cur_day))
-	        || !this->infection[disease_id]->is_infectious(cur_day))) {
+  if(store(disease_id).infection[this->idx] != NULL
+     && ((store(disease_id).infection[this->idx]->is_infectious(cur_day)
+	        && !store(disease_id).infection[this->idx]->is_symptomatic(cur_day))
+	        || !store(disease_id).infection[this->idx]->is_infectious(cur_day))) {
 
-    this->infection[disease_id]->modify_develops_symptoms(symptoms, cur_day);
-    this->symptomatic.set(disease_id);
+    store(disease_id).infection[this->idx]->modify_develops_symptoms(symptoms, cur_day);
+    store(disease_id).symptomatic.set(this->idx);
   }
 }
 
@@ -980,6 +962,9 @@ void Health::take_vaccine(Vaccine* vaccine, int day, Vaccine_Manager* vm) {
     }
   }
 
+  // a dose may change the protection against every strain
+  clear_immunity_cache();
+
   if(vaccine_health_for_dose == NULL) { // This is our first dose of this vaccine
     this->vaccine_health->push_back(new Vaccine_Health(day, vaccine, real_age, myself, vm));
     this->intervention_flags[Intervention_flag::TAKES_VACCINE] = true;
@@ -1029,7 +1014,7 @@ void Health::infect(Person* infectee, int disease_id, Mixing_Group* mixing_group
   infectee->become_exposed(disease_id, myself, mixing_group, day);
 
 #pragma omp atomic
-  ++(this->infectee_count[disease_id]);
+  ++(store(disease_id).infectee_count[this->idx]);
   
   int exp_day = this->get_exposure_date(disease_id);
   assert(0 <= exp_day);
@@ -1037,7 +1022,7 @@ void Health::infect(Person* infectee, int disease_id, Mixing_Group* mixing_group
   disease->increment_cohort_infectee_count(exp_day);
 
   FRED_STATUS(1, "person %d infected person %d infectees = %d\n",
-	      myself->get_id(), infectee->get_id(), infectee_count[disease_id]);
+	      myself->get_id(), infectee->get_id(), store(disease_id).infectee_count[this->idx]);
 
   if(Global::Enable_Transmission_Network) {
     FRED_VERBOSE(1, "Creating link in transmission network: %d -> %d\n", myself->get_id(), infectee->get_id());
@@ -1070,32 +1055,45 @@ void Health::update_mixing_group_counts(int day, int disease_id, Mixing_Group* m
 }
 
 void Health::terminate_infection(int disease_id, int day) {
-  if(this->health_condition[disease_id].state > -1) {
+  if(store(disease_id).health_condition[this->idx].state > -1) {
     Global::Diseases.get_disease(disease_id)->terminate_person(myself, day);
   }
-  if(this->infection[disease_id] != NULL) {
+  if(store(disease_id).infection[this->idx] != NULL) {
     // delete the infection object
-    delete this->infection[disease_id];
-    this->infection[disease_id] = NULL;
+    delete store(disease_id).infection[this->idx];
+    store(disease_id).infection[this->idx] = NULL;
+  }
+}
+
+void Health::cancel_infection_events(int disease_id) {
+  // an SEIR infection cut short by death still has events queued for
+  // its later stages; other diseases cancel them in terminate_infection
+  if(store(disease_id).health_condition[this->idx].state == -1
+     && store(disease_id).infection[this->idx] != NULL) {
+    Global::Diseases.get_disease(disease_id)->get_epidemic()->cancel_infection_events(myself);
   }
 }
 
 void Health::terminate(int day) {
   for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-    if(this->infection[disease_id] != NULL) {
+    if(store(disease_id).infection[this->idx] != NULL) {
+      cancel_infection_events(disease_id);
       become_removed(disease_id, day);
     }
-    if(this->health_condition[disease_id].state == 0) {
+    if(store(disease_id).health_condition[this->idx].state == 0) {
       Global::Diseases.get_disease(disease_id)->terminate_person(myself, day);;
     }
+    // SEIR people (state -1) never reach Epidemic::terminate_person, and
+    // a case fatality is no longer infected but may still be listed
+    Global::Diseases.get_disease(disease_id)->get_epidemic()->remove_from_active_sets(myself);
   }
   this->alive = false;
 }
 
 void Health::update_health_conditions(int day) {
   for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-    if(this->health_condition[disease_id].state > -1) {
-      Global::Diseases.get_disease(disease_id)->get_epidemic()->transition_person(this->myself, day, this->health_condition[disease_id].state);
+    if(store(disease_id).health_condition[this->idx].state > -1) {
+      Global::Diseases.get_disease(disease_id)->get_epidemic()->transition_person(this->myself, day, store(disease_id).health_condition[this->idx].state);
     }    
   }  
 }
@@ -23,8 +23,10 @@ using namespace std;
 #include "Age_Map.h"
 #include "Disease.h"
 #include "Global.h"
+#include "Health_Store.h"
 #include "Infection.h"
 #include "Past_Infection.h"
+#include "Random.h"
 
 class Antiviral;
 class Antivirals;
@@ -37,12 +39,6 @@ class Vaccine;
 class Vaccine_Health;
 class Vaccine_Manager;
 
-typedef struct {
-  int state;
-  int last_transition_day;
-  int next_state;
-  int next_transition_day;
-} health_condition_t;
 
 
 // The following enum defines symbolic names for Chronic Medical Conditions.
@@ -94,6 +90,11 @@ public:
   // UPDATE THE PERSON'S HEALTH CONDITIONS
 
   void update_infection(int day, int disease_id);
+
+  // The part of update_infection() that only changes this person's own
+  // state, so it may run for many people at once.  Returns true if the
+  // infection became fatal today; the caller then calls become_case_fatality().
+  bool advance_infection(int day, int disease_id);
   void update_face_mask_decision(int day);
   void update_interventions(int day);
   void become_exposed(int disease_id, Person* infector, Mixing_Group* mixing_group, int day);
@@ -122,10 +123,12 @@ public:
   }
   void clear_past_infections(int disease_id) {
     this->past_infections[disease_id].clear();
+    clear_immunity_cache();
   }
   void add_past_infection(int strain_id, int recovery_date, int age_at_exposure, Disease* dis) {
     this->past_infections[dis->get_id()].push_back(
 						   Past_Infection(strain_id, recovery_date, age_at_exposure));
+    clear_immunity_cache();
   }
   void update_mixing_group_counts(int day, int disease_id, Mixing_Group* mixing_group);
 
@@ -154,7 +157,7 @@ public:
   double get_infectivity(int disease_id, int day) const;
   double get_symptoms(int disease_id, int day) const;
   Infection* get_infection(int disease_id) const {
-    return this->infection[disease_id];
+    return store(disease_id).infection[this->idx];
   }
   double get_transmission_modifier_due_to_hygiene(int disease_id);
   double get_susceptibility_modifier_due_to_hygiene(int disease_id);
@@ -166,41 +169,56 @@ public:
     return &(this->past_infections[disease].at(i));
   }
 
+  // the probability of taking strain on day given past infections, as
+  // last computed by the disease's evolution model; false if not cached
+  bool get_cached_prob_taking(int disease_id, int strain, int day, double* prob_taking) const {
+    if(this->immunity_cache.disease_id != disease_id || this->immunity_cache.strain != strain
+       || this->immunity_cache.day != day) {
+      return false;
+    }
+    *prob_taking = this->immunity_cache.prob_taking;
+    return true;
+  }
+  void set_cached_prob_taking(int disease_id, int strain, int day, double prob_taking) {
+    this->immunity_cache.disease_id = disease_id;
+    this->immunity_cache.strain = strain;
+    this->immunity_cache.day = day;
+    this->immunity_cache.prob_taking = prob_taking;
+  }
+
 
   // TESTS FOR HEALTH CONDITIONS
 
   bool is_case_fatality(int disease_id) {
-    return this->case_fatality.test(disease_id);
+    return store(disease_id).case_fatality.test(this->idx);
   }
 
   bool is_susceptible(int disease_id) const {
-    return this->susceptible.test(disease_id);
+    return store(disease_id).susceptible.test(this->idx);
   }
 
   bool is_infectious(int disease_id) const {
-    return this->infectious.test(disease_id);
+    return store(disease_id).infectious.test(this->idx);
   }
 
   bool is_infected(int disease_id) const {
-    return this->infection[disease_id] != NULL;
+    return store(disease_id).infection[this->idx] != NULL;
   }
 
-  bool is_symptomatic() const {
-    return this->symptomatic.any();
-  }
+  bool is_symptomatic() const;
 
   bool is_symptomatic(int disease_id) {
-    return this->symptomatic.test(disease_id);
+    return store(disease_id).symptomatic.test(this->idx);
   }
 
   bool is_recovered(int disease_id);
 
   bool is_immune(int disease_id) const {
-    return this->immunity.test(disease_id);
+    return store(disease_id).immunity.test(this->idx);
   }
 
   bool is_at_risk(int disease_id) const {
-    return this->at_risk.test(disease_id);
+    return store(disease_id).at_risk.test(this->idx);
   }
 
   bool is_on_av_for_disease(int day, int disease_id) const;
@@ -503,12 +521,7 @@ public:
   bool has_chronic_condition(int cond_idx) {
     assert(cond_idx >= static_cast<int>(Chronic_condition_index::ASTHMA));
     assert(cond_idx < static_cast<int>(Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS));
-    if(this->chronic_conditions_map.find(static_cast<Chronic_condition_index::e>(cond_idx))
-       != this->chronic_conditions_map.end()) {
-      return this->chronic_conditions_map[static_cast<Chronic_condition_index::e>(cond_idx)];
-    } else {
-      return false;
-    }
+    return this->chronic_conditions.test(cond_idx);
   }
 
   /*
@@ -519,7 +532,7 @@ public:
   void set_has_chronic_condition(Chronic_condition_index::e cond_idx, bool has_cond) {
     assert(cond_idx >= Chronic_condition_index::ASTHMA);
     assert(cond_idx < Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS);
-    this->chronic_conditions_map[cond_idx] = has_cond;
+    this->chronic_conditions.set(cond_idx, has_cond);
   }
 
   /*
@@ -643,34 +656,34 @@ public:
   static bool Enable_hh_income_based_susc_mod;
 
   void set_fatal_infection(int disease_id) {
-    assert(this->infection[disease_id] != NULL);
-    this->infection[disease_id]->set_fatal_infection();
+    assert(store(disease_id).infection[this->idx] != NULL);
+    store(disease_id).infection[this->idx]->set_fatal_infection();
   }
 
   int get_health_state(int disease_id) {
-    return this->health_condition[disease_id].state;
+    return store(disease_id).health_condition[this->idx].state;
   }
 
   void set_health_state(int disease_id, int s, int day) {
-    this->health_condition[disease_id].state = s;
-    this->health_condition[disease_id].last_transition_day = day;
+    store(disease_id).health_condition[this->idx].state = s;
+    store(disease_id).health_condition[this->idx].last_transition_day = day;
   }
 
   int get_last_transition_day(int disease_id) {
-    return this->health_condition[disease_id].last_transition_day;
+    return store(disease_id).health_condition[this->idx].last_transition_day;
   }
 
   int get_next_health_state(int disease_id) {
-    return this->health_condition[disease_id].next_state;
+    return store(disease_id).health_condition[this->idx].next_state;
   }
 
   void set_next_health_state(int disease_id, int s, int day) {
-    this->health_condition[disease_id].next_state = s;
-    this->health_condition[disease_id].next_transition_day = day;
+    store(disease_id).health_condition[this->idx].next_state = s;
+    store(disease_id).health_condition[this->idx].next_transition_day = day;
   }
 
   int get_next_transition_day(int disease_id) {
-    return this->health_condition[disease_id].next_transition_day;
+    return store(disease_id).health_condition[this->idx].next_transition_day;
   }
 
   void update_health_conditions(int day);
@@ -680,37 +693,20 @@ private:
   // link back to person
   Person * myself;
 
-  // active infections (NULL if not infected)
-  Infection** infection;
+  // row of this person in the Health_Store (the person's population index)
+  int idx;
+
+  Health_Store::Columns & store(int disease_id) const {
+    return Health_Store::get_columns(disease_id);
+  }
 
-  // health condition array
-  health_condition_t* health_condition;
+  void cancel_infection_events(int disease_id);
 
-  // persistent infection data (kept after infection clears)
-  double* susceptibility_multp;
-  int* infectee_count;
-  int* immunity_end_date;
-  int* exposure_date;
-  int* infector_id;
-  Mixing_Group** infected_in_mixing_group;
   int days_symptomatic; 			// over all diseases
 
   // living or not?
   bool alive;
 
-  // bitset removes need to check each infection in above array to
-  // find out if any are not NULL
-  fred::disease_bitset immunity;
-  fred::disease_bitset at_risk; // Agent is/isn't at risk for severe complications
-
-  // Per-disease health status flags
-  fred::disease_bitset susceptible;
-  fred::disease_bitset infectious;
-  fred::disease_bitset symptomatic;
-  fred::disease_bitset recovered_today;
-  fred::disease_bitset recovered;
-  fred::disease_bitset case_fatality;
-
   // Define a bitset type to hold health flags
   // Enumeration corresponding to positions in health
   typedef std::bitset<2> intervention_flags_type;
@@ -737,7 +733,7 @@ private:
   bool washes_hands;				// every day
 
   // current chronic conditions
-  std::map<Chronic_condition_index::e, bool> chronic_conditions_map;
+  std::bitset<Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS> chronic_conditions;
 
   //Insurance Type
   Insurance_assignment_index::e insurance_type;
@@ -746,12 +742,23 @@ private:
   typedef std::vector<Past_Infection> past_infections_type;
   past_infections_type* past_infections;
 
+  // one entry for the last challenge, since immunity from past
+  // infections decays daily; cleared when a past infection or a vaccine
+  // dose is added
+  struct Immunity_Cache {
+    int disease_id;
+    int strain;
+    int day;
+    double prob_taking;
+  };
+  Immunity_Cache immunity_cache;
+  void clear_immunity_cache() {
+    this->immunity_cache.disease_id = -1;
+  }
+
   // previous infection serotype (for dengue)
   int previous_infection_serotype;
 
-  // processes related to health
-  std::vector<int> health_state;
-
   /////// STATIC MEMBERS
 
   static bool is_initialized;
@@ -790,8 +797,7 @@ private:
   static double Hh_income_susc_mod_floor;
 
   // health insurance probabilities
-  static double health_insurance_distribution[Insurance_assignment_index::UNSET];
-  static int health_insurance_cdf_size;
+  static Alias_Table health_insurance_distribution;
 
 };
 
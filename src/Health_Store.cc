@@ -0,0 +1,99 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Health_Store.cc
+//
+
+#include "Health_Store.h"
+
+Health_Store::Columns Health_Store::columns[Global::MAX_NUM_DISEASES];
+int Health_Store::capacity = 0;
+int Health_Store::diseases = 0;
+
+void Health_Store::add_person(int idx, int diseases) {
+  assert(0 <= idx);
+  assert(diseases <= Global::MAX_NUM_DISEASES);
+  if(Health_Store::diseases < diseases) {
+    Health_Store::diseases = diseases;
+    // size the new diseases' columns to match the others
+    grow(Health_Store::capacity);
+  }
+  if(Health_Store::capacity <= idx) {
+    int new_capacity = 2 * Health_Store::capacity;
+    if(new_capacity <= idx) {
+      new_capacity = idx + 1;
+    }
+    grow(new_capacity);
+  }
+
+  health_condition_t no_condition = { -1, -1, -1, -1 };
+  for(int disease_id = 0; disease_id < diseases; ++disease_id) {
+    Columns & col = Health_Store::columns[disease_id];
+    col.infection[idx] = NULL;
+    col.health_condition[idx] = no_condition;
+    col.susceptibility_multp[idx] = 1.0;
+    col.infectee_count[idx] = 0;
+    col.immunity_end_date[idx] = -1;
+    col.exposure_date[idx] = -1;
+    col.infector_id[idx] = -1;
+    col.infected_in_mixing_group[idx] = NULL;
+    col.susceptible.reset(idx);
+    col.infectious.reset(idx);
+    col.symptomatic.reset(idx);
+    col.recovered.reset(idx);
+    col.immunity.reset(idx);
+    col.at_risk.reset(idx);
+    col.case_fatality.reset(idx);
+  }
+}
+
+void Health_Store::grow(int new_capacity) {
+  for(int disease_id = 0; disease_id < Health_Store::diseases; ++disease_id) {
+    Columns & col = Health_Store::columns[disease_id];
+    col.infection.resize(new_capacity, NULL);
+    col.health_condition.resize(new_capacity);
+    col.susceptibility_multp.resize(new_capacity, 1.0);
+    col.infectee_count.resize(new_capacity, 0);
+    col.immunity_end_date.resize(new_capacity, -1);
+    col.exposure_date.resize(new_capacity, -1);
+    col.infector_id.resize(new_capacity, -1);
+    col.infected_in_mixing_group.resize(new_capacity, NULL);
+    col.susceptible.resize(new_capacity);
+    col.infectious.resize(new_capacity);
+    col.symptomatic.resize(new_capacity);
+    col.recovered.resize(new_capacity);
+    col.immunity.resize(new_capacity);
+    col.at_risk.resize(new_capacity);
+    col.case_fatality.resize(new_capacity);
+  }
+  Health_Store::capacity = new_capacity;
+}
+
+size_t Health_Store::get_bytes() {
+  size_t bytes = 0;
+  for(int disease_id = 0; disease_id < Health_Store::diseases; ++disease_id) {
+    Columns & col = Health_Store::columns[disease_id];
+    bytes += col.infection.capacity() * sizeof(Infection*);
+    bytes += col.health_condition.capacity() * sizeof(health_condition_t);
+    bytes += col.susceptibility_multp.capacity() * sizeof(double);
+    bytes += col.infectee_count.capacity() * sizeof(int);
+    bytes += col.immunity_end_date.capacity() * sizeof(int);
+    bytes += col.exposure_date.capacity() * sizeof(int);
+    bytes += col.infector_id.capacity() * sizeof(int);
+    bytes += col.infected_in_mixing_group.capacity() * sizeof(Mixing_Group*);
+    bytes += col.susceptible.get_bytes() + col.infectious.get_bytes() + col.symptomatic.get_bytes();
+    bytes += col.recovered.get_bytes() + col.immunity.get_bytes() + col.at_risk.get_bytes();
+    bytes += col.case_fatality.get_bytes();
+  }
+  return bytes;
+}
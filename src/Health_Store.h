@@ -0,0 +1,120 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Health_Store.h
+//
+// Health_Store holds the per-disease health state of the whole population
+// as structure-of-arrays columns indexed by person index (see
+// Person::get_pop_index), with one bit per person for each health flag.
+// Health objects are thin views that read and write their own row, so the
+// transmission loops test a person's flags in a dense bit column instead
+// of chasing per-person heap arrays.
+//
+
+#ifndef _FRED_HEALTH_STORE_H
+#define _FRED_HEALTH_STORE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "Global.h"
+
+using namespace std;
+
+class Infection;
+class Mixing_Group;
+
+typedef struct {
+  int state;
+  int last_transition_day;
+  int next_state;
+  int next_transition_day;
+} health_condition_t;
+
+// one bit per person
+class Health_Flags {
+public:
+  bool test(int idx) const {
+    return (this->words[idx >> 6] >> (idx & 63)) & 1;
+  }
+  void set(int idx) {
+    this->words[idx >> 6] |= ((uint64_t) 1 << (idx & 63));
+  }
+  void reset(int idx) {
+    this->words[idx >> 6] &= ~((uint64_t) 1 << (idx & 63));
+  }
+  void resize(int size) {
+    this->words.resize((size + 63) / 64, 0);
+  }
+  size_t get_bytes() const {
+    return this->words.capacity() * sizeof(uint64_t);
+  }
+
+private:
+  std::vector<uint64_t> words;
+};
+
+class Health_Store {
+public:
+
+  // the columns for one disease
+  struct Columns {
+    // active infections (NULL if not infected)
+    std::vector<Infection*> infection;
+
+    // Markov health condition
+    std::vector<health_condition_t> health_condition;
+
+    // persistent infection data (kept after infection clears)
+    std::vector<double> susceptibility_multp;
+    std::vector<int> infectee_count;
+    std::vector<int> immunity_end_date;
+    std::vector<int> exposure_date;
+    std::vector<int> infector_id;
+    std::vector<Mixing_Group*> infected_in_mixing_group;
+
+    // health status flags
+    Health_Flags susceptible;
+    Health_Flags infectious;
+    Health_Flags symptomatic;
+    Health_Flags recovered;
+    Health_Flags immunity;
+    Health_Flags at_risk; // at risk for severe complications
+    Health_Flags case_fatality;
+  };
+
+  /**
+   * Make room for the person with the given index and reset that row to
+   * the state of a newly created person.  Called from Health::setup, so
+   * rows of people who died are reused by the next person given their index.
+   */
+  static void add_person(int idx, int diseases);
+
+  static Columns & get_columns(int disease_id) {
+    return Health_Store::columns[disease_id];
+  }
+
+  /**
+   * @return the bytes currently held by all columns
+   */
+  static size_t get_bytes();
+
+private:
+  static void grow(int new_capacity);
+
+  static Columns columns[Global::MAX_NUM_DISEASES];
+  static int capacity;
+  static int diseases;
+};
+
+#endif // _FRED_HEALTH_STORE_H
@@ -41,6 +41,7 @@ double Hospital::HAZEL_disaster_capacity_multiplier = 1.0;
 int Hospital::HAZEL_mobile_van_open_delay = 0;
 int Hospital::HAZEL_mobile_van_closure_day = 0;
 std::vector<double> Hospital::HAZEL_reopening_CDF;
+Alias_Table Hospital::HAZEL_reopening_table;
 HospitalInitMapT Hospital::HAZEL_hospital_init_map;
 
 Hospital::Hospital() : Place() {
@@ -133,6 +134,7 @@ void Hospital::get_parameters() {
     char hosp_init_file_dir[FRED_STRING_SIZE];
 
     Params::get_param_vector((char*)"HAZEL_reopening_CDF", Hospital::HAZEL_reopening_CDF);
+    Hospital::HAZEL_reopening_table.set_cdf(Hospital::HAZEL_reopening_CDF);
     Params::get_param_from_string("HAZEL_disaster_capacity_multiplier", &Hospital::HAZEL_disaster_capacity_multiplier);
     Params::get_param_from_string("HAZEL_mobile_van_open_delay", &Hospital::HAZEL_mobile_van_open_delay);
     Params::get_param_from_string("HAZEL_mobile_van_closure_day", &Hospital::HAZEL_mobile_van_closure_day);
@@ -316,7 +318,7 @@ void Hospital::apply_individual_HAZEL_closure_policy() {
   }
 
   if(!this->HAZEL_closure_dates_have_been_set) {
-    int cdf_day = Random::draw_from_cdf_vector(Hospital::HAZEL_reopening_CDF);
+    int cdf_day = Hospital::HAZEL_reopening_table.draw();
     this->set_close_date(Place_List::get_HAZEL_disaster_start_sim_day());
     this->set_open_date(Place_List::get_HAZEL_disaster_end_sim_day() + cdf_day);
     this->HAZEL_closure_dates_have_been_set = true;
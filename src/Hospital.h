@@ -167,6 +167,7 @@ private:
   static HospitalInitMapT HAZEL_hospital_init_map;
   static bool HAZEL_hospital_init_map_file_exists;
   static std::vector<double> HAZEL_reopening_CDF;
+  static Alias_Table HAZEL_reopening_table;	// draws from HAZEL_reopening_CDF
 
   int bed_count;
   int occupied_bed_count;
@@ -0,0 +1,91 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Hospital_Index.cc
+//
+
+#include <algorithm>
+
+#include "Hospital_Index.h"
+#include "Geo.h"
+#include "Global.h"
+#include "Hospital.h"
+#include "Neighborhood_Layer.h"
+#include "Neighborhood_Patch.h"
+
+// slack for rounding in the patch bounds, in km
+#define HOSPITAL_INDEX_SLACK 1e-6
+
+void Hospital_Index::setup(const place_vector_t &hospitals, double radius) {
+  int number_hospitals = hospitals.size();
+  this->radius = radius;
+  this->hospital_x.resize(number_hospitals);
+  this->hospital_y.resize(number_hospitals);
+  this->all.clear();
+  for(int t = 0; t < Insurance_assignment_index::UNSET; ++t) {
+    this->by_insurance[t].clear();
+  }
+  for(int i = 0; i < number_hospitals; ++i) {
+    Hospital* hospital = static_cast<Hospital*>(hospitals[i]);
+    this->hospital_x[i] = Geo::get_x(hospital->get_longitude());
+    this->hospital_y[i] = Geo::get_y(hospital->get_latitude());
+    this->all.push_back(i);
+    for(int t = 0; t < Insurance_assignment_index::UNSET; ++t) {
+      if(hospital->accepts_insurance(static_cast<Insurance_assignment_index::e>(t))) {
+        this->by_insurance[t].push_back(i);
+      }
+    }
+  }
+
+  Neighborhood_Layer* grid = Global::Neighborhoods;
+  this->rows = grid->get_rows();
+  this->cols = grid->get_cols();
+  this->by_patch.clear();
+  this->by_patch.resize(this->rows * this->cols);
+  double size = grid->get_patch_size();
+  double reach = radius + HOSPITAL_INDEX_SLACK;
+  int candidates = 0;
+  for(int row = 0; row < this->rows; ++row) {
+    for(int col = 0; col < this->cols; ++col) {
+      double x_low = grid->get_min_x() + col * size;
+      double y_low = grid->get_min_y() + row * size;
+      std::vector<int> &list = this->by_patch[row * this->cols + col];
+      for(int i = 0; i < number_hospitals; ++i) {
+        // distance from the hospital to the nearest point of the patch
+        double dx = std::max(0.0, std::max(x_low - this->hospital_x[i], this->hospital_x[i] - (x_low + size)));
+        double dy = std::max(0.0, std::max(y_low - this->hospital_y[i], this->hospital_y[i] - (y_low + size)));
+        if(dx * dx + dy * dy <= reach * reach) {
+          list.push_back(i);
+        }
+      }
+      candidates += list.size();
+    }
+  }
+  this->is_setup = true;
+  FRED_VERBOSE(0, "Hospital_Index: %d hospitals, %d patches, %d patch candidates within %.1f km\n",
+               number_hospitals, this->rows * this->cols, candidates, radius);
+}
+
+const std::vector<int> & Hospital_Index::get_candidates(Place* place, bool use_search_radius_limit,
+                                                        Insurance_assignment_index::e insurance) const {
+  if(use_search_radius_limit) {
+    Neighborhood_Patch* patch = Global::Neighborhoods->get_patch(place->get_latitude(), place->get_longitude());
+    if(patch != NULL) {
+      return this->by_patch[patch->get_row() * this->cols + patch->get_col()];
+    }
+  }
+  if(insurance != Insurance_assignment_index::UNSET) {
+    return this->by_insurance[insurance];
+  }
+  return this->all;
+}
@@ -0,0 +1,88 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Hospital_Index.h
+//
+// Candidate lists for the hospital searches in Place_List.  For a search
+// limited to the hospitalization radius, the candidates are the
+// hospitals within the radius of some point of the household's
+// neighborhood patch, found for every patch at setup.  For an
+// unlimited search that checks insurance, they are the hospitals that
+// accept the person's insurance.  Otherwise they are all the hospitals.
+// The lists keep the order of Place_List's hospital vector, so a search
+// over the candidates picks exactly the hospital a search over every
+// hospital would.  The hospitals' grid coordinates are cached, so the
+// distances equal Geo::xy_distance without converting each hospital's
+// latitude and longitude again.
+//
+
+#ifndef _FRED_HOSPITAL_INDEX_H
+#define _FRED_HOSPITAL_INDEX_H
+
+#include <math.h>
+#include <vector>
+
+#include "Health.h"
+#include "Place.h"
+
+class Hospital;
+
+class Hospital_Index {
+public:
+  Hospital_Index() {
+    this->rows = 0;
+    this->cols = 0;
+    this->radius = 0.0;
+    this->is_setup = false;
+  }
+
+  bool is_ready() const {
+    return this->is_setup;
+  }
+
+  /**
+   * Index the given hospitals for searches within radius (km).
+   */
+  void setup(const place_vector_t &hospitals, double radius);
+
+  /**
+   * Indices into the hospital vector of the hospitals a search from
+   * place might choose.  insurance is UNSET for a search that ignores
+   * insurance.
+   */
+  const std::vector<int> & get_candidates(Place* place, bool use_search_radius_limit,
+                                          Insurance_assignment_index::e insurance) const;
+
+  /**
+   * Same as Geo::xy_distance from a point at grid coordinates (x, y)
+   * to hospital i.
+   */
+  double get_distance(double x, double y, int i) const {
+    double dx = x - this->hospital_x[i];
+    double dy = y - this->hospital_y[i];
+    return sqrt(dx * dx + dy * dy);
+  }
+
+private:
+  int rows;
+  int cols;
+  double radius;
+  bool is_setup;
+  std::vector<double> hospital_x;
+  std::vector<double> hospital_y;
+  std::vector<int> all;
+  std::vector<int> by_insurance[Insurance_assignment_index::UNSET];
+  std::vector<std::vector<int> > by_patch;	// rows * cols
+};
+
+#endif // _FRED_HOSPITAL_INDEX_H
@@ -18,6 +18,7 @@
 #include "Markov_Infection.h"
 #include "Household.h"
 #include "Infection.h"
+#include "Infection_Log.h"
 #include "Mixing_Group.h"
 #include "Natural_History.h"
 #include "Neighborhood_Patch.h"
@@ -261,42 +262,43 @@ void Infection::report_infection(int day) {
     }
   }
   int mixing_group_size = (this->mixing_group == NULL ? -1 : this->mixing_group->get_container_size());
-  std::stringstream infStrS;
-  infStrS.precision(3);
-  infStrS << fixed << "day " << day << " dis " << this->disease->get_disease_name() << " host " << this->host->get_id()
-	        << " age " << this->host->get_real_age()
-	        << " | DATES exp " << this->exposure_date
-	        << " inf " << get_infectious_start_date() << " " << get_infectious_end_date()
-	        << " symp " << get_symptoms_start_date() << " " << get_symptoms_end_date()
-	        << " rec " << get_infectious_end_date() << " sus " << get_immunity_end_date()
-	        << " infector_exp_date " << (this->infector == NULL ? -1 : this->infector->get_exposure_date(this->disease->get_id()))
-	        << " | ";
+
+  Infection_Record r;
+  memset(&r, 0, sizeof(r));
+  r.day = day;
+  r.disease = this->disease->get_id();
+  r.host = this->host->get_id();
+  r.host_age = this->host->get_real_age();
+  r.exposure_date = this->exposure_date;
+  r.infectious_start_date = get_infectious_start_date();
+  r.infectious_end_date = get_infectious_end_date();
+  r.symptoms_start_date = get_symptoms_start_date();
+  r.symptoms_end_date = get_symptoms_end_date();
+  r.immunity_end_date = get_immunity_end_date();
+  r.infector_exposure_date = (this->infector == NULL ? -1 : this->infector->get_exposure_date(this->disease->get_id()));
 
   if(Global::Track_infection_events > 1) {
-    infStrS << " sick_leave " << this->host->is_sick_leave_available()
-	          << " infector " << (this->infector == NULL ? -1 : this->infector->get_id()) << " inf_age "
-	          << (this->infector == NULL ? -1 : this->infector->get_real_age()) << " inf_sympt "
-	          << (this->infector == NULL ? -1 : this->infector->is_symptomatic()) << " inf_sick_leave "
-	          << (this->infector == NULL ? -1 : this->infector->is_sick_leave_available())
-	          << " at " << mixing_group_type << " mixing_group " <<  mixing_group_id << " subtype " << mixing_group_subtype;
-    infStrS << " size " << mixing_group_size << " is_teacher " << (int)this->host->is_teacher();
-    
+    r.sick_leave = this->host->is_sick_leave_available();
+    r.infector = (this->infector == NULL ? -1 : this->infector->get_id());
+    r.infector_age = (this->infector == NULL ? -1 : this->infector->get_real_age());
+    r.infector_symptomatic = (this->infector == NULL ? -1 : this->infector->is_symptomatic());
+    r.infector_sick_leave = (this->infector == NULL ? -1 : this->infector->is_sick_leave_available());
+    r.mixing_group_type = mixing_group_type;
+    r.mixing_group = mixing_group_id;
+    r.mixing_group_subtype = mixing_group_subtype;
+    r.mixing_group_size = mixing_group_size;
+    r.is_teacher = this->host->is_teacher();
+
     if(dynamic_cast<Place*>(this->mixing_group) != NULL) {
       Place* place = dynamic_cast<Place*>(this->mixing_group);
+      r.has_place = 1;
       if(mixing_group_type != 'X') {
-        fred::geo lat = place->get_latitude();
-        fred::geo lon = place->get_longitude();
-        infStrS << " lat " << lat;
-        infStrS << " lon " << lon;
-      } else {
-        infStrS << " lat " << -999;
-        infStrS << " lon " << -999;
+        r.has_place_location = 1;
+        r.place_latitude = place->get_latitude();
+        r.place_longitude = place->get_longitude();
       }
-      double host_lat = this->host->get_household()->get_latitude();
-      double host_lon = this->host->get_household()->get_longitude();
-      infStrS << " home_lat " << host_lat;
-      infStrS << " home_lon " << host_lon;
-      infStrS << " | ";
+      r.home_latitude = this->host->get_household()->get_latitude();
+      r.home_longitude = this->host->get_household()->get_longitude();
     }
   }
 
@@ -306,16 +308,13 @@ void Infection::report_infection(int day) {
       double host_y = this->host->get_y();
       double infector_x = this->infector->get_x();
       double infector_y = this->infector->get_y();
-      double distance = sqrt((host_x - infector_x) * (host_x - infector_x) + (host_y - infector_y) * (host_y - infector_y));
-      infStrS << " dist " << distance;
-    } else {
-      infStrS << " dist -1 ";
+      r.has_distance = 1;
+      r.distance = sqrt((host_x - infector_x) * (host_x - infector_x) + (host_y - infector_y) * (host_y - infector_y));
     }
     //Add Census Tract information. If there was no infector, censustract is -1
-    if(this->infector == NULL) {
-      infStrS << " infctr_census_tract -1";
-      infStrS << " host_census_tract -1";
-    } else {
+    r.infector_census_tract = -1;
+    r.host_census_tract = -1;
+    if(this->infector != NULL) {
       Household* hh = static_cast<Household*>(this->infector->get_household());
       if(hh == NULL) {
         if(Global::Enable_Hospitals && this->infector->is_hospitalized() && this->infector->get_permanent_household() != NULL) {
@@ -323,8 +322,7 @@ void Infection::report_infection(int day) {
         }
       }
       int census_tract_index = (hh == NULL ? -1 : hh->get_census_tract_index());
-      long int census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
-      infStrS << " infctr_census_tract " << census_tract;
+      r.infector_census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
 
       hh = static_cast<Household*>(this->host->get_household());
       if(hh == NULL) {
@@ -333,25 +331,19 @@ void Infection::report_infection(int day) {
         }
       }
       census_tract_index = (hh == NULL ? -1 : hh->get_census_tract_index());
-      census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
-      infStrS << " host_census_tract " << census_tract;
+      r.host_census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
     }
-    infStrS << " | ";
   }
   if(Global::Track_infection_events > 3){
     Neighborhood_Patch* pt = this->host->get_household()->get_patch();
     if(pt != NULL){
-      double patch_lat = Geo::get_latitude(pt->get_center_y());
-      double patch_lon = Geo::get_longitude(pt->get_center_x());
-      int patch_pop = pt->get_popsize();
-      infStrS << " patch_lat " << patch_lat;
-      infStrS << " patch_lon " << patch_lon;
-      infStrS << " patch_pop " << patch_pop;
-      infStrS << " | ";
+      r.has_patch = 1;
+      r.patch_latitude = Geo::get_latitude(pt->get_center_y());
+      r.patch_longitude = Geo::get_longitude(pt->get_center_x());
+      r.patch_population = pt->get_popsize();
     }
   }
-  infStrS << "\n";
-  fprintf(Global::Infectionfp, "%s", infStrS.str().c_str());
+  Infection_Log::write(r);
 }
 
 void Infection::update(int today) {
@@ -0,0 +1,178 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Infection_Log.cc
+//
+
+#include <string.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Infection_Log.h"
+#include "Disease.h"
+#include "Disease_List.h"
+#include "Global.h"
+#include "Params.h"
+#include "Utils.h"
+
+bool Infection_Log::Binary = false;
+
+namespace {
+
+  // records per batch handed to the writer
+  const size_t Batch_records = 4096;
+
+  typedef std::vector<Infection_Record> batch_t;
+
+  std::vector<batch_t*> Thread_buffers;
+
+  // shared with the writer thread, guarded by Mutex
+  std::mutex Mutex;
+  std::condition_variable Work_ready;
+  std::deque<batch_t*> Queue;
+  std::vector<batch_t*> Free;
+  bool Stopping = false;
+
+  std::thread Writer_thread;
+  bool Writer_running = false;
+
+  batch_t* new_batch() {
+    batch_t* batch = new batch_t;
+    batch->reserve(Batch_records);
+    return batch;
+  }
+
+}
+
+void Infection_Log::get_parameters() {
+  char format[FRED_STRING_SIZE];
+  strcpy(format, "text");
+  Params::get_param_from_string("infection_log_format", format);
+  if(strcmp(format, "text") == 0) {
+    Infection_Log::Binary = false;
+  } else if(strcmp(format, "binary") == 0) {
+    Infection_Log::Binary = true;
+  } else {
+    Utils::fred_abort("Unknown infection_log_format %s (use text or binary)\n", format);
+  }
+  if(Infection_Log::Binary && Thread_buffers.empty()) {
+    for(int t = 0; t < fred::omp_get_max_threads(); ++t) {
+      Thread_buffers.push_back(new_batch());
+    }
+  }
+}
+
+void Infection_Log::write_header() {
+  Infection_Log_Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, INFECTION_LOG_MAGIC, sizeof(header.magic));
+  header.version = INFECTION_LOG_VERSION;
+  header.level = Global::Track_infection_events;
+  header.record_size = sizeof(Infection_Record);
+  header.diseases = Global::Diseases.get_number_of_diseases();
+  fwrite(&header, sizeof(header), 1, Global::Infectionfp);
+  for(int d = 0; d < header.diseases; ++d) {
+    Infection_Log_Name name;
+    memset(&name, 0, sizeof(name));
+    strncpy(name.name, Global::Diseases.get_disease(d)->get_disease_name(), sizeof(name.name) - 1);
+    fwrite(&name, sizeof(name), 1, Global::Infectionfp);
+  }
+}
+
+void Infection_Log::write(const Infection_Record &record) {
+  if(!Infection_Log::Binary) {
+    std::string line;
+    format_infection_record(record, Global::Track_infection_events,
+                            Global::Diseases.get_disease(record.disease)->get_disease_name(), line);
+    fputs(line.c_str(), Global::Infectionfp);
+    return;
+  }
+  int t = fred::omp_get_thread_num();
+  Thread_buffers[t]->push_back(record);
+  if(Thread_buffers[t]->size() >= Batch_records) {
+    hand_off(t);
+  }
+}
+
+void Infection_Log::hand_off(int thread) {
+  std::lock_guard<std::mutex> lock(Mutex);
+  if(!Writer_running) {
+    Stopping = false;
+    Writer_thread = std::thread(Infection_Log::writer);
+    Writer_running = true;
+  }
+  Queue.push_back(Thread_buffers[thread]);
+  if(Free.empty()) {
+    Thread_buffers[thread] = new_batch();
+  } else {
+    Thread_buffers[thread] = Free.back();
+    Free.pop_back();
+  }
+  Work_ready.notify_one();
+}
+
+void Infection_Log::writer() {
+  std::unique_lock<std::mutex> lock(Mutex);
+  while(true) {
+    while(Queue.empty() && !Stopping) {
+      Work_ready.wait(lock);
+    }
+    if(Queue.empty()) {
+      break;
+    }
+    batch_t* batch = Queue.front();
+    Queue.pop_front();
+    bool last = Queue.empty();
+    lock.unlock();
+    fwrite(batch->data(), sizeof(Infection_Record), batch->size(), Global::Infectionfp);
+    if(last) {
+      fflush(Global::Infectionfp);
+    }
+    batch->clear();
+    lock.lock();
+    Free.push_back(batch);
+  }
+}
+
+void Infection_Log::flush() {
+  if(Global::Infectionfp == NULL) {
+    return;
+  }
+  if(!Infection_Log::Binary) {
+    fflush(Global::Infectionfp);
+    return;
+  }
+  // called from serial code, so no thread is appending to its buffer
+  for(int t = 0; t < (int) Thread_buffers.size(); ++t) {
+    if(!Thread_buffers[t]->empty()) {
+      hand_off(t);
+    }
+  }
+}
+
+void Infection_Log::finish() {
+  flush();
+  if(!Writer_running) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(Mutex);
+    Stopping = true;
+    Work_ready.notify_one();
+  }
+  Writer_thread.join();
+  Writer_running = false;
+  fflush(Global::Infectionfp);
+}
@@ -0,0 +1,81 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Infection_Log.h
+//
+// The infection event log (track_infection_events > 0).  Each new
+// infection is captured as a fixed-size Infection_Record.  With
+// infection_log_format = text the record is formatted at once and written
+// to infections<run>.txt, as FRED always has.  With infection_log_format =
+// binary the records go to infections<run>.bin: each thread appends to its
+// own buffer, and full buffers (and all buffers at the end of each day)
+// are handed to a writer thread that writes them unformatted, a batch at
+// a time.  fred_infections_dump turns a .bin file back into the text
+// format, with the same format_infection_record used here.
+//
+// In a .bin file (see Infection_Log_Format.h) the records of one thread
+// keep their order; records from different threads are interleaved by
+// batch.
+//
+
+#ifndef _FRED_INFECTION_LOG_H
+#define _FRED_INFECTION_LOG_H
+
+#include <stdio.h>
+#include <vector>
+
+#include "Infection_Log_Format.h"
+
+class Infection_Log {
+public:
+  static void get_parameters();
+
+  static bool is_binary() {
+    return Infection_Log::Binary;
+  }
+
+  static const char* get_file_suffix() {
+    return Infection_Log::Binary ? ".bin" : ".txt";
+  }
+
+  /**
+   * Write the .bin header to the newly opened Global::Infectionfp.
+   */
+  static void write_header();
+
+  /**
+   * Log one infection to Global::Infectionfp.  Thread safe in binary mode.
+   */
+  static void write(const Infection_Record &record);
+
+  /**
+   * Pass everything logged so far on to the file (called once a day from
+   * serial code).
+   */
+  static void flush();
+
+  /**
+   * Flush and wait until the writer thread has written everything and
+   * exited, so that the file is complete (before the process forks or
+   * closes the file).  The writer restarts on the next flush.
+   */
+  static void finish();
+
+private:
+  static void hand_off(int thread);
+  static void writer();
+
+  static bool Binary;
+};
+
+#endif // _FRED_INFECTION_LOG_H
@@ -0,0 +1,78 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Infection_Log_Format.cc
+//
+// The text form of an infection record.
+//
+
+#include <sstream>
+
+#include "Infection_Log_Format.h"
+
+void format_infection_record(const Infection_Record &r, int level, const char* disease_name, std::string &out) {
+  std::stringstream infStrS;
+  infStrS.precision(3);
+  infStrS << std::fixed << "day " << r.day << " dis " << disease_name << " host " << r.host
+          << " age " << r.host_age
+          << " | DATES exp " << r.exposure_date
+          << " inf " << r.infectious_start_date << " " << r.infectious_end_date
+          << " symp " << r.symptoms_start_date << " " << r.symptoms_end_date
+          << " rec " << r.infectious_end_date << " sus " << r.immunity_end_date
+          << " infector_exp_date " << r.infector_exposure_date
+          << " | ";
+
+  if(level > 1) {
+    infStrS << " sick_leave " << static_cast<int>(r.sick_leave)
+            << " infector " << r.infector << " inf_age "
+            << r.infector_age << " inf_sympt "
+            << static_cast<int>(r.infector_symptomatic) << " inf_sick_leave "
+            << static_cast<int>(r.infector_sick_leave)
+            << " at " << r.mixing_group_type << " mixing_group " << r.mixing_group << " subtype " << r.mixing_group_subtype;
+    infStrS << " size " << r.mixing_group_size << " is_teacher " << static_cast<int>(r.is_teacher);
+
+    if(r.has_place) {
+      if(r.has_place_location) {
+        infStrS << " lat " << r.place_latitude;
+        infStrS << " lon " << r.place_longitude;
+      } else {
+        infStrS << " lat " << -999;
+        infStrS << " lon " << -999;
+      }
+      infStrS << " home_lat " << r.home_latitude;
+      infStrS << " home_lon " << r.home_longitude;
+      infStrS << " | ";
+    }
+  }
+
+  if(level > 2) {
+    if(r.has_distance) {
+      infStrS << " dist " << r.distance;
+    } else {
+      infStrS << " dist -1 ";
+    }
+    infStrS << " infctr_census_tract " << static_cast<long int>(r.infector_census_tract);
+    infStrS << " host_census_tract " << static_cast<long int>(r.host_census_tract);
+    infStrS << " | ";
+  }
+  if(level > 3) {
+    if(r.has_patch) {
+      infStrS << " patch_lat " << r.patch_latitude;
+      infStrS << " patch_lon " << r.patch_longitude;
+      infStrS << " patch_pop " << r.patch_population;
+      infStrS << " | ";
+    }
+  }
+  infStrS << "\n";
+  out += infStrS.str();
+}
@@ -0,0 +1,92 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Infection_Log_Format.h
+//
+// The record of one infection and the layout of an infections<run>.bin
+// file: an Infection_Log_Header, the names of the diseases (one
+// Infection_Log_Name each), then Infection_Records to the end of the
+// file.  Kept apart from Infection_Log so that fred_infections_dump can
+// be built from Infection_Log_Format.cc alone.
+//
+
+#ifndef _FRED_INFECTION_LOG_FORMAT_H
+#define _FRED_INFECTION_LOG_FORMAT_H
+
+#include <stdint.h>
+#include <string>
+
+#define INFECTION_LOG_MAGIC "FREDINFL"
+#define INFECTION_LOG_VERSION 1
+
+struct Infection_Log_Header {
+  char magic[8];
+  int32_t version;
+  int32_t level;          // track_infection_events
+  int32_t record_size;    // sizeof(Infection_Record)
+  int32_t diseases;       // number of Infection_Log_Names that follow
+};
+
+struct Infection_Log_Name {
+  char name[32];
+};
+
+struct Infection_Record {
+  int32_t day;
+  int32_t disease;
+  int32_t host;
+  int32_t exposure_date;
+  int32_t infectious_start_date;
+  int32_t infectious_end_date;
+  int32_t symptoms_start_date;
+  int32_t symptoms_end_date;
+  int32_t immunity_end_date;
+  int32_t infector_exposure_date;
+  double host_age;
+
+  // track_infection_events > 1
+  int32_t infector;
+  int32_t mixing_group;
+  int32_t mixing_group_size;
+  int8_t sick_leave;
+  int8_t infector_symptomatic;
+  int8_t infector_sick_leave;
+  int8_t is_teacher;
+  char mixing_group_type;
+  char mixing_group_subtype;
+  int8_t has_place;           // the mixing group is a Place
+  int8_t has_place_location;  // ... and its type is not 'X'
+  double infector_age;
+  double place_latitude;
+  double place_longitude;
+  double home_latitude;
+  double home_longitude;
+
+  // track_infection_events > 2
+  int8_t has_distance;
+  int8_t has_patch;           // track_infection_events > 3
+  int32_t patch_population;
+  double distance;
+  int64_t infector_census_tract;
+  int64_t host_census_tract;
+  double patch_latitude;
+  double patch_longitude;
+};
+
+/**
+ * Append the text form of record to out, exactly as FRED writes it to
+ * infections<run>.txt for the given track_infection_events level.
+ */
+void format_infection_record(const Infection_Record &record, int level, const char* disease_name, std::string &out);
+
+#endif // _FRED_INFECTION_LOG_FORMAT_H
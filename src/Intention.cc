@@ -30,8 +30,7 @@ Intention::Intention(Person * _self, int _index) {
   this->perceptions = NULL;
 
   // pick a behavior_change_model for this individual based on the population market shares
-  this->behavior_change_model = Random::draw_from_distribution(this->params->behavior_change_model_cdf_size,
-							       this->params->behavior_change_model_cdf);
+  this->behavior_change_model = this->params->behavior_change_model_table.draw();
 
   // set the other intention parameters based on the behavior_change_model
   switch(this->behavior_change_model) {
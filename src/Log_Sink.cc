@@ -0,0 +1,225 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Log_Sink.cc
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Log_Sink.h"
+#include "Global.h"
+#include "Params.h"
+
+bool Log_Sink::Enabled = false;
+
+namespace {
+
+  // bytes in each thread's ring (a power of 2)
+  const size_t Ring_size = 1 << 20;
+
+  // a ring is written only by its thread (head) and read only by the
+  // holder of Drain_mutex (tail)
+  struct Ring {
+    char* data;
+    std::atomic<size_t> head;
+    char padding[64];
+    std::atomic<size_t> tail;
+  };
+
+  // each message in a ring is a Message_Header followed by its text
+  struct Message_Header {
+    FILE* fp;
+    size_t length;
+  };
+
+  std::vector<Ring*> Rings;
+
+  std::mutex Drain_mutex;
+
+  // shared with the writer thread, guarded by Mutex
+  std::mutex Mutex;
+  std::condition_variable Wake;
+  bool Stopping = false;
+
+  std::thread Writer_thread;
+  std::atomic<bool> Writer_running(false);
+
+  void copy_in(Ring* ring, size_t pos, const void* src, size_t n) {
+    size_t i = pos & (Ring_size - 1);
+    size_t first = (n < Ring_size - i ? n : Ring_size - i);
+    memcpy(ring->data + i, src, first);
+    memcpy(ring->data, static_cast<const char*>(src) + first, n - first);
+  }
+
+  void copy_out(Ring* ring, size_t pos, void* dst, size_t n) {
+    size_t i = pos & (Ring_size - 1);
+    size_t first = (n < Ring_size - i ? n : Ring_size - i);
+    memcpy(dst, ring->data + i, first);
+    memcpy(static_cast<char*>(dst) + first, ring->data, n - first);
+  }
+
+  void write_out(Ring* ring, size_t pos, size_t n, FILE* fp) {
+    size_t i = pos & (Ring_size - 1);
+    size_t first = (n < Ring_size - i ? n : Ring_size - i);
+    fwrite(ring->data + i, 1, first, fp);
+    fwrite(ring->data, 1, n - first, fp);
+  }
+
+}
+
+void Log_Sink::get_parameters() {
+  int temp_int = 0;
+  Params::get_param_from_string("enable_async_log", &temp_int);
+  Log_Sink::Enabled = (temp_int == 0 ? false : true);
+  if(Log_Sink::Enabled && Rings.empty()) {
+    for(int t = 0; t < fred::omp_get_max_threads(); ++t) {
+      Ring* ring = new Ring;
+      ring->data = new char[Ring_size];
+      ring->head = 0;
+      ring->tail = 0;
+      Rings.push_back(ring);
+    }
+    atexit(Log_Sink::finish);
+  }
+}
+
+void Log_Sink::write(FILE* fp, const char* format, va_list ap) {
+  char line[1024];
+  std::string long_line;
+  const char* text = line;
+  va_list aq;
+  va_copy(aq, ap);
+  int n = vsnprintf(line, sizeof(line), format, ap);
+  if(n >= static_cast<int>(sizeof(line))) {
+    long_line.resize(n + 1);
+    vsnprintf(&long_line[0], n + 1, format, aq);
+    text = long_line.c_str();
+  }
+  va_end(aq);
+  if(n <= 0) {
+    return;
+  }
+
+  if(!Writer_running.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(Mutex);
+    if(!Writer_running.load(std::memory_order_relaxed)) {
+      Stopping = false;
+      Writer_thread = std::thread(Log_Sink::writer);
+      Writer_running.store(true, std::memory_order_release);
+    }
+  }
+
+  Ring* ring = Rings[fred::omp_get_thread_num()];
+  Message_Header header = { fp, static_cast<size_t>(n) };
+  size_t size = sizeof(header) + header.length;
+  if(size > Ring_size) {
+    // too long for the ring: write it here, after what the ring holds
+    flush();
+    std::lock_guard<std::mutex> lock(Drain_mutex);
+    fwrite(text, 1, header.length, fp);
+    fflush(fp);
+    return;
+  }
+  size_t head = ring->head.load(std::memory_order_relaxed);
+  while(Ring_size - (head - ring->tail.load(std::memory_order_acquire)) < size) {
+    Wake.notify_one();
+    std::this_thread::yield();
+  }
+  copy_in(ring, head, &header, sizeof(header));
+  copy_in(ring, head + sizeof(header), text, header.length);
+  ring->head.store(head + size, std::memory_order_release);
+  if(head + size - ring->tail.load(std::memory_order_relaxed) > Ring_size / 2) {
+    Wake.notify_one();
+  }
+}
+
+bool Log_Sink::drain() {
+  // called with Drain_mutex held
+  bool wrote = false;
+  FILE* touched[2] = { NULL, NULL };
+  for(int t = 0; t < static_cast<int>(Rings.size()); ++t) {
+    Ring* ring = Rings[t];
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    size_t head = ring->head.load(std::memory_order_acquire);
+    while(tail != head) {
+      Message_Header header;
+      copy_out(ring, tail, &header, sizeof(header));
+      write_out(ring, tail + sizeof(header), header.length, header.fp);
+      tail += sizeof(header) + header.length;
+      ring->tail.store(tail, std::memory_order_release);
+      if(header.fp != touched[0] && header.fp != touched[1]) {
+        if(touched[0] == NULL) {
+          touched[0] = header.fp;
+        } else if(touched[1] == NULL) {
+          touched[1] = header.fp;
+        } else {
+          fflush(header.fp);
+        }
+      }
+      wrote = true;
+    }
+  }
+  for(int i = 0; i < 2; ++i) {
+    if(touched[i] != NULL) {
+      fflush(touched[i]);
+    }
+  }
+  return wrote;
+}
+
+void Log_Sink::writer() {
+  std::unique_lock<std::mutex> lock(Mutex);
+  while(!Stopping) {
+    lock.unlock();
+    bool wrote = false;
+    {
+      std::lock_guard<std::mutex> drain_lock(Drain_mutex);
+      wrote = drain();
+    }
+    lock.lock();
+    if(!wrote && !Stopping) {
+      Wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+}
+
+void Log_Sink::flush() {
+  if(Rings.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(Drain_mutex);
+  drain();
+}
+
+void Log_Sink::finish() {
+  flush();
+  if(!Writer_running.load(std::memory_order_acquire)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(Mutex);
+    Stopping = true;
+    Wake.notify_one();
+  }
+  Writer_thread.join();
+  Writer_running.store(false, std::memory_order_release);
+  flush();
+}
@@ -0,0 +1,64 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Log_Sink.h
+//
+// The asynchronous sink for FRED_VERBOSE and FRED_STATUS messages
+// (enable_async_log = 1).  Each thread formats its messages into its own
+// ring buffer, without locks or system calls, and a writer thread copies
+// the rings to stdout or Global::Statusfp.  Everything logged is written
+// by the end of each day (flush), before fred_abort reports an error, and
+// before the process forks or exits (finish).
+//
+// The messages of one thread keep their order, but within a day they may
+// come out after output that FRED writes to stdout directly.
+//
+
+#ifndef _FRED_LOG_SINK_H
+#define _FRED_LOG_SINK_H
+
+#include <stdarg.h>
+#include <stdio.h>
+
+class Log_Sink {
+public:
+  static void get_parameters();
+
+  static bool is_enabled() {
+    return Log_Sink::Enabled;
+  }
+
+  /**
+   * Queue one formatted message for fp.  Thread safe.
+   */
+  static void write(FILE* fp, const char* format, va_list ap);
+
+  /**
+   * Write out everything logged so far.  Thread safe.
+   */
+  static void flush();
+
+  /**
+   * Flush and stop the writer thread (before the process forks or exits).
+   * The writer restarts with the next message.
+   */
+  static void finish();
+
+private:
+  static void writer();
+  static bool drain();
+
+  static bool Enabled;
+};
+
+#endif // _FRED_LOG_SINK_H
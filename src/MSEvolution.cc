@@ -27,6 +27,7 @@ MSEvolution::MSEvolution() {
   this->sat_quantity = 0.0;
   this->protection = NULL;
   this->prob_inoc_norm = 0.0;
+  this->strain_matrix = new Strain_Matrix(16);
 }
 
 void MSEvolution::setup( Disease * disease ) {
@@ -52,6 +53,10 @@ MSEvolution::~MSEvolution() {
   delete this->halflife_inf;
   delete this->halflife_vac;
   delete this->protection;
+  delete this->strain_matrix.load();
+  for(int i = 0; i < static_cast<int>(this->retired_strain_matrices.size()); ++i) {
+    delete this->retired_strain_matrices[i];
+  }
 }
 
 inline double MSEvolution::residual_immunity(Person* person, int challenge_strain, int day)  {
@@ -96,8 +101,7 @@ double MSEvolution::prob_blocking(int old_strain, int new_strain, int time, doub
   // Generalized Immunity
   prob_block *= (1 - (init_prot * exp((0 - time) / (halflife / 0.693))));
   // Strain Dependent Immunity 
-  double ad = antigenic_distance( old_strain, new_strain);
-  prob_block *= (1 - this->protection->get_prob(ad));
+  prob_block *= get_strain_factor(old_strain, new_strain);
   // Make sure that it's a valid probability 
   assert(prob_block >= 0.0 && prob_block <= 1.0);
   return (1 - prob_block);
@@ -107,15 +111,67 @@ double MSEvolution::prob_past_infections(Person* infectee, int new_strain, int d
   int disease_id = this->disease->get_id();
   double probTaking = 1.0;
   int n = infectee->get_num_past_infections(disease_id);
+  if(n == 0) {
+    return probTaking;
+  }
+  // repeated challenges on the same day do not walk the history again
+  Health* health = infectee->get_health();
+  if(health->get_cached_prob_taking(disease_id, new_strain, day, &probTaking)) {
+    return probTaking;
+  }
   for(int i = 0; i < n; ++i) {
     Past_Infection * past_infection = infectee->get_past_infection(disease_id, i);
     //printf("DATES: %d %d\n", day, pastInf->get_infectious_end_date()); 
     probTaking *= (1 - prob_inf_blocking(past_infection->get_strain(), new_strain,
 					   day - past_infection->get_infectious_end_date(), past_infection->get_age_at_exposure()));
   }
+  health->set_cached_prob_taking(disease_id, new_strain, day, probTaking);
   return probTaking;
 }
 
+double MSEvolution::get_strain_factor(int old_strain, int new_strain) {
+  Strain_Matrix* matrix = this->strain_matrix.load(std::memory_order_acquire);
+  int strains = (old_strain > new_strain ? old_strain : new_strain) + 1;
+  if(matrix->size.load(std::memory_order_acquire) < strains) {
+    matrix = add_strains(strains);
+  }
+  return matrix->factor[old_strain * matrix->capacity + new_strain];
+}
+
+MSEvolution::Strain_Matrix* MSEvolution::add_strains(int strains) {
+  fred::Spin_Lock lock(this->strain_mutex);
+  Strain_Matrix* matrix = this->strain_matrix.load(std::memory_order_relaxed);
+  int size = matrix->size.load(std::memory_order_relaxed);
+  if(strains <= size) {
+    return matrix;
+  }
+  if(matrix->capacity < strains) {
+    int capacity = 2 * matrix->capacity;
+    while(capacity < strains) {
+      capacity *= 2;
+    }
+    Strain_Matrix* larger = new Strain_Matrix(capacity);
+    for(int i = 0; i < size; ++i) {
+      for(int j = 0; j < size; ++j) {
+	larger->factor[i * capacity + j] = matrix->factor[i * matrix->capacity + j];
+      }
+    }
+    this->retired_strain_matrices.push_back(matrix);
+    matrix = larger;
+  }
+  // readers only look at pairs of strains below size, so the new rows and
+  // columns can be filled in place
+  for(int i = 0; i < strains; ++i) {
+    for(int j = (i < size ? size : 0); j < strains; ++j) {
+      double ad = antigenic_distance(i, j);
+      matrix->factor[i * matrix->capacity + j] = 1 - this->protection->get_prob(ad);
+    }
+  }
+  matrix->size.store(strains, std::memory_order_release);
+  this->strain_matrix.store(matrix, std::memory_order_release);
+  return matrix;
+}
+
 double MSEvolution::prob_past_vaccinations(Person* infectee, int new_strain, int day) {
   double probTaking = 1.0;
   // TODO Handle getting past vaccinations through person instead of infection
@@ -12,7 +12,11 @@
 #ifndef _FRED_MSEVOLUTION_H
 #define _FRED_MSEVOLUTION_H
 
+#include <atomic>
+#include <vector>
+
 #include "Evolution.h"
+#include "Global.h"
 
 class Age_Map;
 class Disease;
@@ -38,6 +42,24 @@ protected:
   virtual double prob_inoc(double quantity);
 
 private:
+  // 1 - protection(antigenic distance) for each pair of strains seen so
+  // far, grown as new strains are challenged or remembered.  Entries are
+  // only added, so readers need no lock; a matrix that outgrows its
+  // capacity is copied and the old one kept until the end of the run.
+  struct Strain_Matrix {
+    Strain_Matrix(int _capacity) : capacity(_capacity), size(0), factor(_capacity * _capacity, 1.0) {}
+    int capacity;
+    std::atomic<int> size;
+    std::vector<double> factor;
+  };
+
+  double get_strain_factor(int old_strain, int new_strain);
+  Strain_Matrix* add_strains(int strains);
+
+  std::atomic<Strain_Matrix*> strain_matrix;
+  std::vector<Strain_Matrix*> retired_strain_matrices;
+  fred::Spin_Mutex strain_mutex;
+
   Age_Map* halflife_inf;
   Age_Map* halflife_vac;
   double prob_inoc_norm;
@@ -66,14 +66,37 @@ void Markov_Epidemic::prepare() {
   // initialize the population
   int day = 0;
   int popsize = Global::Pop.get_pop_size();
-  for(int p = 0; p < Global::Pop.get_index_size(); ++p) {
-    Person* person = Global::Pop.get_person_by_index(p);
-    if(person == NULL) {
-      continue;
+  if(Global::Enable_Markov_Transition_Tables) {
+    // draw the initial states in parallel, each person from a stream keyed
+    // by disease and person id, then enter them in population order
+    int index_size = Global::Pop.get_index_size();
+    std::vector<int> initial_state(index_size, -1);
+#pragma omp parallel for schedule(static)
+    for(int p = 0; p < index_size; ++p) {
+      Person* person = Global::Pop.get_person_by_index(p);
+      if(person == NULL) {
+        continue;
+      }
+      Random::begin_initial_state_stream(this->id, person->get_id());
+      initial_state[p] = this->markov_model->get_initial_state(person->get_real_age());
+      Random::end_stream();
+    }
+    for(int p = 0; p < index_size; ++p) {
+      Person* person = Global::Pop.get_person_by_index(p);
+      if(person != NULL) {
+        transition_person(person, day, initial_state[p]);
+      }
+    }
+  } else {
+    for(int p = 0; p < Global::Pop.get_index_size(); ++p) {
+      Person* person = Global::Pop.get_person_by_index(p);
+      if(person == NULL) {
+        continue;
+      }
+      double age = person->get_real_age();
+      int state = this->markov_model->get_initial_state(age);
+      transition_person(person, day, state);
     }
-    double age = person->get_real_age();
-    int state = this->markov_model->get_initial_state(age);
-    transition_person(person, day, state);
   }
 
   FRED_VERBOSE(0, "Markov_Epidemic(%s)::prepare: state/size: \n", this->disease->get_disease_name());
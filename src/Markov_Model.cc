@@ -103,6 +103,34 @@ void Markov_Model::get_parameters() {
       this->transition_matrix[group][i][i] = 1.0 - sum;
     }
   }
+
+  compile_transitions();
+}
+
+
+void Markov_Model::compile_transitions() {
+  this->exit_table = new Exit_Table* [this->age_groups];
+  for (int group = 0; group < this->age_groups; group++) {
+    this->exit_table[group] = new Exit_Table [this->number_of_states];
+    for (int i = 0; i < this->number_of_states; i++) {
+      Exit_Table & table = this->exit_table[group][i];
+      table.rate = 0.0;
+      std::vector<double> cdf;
+      for (int j = 0; j < this->number_of_states; j++) {
+	double lambda = this->transition_matrix[group][i][j];
+	if (j == i || lambda == 0.0) {
+	  continue;
+	}
+	table.rate += lambda;
+	table.next_state.push_back(j);
+	cdf.push_back(table.rate);
+      }
+      for (int k = 0; k < (int) cdf.size(); k++) {
+	cdf[k] /= table.rate;
+      }
+      table.next_state_table.set_cdf(cdf);
+    }
+  }
 }
 
 
@@ -147,6 +175,22 @@ void Markov_Model::get_next_state_and_time(int day, double age, int old_state, i
   *transition_day = -1;
   *new_state = old_state;
   int group = this->age_map->find_value(age);
+  if (Global::Enable_Markov_Transition_Tables) {
+    // the first of the competing exponential transitions leaves after an
+    // exponential time at the total rate, for a state picked in
+    // proportion to its rate
+    Exit_Table & table = this->exit_table[group][old_state];
+    if (table.rate == 0.0) {
+      return;
+    }
+    *transition_day = day + 1 + round(Random::draw_exponential(table.rate) * this->period_in_transition_probabilities);
+    if (table.next_state.size() == 1) {
+      *new_state = table.next_state[0];
+    } else {
+      *new_state = table.next_state[table.next_state_table.draw()];
+    }
+    return;
+  }
   for (int j = 0; j < this->number_of_states; j++) {
     if (j == old_state) {
       continue;
@@ -13,8 +13,11 @@
 #define _FRED_MARKOV_MODEL_H
 
 #include <string>
+#include <vector>
 using namespace std;
 
+#include "Random.h"
+
 class Age_Map;
 
 
@@ -57,11 +60,23 @@ protected:
   std::vector<std::string>state_name;
 
 private:
+  void compile_transitions();
+
   Age_Map* age_map;
   int age_groups;
   double** state_initial_percent;
   double*** transition_matrix;
   int period_in_transition_probabilities;
+
+  // transition_matrix compiled for enable_markov_transition_tables: for
+  // each age group and state, the total rate of leaving the state and a
+  // table that picks the next state in proportion to its rate
+  struct Exit_Table {
+    double rate;
+    std::vector<int> next_state;
+    Alias_Table next_state_table;
+  };
+  Exit_Table** exit_table;
 };
 
 #endif
@@ -87,14 +87,6 @@ void Natural_History::setup(Disease * _disease) {
   strcpy(infectious_distributions, "none");
   this->symptoms_distribution_type = 0;
   this->infectious_distribution_type = 0;
-  this->max_days_incubating = 0;
-  this->max_days_symptomatic = 0;
-  this->days_incubating = NULL;
-  this->days_symptomatic = NULL;
-  this->max_days_latent = 0;
-  this->max_days_infectious = 0;
-  this->days_latent = NULL;
-  this->days_infectious = NULL;
   this->age_specific_prob_symptoms = NULL;
   this->immunity_loss_rate = 0;
   this->incubation_period_median = 0;
@@ -127,13 +119,22 @@ void Natural_History::setup(Disease * _disease) {
   FRED_VERBOSE(0, "Natural_History::setup finished\n");
 }
 
+// read the indexed cdf param name into table
+static void read_cdf(char* disease_name, const char* name, Alias_Table &table) {
+  int n;
+  Params::get_indexed_param(disease_name, name, &n);
+  double* cdf = new double [n];
+  int size = Params::get_indexed_param_vector(disease_name, name, cdf);
+  table.set_cdf(cdf, size);
+  delete[] cdf;
+}
+
 void Natural_History::get_parameters() {
 
   FRED_VERBOSE(0, "Natural_History::get_parameters\n");
   // read in the disease-specific parameters
   char paramstr[256];
   char disease_name[20];
-  int n;
 
   strcpy(disease_name, disease->get_disease_name());
 
@@ -161,13 +162,9 @@ void Natural_History::get_parameters() {
     this->symptoms_distribution_type = LOGNORMAL;
   }
   else if (strcmp(this->symptoms_distributions, "cdf")==0) {
-    Params::get_indexed_param(disease_name,"days_incubating",&n);
-    this->days_incubating = new double [n];
-    this->max_days_incubating = Params::get_indexed_param_vector(disease_name, "days_incubating", this->days_incubating) -1;
+    read_cdf(disease_name, "days_incubating", this->days_incubating);
     
-    Params::get_indexed_param(disease_name,"days_symptomatic",&n);
-    this->days_symptomatic = new double [n];
-    this->max_days_symptomatic = Params::get_indexed_param_vector(disease_name, "days_symptomatic", this->days_symptomatic) -1;
+    read_cdf(disease_name, "days_symptomatic", this->days_symptomatic);
     this->symptoms_distribution_type = CDF;
   }
   else {
@@ -206,13 +203,9 @@ void Natural_History::get_parameters() {
       this->infectious_distribution_type = LOGNORMAL;
     }
     else if (strcmp(this->infectious_distributions, "cdf")==0) {
-      Params::get_indexed_param(disease_name,"days_latent",&n);
-      this->days_latent = new double [n];
-      this->max_days_latent = Params::get_indexed_param_vector(disease_name, "days_latent", this->days_latent) -1;
+      read_cdf(disease_name, "days_latent", this->days_latent);
     
-      Params::get_indexed_param(disease_name,"days_infectious",&n);
-      this->days_infectious = new double [n];
-      this->max_days_infectious = Params::get_indexed_param_vector(disease_name, "days_infectious", this->days_infectious) -1;
+      read_cdf(disease_name, "days_infectious", this->days_infectious);
       this->infectious_distribution_type = CDF;
     }
     else {
@@ -288,19 +281,19 @@ double Natural_History::get_probability_of_symptoms(int age) {
 }
 
 int Natural_History::get_latent_period(Person* host) {
-  return Random::draw_from_distribution(max_days_latent, days_latent);
+  return this->days_latent.draw();
 }
 
 int Natural_History::get_incubation_period(Person* host) {
-  return Random::draw_from_distribution(max_days_incubating, days_incubating);
+  return this->days_incubating.draw();
 }
 
 int Natural_History::get_duration_of_infectiousness(Person* host) {
-  return Random::draw_from_distribution(max_days_infectious, days_infectious);
+  return this->days_infectious.draw();
 }
 
 int Natural_History::get_duration_of_symptoms(Person* host) {
-  return Random::draw_from_distribution(max_days_symptomatic, days_symptomatic);
+  return this->days_symptomatic.draw();
 }
 
 int Natural_History::get_duration_of_immunity(Person* host) {
@@ -15,6 +15,8 @@
 #include <string>
 using namespace std;
 
+#include "Random.h"
+
 class Age_Map;
 class Disease;
 class Evolution;
@@ -199,15 +201,10 @@ protected:
   int infectious_distribution_type;
 
   // CDFs
-  int max_days_incubating;
-  int max_days_symptomatic;
-  double* days_incubating;
-  double* days_symptomatic;
-
-  int max_days_latent;
-  int max_days_infectious;
-  double* days_latent;
-  double* days_infectious;
+  Alias_Table days_incubating;
+  Alias_Table days_symptomatic;
+  Alias_Table days_latent;
+  Alias_Table days_infectious;
 
   Age_Map* age_specific_prob_symptoms;
   double immunity_loss_rate;
@@ -355,9 +355,11 @@ void Neighborhood_Layer::setup_gravity_model() {
 
   offset = new offset_t * [ rows ];
   gravity_cdf = new gravity_cdf_t * [ rows ];
+  gravity_table = new Alias_Table * [ rows ];
   for(int i = 0; i < rows; i++) {
     offset[i] = new offset_t [ cols ];
     gravity_cdf[i] = new gravity_cdf_t [ cols ];
+    gravity_table[i] = new Alias_Table [ cols ];
   }
 
   if (max_distance < 0) {
@@ -447,6 +449,7 @@ void Neighborhood_Layer::setup_gravity_model() {
 	gravity_cdf[i][j].push_back(tmp_prob[k]);
 	offset[i][j].push_back(tmp_offset[k]);
       }
+      gravity_table[i][j].set_cdf(gravity_cdf[i][j]);
     }
   }  
   // this->print_gravity_model();
@@ -528,8 +531,10 @@ void Neighborhood_Layer::setup_null_gravity_model() {
 
   offset = new offset_t * [ rows ];
   gravity_cdf = new gravity_cdf_t * [ rows ];
+  gravity_table = new Alias_Table * [ rows ];
   offset[0] = new offset_t [ cols ];
   gravity_cdf[0] = new gravity_cdf_t [ cols ];
+  gravity_table[0] = new Alias_Table [ cols ];
 
   max_offset = rows * this->patch_size;
   assert(max_offset < 128);
@@ -570,6 +575,7 @@ void Neighborhood_Layer::setup_null_gravity_model() {
     gravity_cdf[0][0].push_back(tmp_prob[k]);
     offset[0][0].push_back(tmp_offset[k]);
   }
+  gravity_table[0][0].set_cdf(gravity_cdf[0][0]);
 }
 
 
@@ -592,7 +598,7 @@ Place * Neighborhood_Layer::select_destination_neighborhood_by_gravity_model(Pla
     // use null gravity model
     i_src = j_src = 0;
   }
-  int offset_index = Random::draw_from_cdf_vector( gravity_cdf[i_src][j_src] ) ;
+  int offset_index = gravity_table[i_src][j_src].draw();
   int off = offset[i_src][j_src][offset_index];
   int i_dest = i_src + max_offset - (off / 256);
   int j_dest = j_src + max_offset - (off % 256);
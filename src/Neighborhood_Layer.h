@@ -22,6 +22,7 @@ using namespace std;
 
 #include "Place.h"
 #include "Abstract_Grid.h"
+#include "Random.h"
 
 typedef std::vector<int> offset_t;
 typedef std::vector<double> gravity_cdf_t;
@@ -129,6 +130,7 @@ protected:
   // data used by neighborhood gravity model
   offset_t ** offset;
   gravity_cdf_t ** gravity_cdf;
+  Alias_Table ** gravity_table;		// draws from gravity_cdf
   int max_offset;
   vector < pair <double,int> >sort_pair;
 
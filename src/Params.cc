@@ -21,17 +21,88 @@
 #include <string>
 #include <sstream>
 #include <stdio.h>
+#include <unordered_map>
 
 using namespace std;
 
-char Params::param_name[MAX_PARAMS][MAX_PARAM_SIZE];
-char Params::param_value[MAX_PARAMS][MAX_PARAM_SIZE];
-int Params::param_count = 0;
 int Params::abort_on_failure = 1;
 
+namespace {
+
+  // sscanf has not been tried on the value yet
+  const int UNPARSED = -2;
+
+  struct Param_Entry {
+    string name;
+    string value;
+    string file;
+    bool used;
+    // sscanf result and value for the common types, parsed on first use
+    int int_status;
+    int int_value;
+    int double_status;
+    double double_value;
+  };
+
+  // every name = value read, in order, and for each name the entries
+  // with that name (the last one read wins)
+  vector<Param_Entry> Entries;
+  unordered_map<string, vector<int> > Entries_by_name;
+
+  void add_param(const char* name, const char* value, const char* file) {
+    Param_Entry entry;
+    entry.name = name;
+    entry.value = value;
+    entry.file = file;
+    entry.used = false;
+    entry.int_status = UNPARSED;
+    entry.int_value = 0;
+    entry.double_status = UNPARSED;
+    entry.double_value = 0.0;
+    Entries_by_name[entry.name].push_back(Entries.size());
+    Entries.push_back(entry);
+  }
+
+  // the entries named s, or NULL if there are none
+  const vector<int>* find_param(const char* s) {
+    unordered_map<string, vector<int> >::iterator found = Entries_by_name.find(s);
+    if(found == Entries_by_name.end()) {
+      return NULL;
+    }
+    for(int i = 0; i < found->second.size(); ++i) {
+      Entries[found->second[i]].used = true;
+    }
+    return &found->second;
+  }
+
+  // remove an end of line comment and trailing whitespace
+  void trim_value(char* value) {
+    string temp_str(value);
+    size_t pos;
+    string whitespaces(" \t\f\v\n\r");
+
+    pos = temp_str.find("#");
+    if(pos != string::npos) {
+      temp_str = temp_str.substr(0, pos);
+    }
+    //trim trailing whitespace
+    pos = temp_str.find_last_not_of(whitespaces);
+    if(pos != string::npos) {
+      if(pos != (temp_str.length() - 1)) {
+	temp_str.erase(pos + 1);
+      }
+    } else {
+      temp_str.clear(); //str is all whitespace
+    }
+    strcpy(value, temp_str.c_str());
+  }
+
+}
+
 void Params::read_psa_parameter(char* paramfile, int line_number) {
   FILE* fp;
   char name[MAX_PARAM_SIZE];
+  char value[MAX_PARAM_SIZE];
 
   fp = Utils::fred_open_file(paramfile);
   if(fp != NULL) {
@@ -49,31 +120,10 @@ void Params::read_psa_parameter(char* paramfile, int line_number) {
       current_line++;
     }
     if(fscanf(fp, "%s", name) == 1) {
-      if(fscanf(fp, " = %[^\n]", Params::param_value[Params::param_count]) == 1) {
-	//Remove end of line comments if they are there
-	string temp_str(Params::param_value[Params::param_count]);
-	size_t pos;
-	string whitespaces(" \t\f\v\n\r");
-
-	pos = temp_str.find("#");
-	if(pos != string::npos) {
-	  temp_str = temp_str.substr(0, pos);
-	}
-	//trim trailing whitespace
-	pos = temp_str.find_last_not_of(whitespaces);
-	if(pos != string::npos) {
-	  if(pos != (temp_str.length() - 1)) {
-	    temp_str.erase(pos + 1);
-	  }
-	} else {
-	  temp_str.clear(); //str is all whitespace
-	}
-	strcpy(Params::param_value[Params::param_count], temp_str.c_str());
-          
-	strcpy(Params::param_name[Params::param_count], name);
-	printf("READ_PSA_PARAMETER: %s = %s\n", Params::param_name[Params::param_count],
-	       Params::param_value[Params::param_count]);
-	Params::param_count++;
+      if(fscanf(fp, " = %[^\n]", value) == 1) {
+	trim_value(value);
+	add_param(name, value, paramfile);
+	printf("READ_PSA_PARAMETER: %s = %s\n", name, value);
       } else {
 	Utils::fred_abort("Bad format in params file %s on line starting with %s\n",
 			  paramfile, name);
@@ -94,6 +144,7 @@ void Params::read_psa_parameter(char* paramfile, int line_number) {
 void Params::read_parameter_file(char* paramfile) {
   FILE *fp;
   char name[MAX_PARAM_SIZE];
+  char value[MAX_PARAM_SIZE];
 
   fp = Utils::fred_open_file(paramfile);
   if(fp != NULL) {
@@ -111,34 +162,12 @@ void Params::read_parameter_file(char* paramfile) {
 	}
       } else {
 	// printf("PARAM NAME = |%s|\n",name);fflush(stdout);
-        if(fscanf(fp, " = %[^\n]", Params::param_value[Params::param_count]) == 1) {
-          
-          //Remove end of line comments if they are there
-          string temp_str(Params::param_value[Params::param_count]);
-          size_t pos;
-          string whitespaces(" \t\f\v\n\r");
-          
-          pos = temp_str.find("#");
-          if(pos != string::npos) {
-            temp_str = temp_str.substr(0, pos);
-          }
-          
-          //trim trailing whitespace
-          pos = temp_str.find_last_not_of(whitespaces);
-          if (pos != string::npos) {
-            if(pos != (temp_str.length() - 1))
-              temp_str.erase(pos + 1);
-          } else {
-            temp_str.clear(); //str is all whitespace
-          }
-          strcpy(Params::param_value[Params::param_count], temp_str.c_str());
-          
-          strcpy(Params::param_name[Params::param_count], name);
+        if(fscanf(fp, " = %[^\n]", value) == 1) {
+          trim_value(value);
+          add_param(name, value, paramfile);
           if(Global::Debug > 2) {
-            printf("READ_PARAMS: %s = %s\n", Params::param_name[Params::param_count],
-		   Params::param_value[Params::param_count]);
+            printf("READ_PARAMS: %s = %s\n", name, value);
           }
-          Params::param_count++;
         } else {
           Utils::fred_abort("Bad format in params file %s on line starting with %s\n",
 			    paramfile, name);
@@ -157,7 +186,8 @@ void Params::read_parameter_file(char* paramfile) {
 
 int Params::read_parameters(char* paramfile) {
   char filename[MAX_PARAM_SIZE];
-  Params::param_count = 0;
+  Entries.clear();
+  Entries_by_name.clear();
   
   strcpy(filename, "$FRED_HOME/input_files/defaults");
   read_parameter_file(filename);
@@ -183,20 +213,49 @@ int Params::read_parameters(char* paramfile) {
     }
   }
   if(Global::Debug > 1) {
-    for(int i = 0; i < Params::param_count; ++i) {
-      printf("READ_PARAMS: %s = %s\n", Params::param_name[i], Params::param_value[i]);
+    for(int i = 0; i < Entries.size(); ++i) {
+      printf("READ_PARAMS: %s = %s\n", Entries[i].name.c_str(), Entries[i].value.c_str());
+    }
+  }
+  return Entries.size();
+}
+
+void Params::report_parameter_use() {
+  // names given more than once in the same file
+  for(unordered_map<string, vector<int> >::iterator iter = Entries_by_name.begin();
+      iter != Entries_by_name.end(); ++iter) {
+    const vector<int> &entries = iter->second;
+    for(int i = 1; i < entries.size(); ++i) {
+      const Param_Entry &entry = Entries[entries[i]];
+      if(entry.file == Entries[entries[i - 1]].file) {
+	FRED_STATUS(0, "PARAMS: %s is set more than once in %s; %s = %s is used\n", entry.name.c_str(),
+		    entry.file.c_str(), entry.name.c_str(), Entries[entries.back()].value.c_str());
+	break;
+      }
+    }
+  }
+  // parameters set outside the defaults file that FRED never looked up
+  for(int i = 0; i < Entries.size(); ++i) {
+    if(!Entries[i].used && Entries[i].file != Entries[0].file) {
+      FRED_STATUS(0, "PARAMS: %s = %s in %s was not used\n", Entries[i].name.c_str(),
+		  Entries[i].value.c_str(), Entries[i].file.c_str());
     }
   }
-  return Params::param_count;
 }
 
 int Params::get_param(char* s, int* p) {
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      if(sscanf(Params::param_value[i], "%d", p)) {
-        found = 1;
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    Param_Entry &entry = Entries[(*entries)[i]];
+    if(entry.int_status == UNPARSED) {
+      entry.int_status = sscanf(entry.value.c_str(), "%d", &entry.int_value);
+    }
+    if(entry.int_status) {
+      if(entry.int_status == 1) {
+	*p = entry.int_value;
       }
+      found = 1;
     }
   }
   if(found) {
@@ -219,11 +278,10 @@ int Params::get_param(char* s, int* p) {
 
 int Params::get_param(char* s, unsigned long* p) {
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      if(sscanf(Params::param_value[i], "%lu", p)) {
-        found = 1;
-      }
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    if(sscanf(Entries[(*entries)[i]].value.c_str(), "%lu", p)) {
+      found = 1;
     }
   }
   if(found) {
@@ -246,11 +304,17 @@ int Params::get_param(char* s, unsigned long* p) {
 
 int Params::get_param(char* s, double* p) {
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      if(sscanf(Params::param_value[i], "%lf", p)) {
-        found = 1;
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    Param_Entry &entry = Entries[(*entries)[i]];
+    if(entry.double_status == UNPARSED) {
+      entry.double_status = sscanf(entry.value.c_str(), "%lf", &entry.double_value);
+    }
+    if(entry.double_status) {
+      if(entry.double_status == 1) {
+	*p = entry.double_value;
       }
+      found = 1;
     }
   }
   if(found) {
@@ -273,11 +337,10 @@ int Params::get_param(char* s, double* p) {
 
 int Params::get_param(char* s, float* p) {
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      if(sscanf(Params::param_value[i], "%f", p)) {
-        found = 1;
-      }
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    if(sscanf(Entries[(*entries)[i]].value.c_str(), "%f", p)) {
+      found = 1;
     }
   }
   if(found) {
@@ -300,14 +363,12 @@ int Params::get_param(char* s, float* p) {
 
 int Params::get_param(char* s, string &p){
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      stringstream ss;
-      ss << Params::param_value[i];
-      if(ss.str().size() > 0){
-        p = ss.str();
-        found = 1;
-      }
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    const string &value = Entries[(*entries)[i]].value;
+    if(value.size() > 0){
+      p = value;
+      found = 1;
     }
   }
   if(found) {
@@ -330,12 +391,10 @@ int Params::get_param(char* s, string &p){
 
 int Params::get_param(char* s, char* p) {
   int found = 0;
-  for(int i = 0; i < Params::param_count; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      if(strcpy(p, Params::param_value[i])) {
-        found = 1;
-      }
-    }
+  const vector<int>* entries = find_param(s);
+  for(int i = 0; entries != NULL && i < entries->size(); ++i) {
+    strcpy(p, Entries[(*entries)[i]].value.c_str());
+    found = 1;
   }
   if(found) {
     if(Global::Debug > 0) {
@@ -553,15 +612,7 @@ int Params::get_double_indexed_param_map(string s, int index_i, int index_j, map
 }
 
 bool Params::does_param_exist(char* s) {
-  
-  bool found = false;
-  for(int i = 0; i < Params::param_count && !found; ++i) {
-    if(strcmp(Params::param_name[i], s) == 0) {
-      found = true;
-    }
-  }
-  
-  return found;
+  return find_param(s) != NULL;
 }
 
 bool Params::does_param_exist(string s) {
@@ -16,7 +16,6 @@
 #ifndef _FRED_PARAMS_H
 #define _FRED_PARAMS_H
 
-#define MAX_PARAMS 1000
 #define MAX_PARAM_SIZE 1024
 
 #include <stdlib.h>
@@ -34,6 +33,9 @@ using namespace std;
  * <code>Params::method_name()</code>, which in turn makes it clear for code maintenance where the actual
  * method resides.
  *
+ * The parameters are kept in a hash table by name, so a lookup (including the indexed names such as
+ * "influenza_trans" or "name[2]") costs the same however many parameters there are.  Int and double
+ * values are parsed once, on first use.  When a name is given more than once the last value read wins.
  */
 class Params {
 
@@ -85,14 +87,19 @@ public:
   static void read_parameter_file(char* paramfile);
 
   /**
-   * Read all of the parameters from a file and store them internally.  This method sets the private static
-   * values param_name, param_value, and param_count
+   * Read all of the parameters from a file (after the defaults file) and store them internally.
    *
    * @param  paramfile the file to read
    * @return 1 if found
    */
   static int read_parameters(char* paramfile);
 
+  /**
+   * Print the parameters that are set more than once in the same file, and those set outside the
+   * defaults file that were never looked up (usually misspelled names).
+   */
+  static void report_parameter_use();
+
   /**
    * @param s the parameter name
    * @param p a pointer to the vector of ints that will be set
@@ -224,9 +231,6 @@ public:
   }
 
 private:
-  static char param_name[][MAX_PARAM_SIZE];
-  static char param_value[][MAX_PARAM_SIZE];
-  static int param_count;
   static int abort_on_failure;
 };
 
@@ -67,12 +67,11 @@ void Person::setup(int _index, int _id, int age, char sex,
       Disease* dis = Global::Diseases.get_disease(disease);
       
       if(Global::Residual_Immunity_by_FIPS) {
-	      Age_Map* temp_map = new Age_Map();
-	      vector<double> temp_ages = dis->get_residual_immunity()->get_ages();
-	      vector<double> temp_values = dis->get_residual_immunity_values_by_FIPS(myFIPS);
-	      temp_map->set_ages(temp_ages);
-	      temp_map->set_values(temp_values);
-     	  double residual_immunity_by_fips_prob = temp_map->find_value(this->get_real_age());
+	      Age_Map* residual_immunity_by_fips = dis->get_residual_immunity_by_FIPS(myFIPS);
+	      double residual_immunity_by_fips_prob = 0.0;
+	      if(residual_immunity_by_fips != NULL) {
+	        residual_immunity_by_fips_prob = residual_immunity_by_fips->find_value(this->get_real_age());
+	      }
 	      if(Random::draw_random() < residual_immunity_by_fips_prob) {
 	        become_immune(dis);
 	      }
@@ -83,6 +83,10 @@ public:
     this->health.update_infection(day, disease_id);
   }
 
+  bool advance_infection(int day, int disease_id) {
+    return this->health.advance_infection(day, disease_id);
+  }
+
   void update_health_interventions(int day) {
     this->health.update_interventions(day);
   }
@@ -118,6 +122,13 @@ public:
     this->activities.update_enrollee_index(mixing_group, pos);
   }
 
+  /**
+   * @return this person's position in the enrollee list of mixing_group, or -1 if not enrolled there
+   */
+  int get_enrollee_index(Mixing_Group* mixing_group) {
+    return this->activities.get_enrollee_index(mixing_group);
+  }
+
   /**
    * @Activities::update_profile()
    */
@@ -250,6 +261,14 @@ public:
     return this->demographics.get_real_age();
   }
 
+  /**
+   * @return the Person's birthday in simulation time
+   * @see Demographics::get_birthday_sim_day()
+   */
+  int get_birthday_sim_day() const {
+    return this->demographics.get_birthday_sim_day();
+  }
+
   /**
    * @return the Person's sex
    */
@@ -0,0 +1,59 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Person_Set.cc
+//
+
+#include "Person_Set.h"
+#include "Person.h"
+
+void Person_Set::insert(Person* person) {
+  int idx = person->get_pop_index();
+  assert(0 <= idx);
+  if(static_cast<int>(this->slot.size()) <= idx) {
+    // grow geometrically; the population index bound only changes with births
+    int new_size = 2 * static_cast<int>(this->slot.size());
+    if(new_size <= idx) {
+      new_size = idx + 1;
+    }
+    this->slot.resize(new_size, -1);
+  }
+  if(0 <= this->slot[idx]) {
+    return;
+  }
+  this->slot[idx] = static_cast<int>(this->members.size());
+  this->members.push_back(person);
+}
+
+void Person_Set::erase(Person* person) {
+  int idx = person->get_pop_index();
+  if(idx < 0 || static_cast<int>(this->slot.size()) <= idx || this->slot[idx] < 0) {
+    return;
+  }
+  int pos = this->slot[idx];
+  Person* last = this->members.back();
+  this->members[pos] = last;
+  this->slot[last->get_pop_index()] = pos;
+  this->members.pop_back();
+  this->slot[idx] = -1;
+}
+
+bool Person_Set::contains(Person* person) {
+  int idx = person->get_pop_index();
+  return (0 <= idx && idx < static_cast<int>(this->slot.size()) && 0 <= this->slot[idx]);
+}
+
+void Person_Set::clear() {
+  this->members.clear();
+  this->slot.clear();
+}
@@ -0,0 +1,67 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Person_Set.h
+//
+// Person_Set is a set of people keyed by their population index.  Members
+// are kept in a packed vector in insertion order (removal moves the last
+// member into the vacated slot), and a table indexed by population index
+// records each member's slot, so insert, erase and membership are O(1)
+// and iteration is a linear walk that does not depend on heap addresses.
+//
+
+#ifndef _FRED_PERSON_SET_H
+#define _FRED_PERSON_SET_H
+
+#include <vector>
+
+using namespace std;
+
+class Person;
+
+class Person_Set {
+public:
+  Person_Set() {
+    clear();
+  }
+
+  // no effect if the person is already a member
+  void insert(Person* person);
+
+  // no effect if the person is not a member
+  void erase(Person* person);
+
+  bool contains(Person* person);
+
+  void clear();
+
+  int size() {
+    return static_cast<int>(this->members.size());
+  }
+
+  bool empty() {
+    return this->members.empty();
+  }
+
+  Person* get_member(int i) {
+    return this->members[i];
+  }
+
+private:
+  std::vector<Person*> members;
+
+  // slot in members for each population index, or -1 if not a member
+  std::vector<int> slot;
+};
+
+#endif // _FRED_PERSON_SET_H
@@ -99,9 +99,7 @@ Place::Place() : Mixing_Group("BLANK") {
     this->infectious_people[d].clear();
   }
 
-  this->vector_disease_data = NULL;
-  this->vectors_have_been_infected_today = false;
-  this->vector_control_status = false;
+  this->vector_slot = -1;
 }
 
 Place::Place(const char* lab, fred::geo lon, fred::geo lat) : Mixing_Group(lab) {
@@ -145,9 +143,7 @@ Place::Place(const char* lab, fred::geo lon, fred::geo lat) : Mixing_Group(lab)
     this->infectious_people[d].clear();
   }
 
-  this->vector_disease_data = NULL;
-  this->vectors_have_been_infected_today = false;
-  this->vector_control_status = false;
+  this->vector_slot = -1;
 }
 
 void Place::prepare() {
@@ -314,56 +310,63 @@ int Place::get_contact_count(Person* infector, int disease_id, int sim_day, doub
 
 
 void Place::setup_vector_model() {
-
-  this->vector_disease_data = new vector_disease_data_t;
+  Vector_State &state = Global::Vectors->get_vector_state();
 
   // initial vector counts
-  if(this->is_neighborhood()) {
+  double vectors_per_host = 0.0;
+  if(this->is_neighborhood() == false) {
     // no vectors in neighborhoods (outdoors)
-    this->vector_disease_data->vectors_per_host = 0.0;
-  }
-  else {
-    this->vector_disease_data->vectors_per_host = 0.0;
-    this->vector_disease_data->vectors_per_host = Global::Vectors->get_vectors_per_host(this);
-  }
-  this->vector_disease_data->N_vectors = this->N_orig * this->vector_disease_data->vectors_per_host;
-  this->vector_disease_data->S_vectors = this->vector_disease_data->N_vectors;
-  for(int i = 0; i < VECTOR_DISEASE_TYPES; ++i) {
-    this->vector_disease_data->E_vectors[i] = 0;
-    this->vector_disease_data->I_vectors[i] = 0;
+    vectors_per_host = Global::Vectors->get_vectors_per_host(this);
   }
+  this->vector_slot = state.add_place(this, vectors_per_host, this->N_orig * vectors_per_host);
 
   // initial vector seed counts
   for(int i = 0; i < VECTOR_DISEASE_TYPES; ++i) {
-    if (this->is_neighborhood()) {
-      // no vectors in neighborhoods (outdoors)
-      this->vector_disease_data->place_seeds[i] = 0;
-      this->vector_disease_data->day_start_seed[i] = 0;
-      this->vector_disease_data->day_end_seed[i] = 1;
-    }
-    else {
-      this->vector_disease_data->place_seeds[i] = Global::Vectors->get_seeds(this,i);
-      this->vector_disease_data->day_start_seed[i] = Global::Vectors->get_day_start_seed(this,i);
-      this->vector_disease_data->day_end_seed[i] = Global::Vectors->get_day_end_seed(this,i);
+    if(this->is_neighborhood()) {
+      state.set_seeds(this->vector_slot, i, 0, 0, 1);
+    } else {
+      state.set_seeds(this->vector_slot, i, Global::Vectors->get_seeds(this, i),
+		      Global::Vectors->get_day_start_seed(this, i), Global::Vectors->get_day_end_seed(this, i));
     }
   }
   FRED_VERBOSE(1, "setup_vector_model: place %s vectors_per_host %f N_vectors %d N_orig %d\n",
-         this->get_label(), this->vector_disease_data->vectors_per_host,
-         this->vector_disease_data->N_vectors, this->N_orig);
+	       this->get_label(), vectors_per_host, state.get_vector_population_size(this->vector_slot), this->N_orig);
 }
 
-double Place::get_seeds(int dis, int sim_day) {
-  if((sim_day) || (sim_day > this->vector_disease_data->day_end_seed[dis])){
-    return 0.0;
-  } else {
-    return this->vector_disease_data->place_seeds[dis];
-  }
+void Place::mark_vectors_as_infected_today() {
+  Global::Vectors->get_vector_state().mark_vectors_as_infected_today(this->vector_slot);
 }
 
-void Place::update_vector_population(int day) {
-  if(this->is_neighborhood() == false) {
-    *(this->vector_disease_data) = Global::Vectors->update_vector_population(day, this);
-  }
+bool Place::have_vectors_been_infected_today() {
+  return Global::Vectors->get_vector_state().have_vectors_been_infected_today(this->vector_slot);
+}
+
+int Place::get_vector_population_size() {
+  return Global::Vectors->get_vector_state().get_vector_population_size(this->vector_slot);
+}
+
+int Place::get_susceptible_vectors() {
+  return Global::Vectors->get_vector_state().get_susceptible_vectors(this->vector_slot);
+}
+
+int Place::get_infected_vectors(int disease_id) {
+  return Global::Vectors->get_vector_state().get_infected_vectors(this->vector_slot, disease_id);
+}
+
+int Place::get_infectious_vectors(int disease_id) {
+  return Global::Vectors->get_vector_state().get_infectious_vectors(this->vector_slot, disease_id);
+}
+
+void Place::expose_vectors(int disease_id, int exposed_vectors) {
+  Global::Vectors->get_vector_state().expose_vectors(this->vector_slot, disease_id, exposed_vectors);
+}
+
+bool Place::get_vector_control_status() {
+  return Global::Vectors->get_vector_state().get_vector_control_status(this->vector_slot);
+}
+
+void Place::set_vector_control() {
+  Global::Vectors->get_vector_state().set_vector_control(this->vector_slot);
 }
 
 char* Place::get_place_label(Place* p) {
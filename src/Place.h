@@ -62,11 +62,7 @@ public:
    * Constructor with necessary parameters
    */
   Place(const char* lab, fred::geo lon, fred::geo lat);
-  virtual ~Place() {
-    if(this->vector_disease_data != NULL) {
-      delete this->vector_disease_data;
-    }
-  }
+  virtual ~Place() {}
 
   virtual void print(int disease_id);
 
@@ -333,63 +329,21 @@ public:
   
   static char* get_place_label(Place* p);
 
-  double get_seeds(int dis, int sim_day);
-
   /*
    * Vector Transmission methods
    */
   void setup_vector_model();
 
-  void mark_vectors_as_not_infected_today() {
-    this->vectors_have_been_infected_today = false;
-  }
-
-  void mark_vectors_as_infected_today() {
-    this->vectors_have_been_infected_today = true;
-  }
-
-  bool have_vectors_been_infected_today() {
-    return this->vectors_have_been_infected_today;
-  }
-
-  int get_vector_population_size() {
-    return this->vector_disease_data->N_vectors;
-  }
-
-  int get_susceptible_vectors() {
-    return this->vector_disease_data->S_vectors;
-  }
-
-  int get_infected_vectors(int disease_id) {
-    return this->vector_disease_data->E_vectors[disease_id] +
-      this->vector_disease_data->I_vectors[disease_id];
-  }
-
-  int get_infectious_vectors(int disease_id) {
-    return this->vector_disease_data->I_vectors[disease_id];
-  }
-
-  void expose_vectors(int disease_id, int exposed_vectors) {
-    this->vector_disease_data->E_vectors[disease_id] += exposed_vectors;
-    this->vector_disease_data->S_vectors -= exposed_vectors;
-  }
-
-  vector_disease_data_t get_vector_disease_data () {
-    assert(this->vector_disease_data != NULL);
-    return (*this->vector_disease_data);
-  }
-
-  void update_vector_population(int sim_day);
-
-  bool get_vector_control_status() {
-    return this->vector_control_status;
-  }
-  void set_vector_control(){
-    vector_control_status = true;
-  }
-  void stop_vector_control(){
-      vector_control_status = false;
-  }
+  // the vector counts and flags of this place's slot in Vector_Layer's Vector_State
+  void mark_vectors_as_infected_today();
+  bool have_vectors_been_infected_today();
+  int get_vector_population_size();
+  int get_susceptible_vectors();
+  int get_infected_vectors(int disease_id);
+  int get_infectious_vectors(int disease_id);
+  void expose_vectors(int disease_id, int exposed_vectors);
+  bool get_vector_control_status();
+  void set_vector_control();
 
 protected:
   static double** prob_contact;
@@ -409,9 +363,7 @@ protected:
   Neighborhood_Patch* patch;       // geo patch for this place
 
   // optional data for vector transmission model
-  vector_disease_data_t* vector_disease_data;
-  bool vectors_have_been_infected_today;
-  bool vector_control_status;
+  int vector_slot;
 
   // Place_List, Neighborhood_Layer and Neighborhood_Patch are friends so that they can access
   // the Place Allocator.
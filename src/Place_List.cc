@@ -24,6 +24,8 @@
 #include <unistd.h>
 #include "Classroom.h"
 #include "Disease.h"
+#include "Disease_List.h"
+#include "Epidemic.h"
 #include "Geo.h"
 #include "Global.h"
 #include "Hospital.h"
@@ -42,9 +44,11 @@
 #include "Random.h"
 #include "School.h"
 #include "Seasonality.h"
+#include "Snapshot.h"
 #include "Tracker.h"
 #include "Travel.h"
 #include "Utils.h"
+#include "Vector_Layer.h"
 #include "Visualization_Layer.h"
 #include "Workplace.h"
 
@@ -147,6 +151,7 @@ void Place_List::get_parameters() {
   Params::get_param_from_string("synthetic_population_directory", Global::Synthetic_population_directory);
   Params::get_param_from_string("synthetic_population_id", Global::Synthetic_population_id);
   Params::get_param_from_string("synthetic_population_version", Global::Synthetic_population_version);
+  Params::get_param_from_string("population_cache_directory", Global::Population_cache_directory);
   Params::get_param_from_string("city", Global::City);
   Params::get_param_from_string("county", Global::County);
   Params::get_param_from_string("state", Global::US_state);
@@ -739,6 +744,42 @@ void Place_List::read_places(const char* pop_dir, const char* pop_id, unsigned c
 
   FRED_STATUS(0, "read places entered\n", "");
 
+  // places of this population id; merged into pids below since different
+  // population ids may list the same place
+  InitSetT pop_pids;
+  char snapshot_file[FRED_STRING_SIZE];
+  uint64_t snapshot_key = 0;
+  bool use_snapshot = strcmp(Global::Population_cache_directory, "none") != 0;
+  if(use_snapshot) {
+    sprintf(snapshot_file, "%s/%s_places.snap", Global::Population_cache_directory, pop_id);
+    snapshot_key = get_places_snapshot_key(pop_dir, pop_id);
+  }
+
+  if(use_snapshot && read_places_snapshot(snapshot_file, snapshot_key, deme_id, pop_pids)) {
+    Utils::fred_log("POPULATION_FILE: %s/%s\n", pop_dir, pop_id);
+    Utils::fred_log("PLACES_SNAPSHOT: %s\n", snapshot_file);
+    Utils::fred_print_lap_time("Places.read_places_snapshot");
+  } else {
+    int first_county = this->counties.size();
+    int first_census_tract = this->census_tracts.size();
+    read_place_files(pop_dir, pop_id, deme_id, pop_pids);
+    if(use_snapshot) {
+      Utils::fred_make_directory(Global::Population_cache_directory);
+      write_places_snapshot(snapshot_file, snapshot_key, pop_pids, first_county, first_census_tract);
+    }
+  }
+
+  for(InitSetT::iterator itr = pop_pids.begin(); itr != pop_pids.end(); ++itr) {
+    size_t n = pids.size();
+    pids.insert(pids.end(), *itr);
+    if(pids.size() > n) {
+      ++(this->place_type_counts[itr->place_type]);
+    }
+  }
+}
+
+void Place_List::read_place_files(const char* pop_dir, const char* pop_id, unsigned char deme_id, InitSetT &pids) {
+
   char location_file[FRED_STRING_SIZE];
   char temp_file[80];
   if(getenv("SCRATCH_RAMDISK") != NULL) {
@@ -882,13 +923,9 @@ void Place_List::read_household_file(unsigned char deme_id, char* location_file,
         this->counties.push_back(new_county);
       }
 
-      SetInsertResultT result = pids.insert(
+      pids.insert(
           Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
               tract_index, tokens[hh_income]));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
     }
     tokens.clear();
   }
@@ -916,12 +953,7 @@ void Place_List::read_workplace_file(unsigned char deme_id, char* location_file,
 
       sprintf(s, "%c%s", place_type, tokens[workplace_id]);
 
-      SetInsertResultT result = pids.insert(
-          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
+      pids.insert(Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id));
     }
     tokens.clear();
   }
@@ -956,13 +988,9 @@ void Place_List::read_hospital_file(unsigned char deme_id, char* location_file,
 
       sprintf(s, "%c%s", place_type, tokens[workplace_id]);
       sscanf(tokens[num_workers_assigned], "%d", &workers);
-      SetInsertResultT result = pids.insert(
+      pids.insert(
           Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, 0, 0, "0", false,
               workers));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
     }
     tokens.clear();
   }
@@ -1039,7 +1067,6 @@ void Place_List::read_school_file(unsigned char deme_id, char* location_file, In
           Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county));
 
       if(result.second) {
-        ++(this->place_type_counts[place_type]);
         FRED_VERBOSE(1, "READ_SCHOOL: %s %c %f %f name |%s| county %d\n", s, place_type, result.first->lat,
             result.first->lon, tokens[name], get_fips_of_county_with_index(county));
       }
@@ -1156,14 +1183,10 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
       place_type = Place::TYPE_WORKPLACE;
       sprintf(wp, "%c%s", place_type, tokens[gq_id]);
 
-      result = pids.insert(
+      pids.insert(
           Place_Init_Data(wp, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
               tract_index, "0", true));
 
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
-
       // add as household
       place_type = Place::TYPE_HOUSEHOLD;
       sprintf(s, "%c%s", place_type, tokens[gq_id]);
@@ -1171,7 +1194,6 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
           Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
               tract_index, "0", true, 0, number_of_units, tokens[gq_type], wp));
       if(result.second) {
-        ++(this->place_type_counts[place_type]);
         FRED_VERBOSE(1, "READ_GROUP_QUARTERS: %s type %c size %d lat %f lon %f\n", s, place_type, capacity,
             result.first->lat, result.first->lon);
       }
@@ -1179,12 +1201,9 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
       // generate additional household units associated with this group quarters
       for(int i = 1; i < number_of_units; ++i) {
         sprintf(s, "%c%s-%03d", place_type, tokens[gq_id], i);
-        result = pids.insert(
+        pids.insert(
             Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
                 tract_index, "0", true, 0, 0, tokens[gq_type], wp));
-        if(result.second) {
-          ++(this->place_type_counts[place_type]);
-        }
         FRED_VERBOSE(1, "Adding GQ Household %s out of %d units\n", s, number_of_units);
       }
     }
@@ -1193,6 +1212,222 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
   fclose(fp);
 }
 
+// columns of a places snapshot; the label tables take two columns each
+enum places_snapshot_column_t {
+  PLACE_LABEL = 0,
+  PLACE_TYPE = 2,
+  PLACE_SUBTYPE,
+  PLACE_LAT,
+  PLACE_LON,
+  PLACE_INCOME,
+  PLACE_COUNTY_FIPS,
+  PLACE_CENSUS_TRACT,
+  PLACE_IS_GROUP_QUARTERS,
+  PLACE_WORKERS,
+  PLACE_GROUP_QUARTERS_UNITS,
+  PLACE_GROUP_QUARTERS_TYPE,
+  PLACE_GROUP_QUARTERS_WORKPLACE,
+  PLACE_GROUP_QUARTERS_WORKPLACE_LABEL,
+  PLACE_NEW_COUNTIES = PLACE_GROUP_QUARTERS_WORKPLACE_LABEL + 2,
+  PLACE_NEW_CENSUS_TRACTS
+};
+
+uint64_t Place_List::get_places_snapshot_key(const char* pop_dir, const char* pop_id) {
+  char location_file[FRED_STRING_SIZE];
+  uint64_t key = 0;
+  sprintf(location_file, "%s/%s/%s_synth_households.txt", pop_dir, pop_id, pop_id);
+  key = Snapshot::mix_key(key, Snapshot::get_file_key(location_file));
+  sprintf(location_file, "%s/%s/%s_workplaces.txt", pop_dir, pop_id, pop_id);
+  key = Snapshot::mix_key(key, Snapshot::get_file_key(location_file));
+  sprintf(location_file, "%s/%s/%s_schools.txt", pop_dir, pop_id, pop_id);
+  key = Snapshot::mix_key(key, Snapshot::get_file_key(location_file));
+  key = Snapshot::mix_key(key, Global::Enable_Hospitals);
+  if(Global::Enable_Hospitals) {
+    sprintf(location_file, "%s/%s/%s_hospitals.txt", pop_dir, pop_id, pop_id);
+    key = Snapshot::mix_key(key, Snapshot::get_file_key(location_file));
+  }
+  key = Snapshot::mix_key(key, Global::Enable_Group_Quarters);
+  if(Global::Enable_Group_Quarters) {
+    sprintf(location_file, "%s/%s/%s_synth_gq.txt", pop_dir, pop_id, pop_id);
+    key = Snapshot::mix_key(key, Snapshot::get_file_key(location_file));
+    double sizes[4] = { Place_List::College_dorm_mean_size, Place_List::Military_barracks_mean_size,
+      Place_List::Prison_cell_mean_size, Place_List::Nursing_home_room_mean_size };
+    for(int i = 0; i < 4; ++i) {
+      uint64_t bits;
+      memcpy(&bits, &sizes[i], sizeof(bits));
+      key = Snapshot::mix_key(key, bits);
+    }
+  }
+  // census tracts are read with fewer digits for vector transmission
+  key = Snapshot::mix_key(key, Global::Enable_Vector_Transmission);
+  return key;
+}
+
+bool Place_List::read_places_snapshot(const char* snapshot_file, uint64_t key, unsigned char deme_id,
+    InitSetT &pids) {
+  Snapshot snapshot;
+  if(!snapshot.open(snapshot_file, Snapshot::PLACES, key)) {
+    FRED_VERBOSE(0, "no current places snapshot in %s\n", snapshot_file);
+    return false;
+  }
+  uint64_t n = snapshot.get_rows();
+  const char* type = snapshot.get_column<char>(PLACE_TYPE, n);
+  const char* subtype = snapshot.get_column<char>(PLACE_SUBTYPE, n);
+  const fred::geo* lat = snapshot.get_column<fred::geo>(PLACE_LAT, n);
+  const fred::geo* lon = snapshot.get_column<fred::geo>(PLACE_LON, n);
+  const int* income = snapshot.get_column<int>(PLACE_INCOME, n);
+  const int* fips = snapshot.get_column<int>(PLACE_COUNTY_FIPS, n);
+  const int64_t* tract = snapshot.get_column<int64_t>(PLACE_CENSUS_TRACT, n);
+  const char* is_gq = snapshot.get_column<char>(PLACE_IS_GROUP_QUARTERS, n);
+  const int* workers = snapshot.get_column<int>(PLACE_WORKERS, n);
+  const int* units = snapshot.get_column<int>(PLACE_GROUP_QUARTERS_UNITS, n);
+  const char* gq_type = snapshot.get_column<char>(PLACE_GROUP_QUARTERS_TYPE, n);
+  const int* gq_workplace = snapshot.get_column<int>(PLACE_GROUP_QUARTERS_WORKPLACE, n);
+  int64_t new_counties = snapshot.get_count(PLACE_NEW_COUNTIES, sizeof(int));
+  int64_t new_tracts = snapshot.get_count(PLACE_NEW_CENSUS_TRACTS, sizeof(int64_t));
+  if(snapshot.get_label_count(PLACE_LABEL) != static_cast<int64_t>(n) || type == NULL || subtype == NULL
+     || lat == NULL || lon == NULL || income == NULL || fips == NULL || tract == NULL || is_gq == NULL
+     || workers == NULL || units == NULL || gq_type == NULL || gq_workplace == NULL || new_counties < 0
+     || new_tracts < 0) {
+    FRED_WARNING("places snapshot %s is malformed; reading the text files\n", snapshot_file);
+    return false;
+  }
+  int64_t gq_workplaces = snapshot.get_label_count(PLACE_GROUP_QUARTERS_WORKPLACE_LABEL);
+  for(uint64_t i = 0; i < n; ++i) {
+    if(gq_workplace[i] < 0 || gq_workplace[i] >= gq_workplaces) {
+      FRED_WARNING("places snapshot %s is malformed; reading the text files\n", snapshot_file);
+      return false;
+    }
+  }
+  // the labels are copied into Place_Init_Data's fixed-size buffers
+  for(uint64_t i = 0; i < n; ++i) {
+    if(strlen(snapshot.get_label(PLACE_LABEL, i)) >= sizeof(Place_Init_Data::s)) {
+      FRED_WARNING("places snapshot %s is malformed; reading the text files\n", snapshot_file);
+      return false;
+    }
+  }
+  for(int64_t i = 0; i < gq_workplaces; ++i) {
+    if(strlen(snapshot.get_label(PLACE_GROUP_QUARTERS_WORKPLACE_LABEL, i)) >= sizeof(Place_Init_Data::gq_workplace)) {
+      FRED_WARNING("places snapshot %s is malformed; reading the text files\n", snapshot_file);
+      return false;
+    }
+  }
+
+  // add counties and census tracts in the order the text files first
+  // listed them, so their indices match a run that parsed the text
+  std::map<int, int> county_index;
+  for(int i = 0; i < this->counties.size(); ++i) {
+    county_index[this->counties[i]->get_fips()] = i;
+  }
+  std::map<long int, int> census_tract_index;
+  for(int i = 0; i < this->census_tracts.size(); ++i) {
+    census_tract_index[this->census_tracts[i]] = i;
+  }
+  const int* county_fips = snapshot.get_column<int>(PLACE_NEW_COUNTIES, new_counties);
+  for(int64_t i = 0; i < new_counties; ++i) {
+    if(county_index.find(county_fips[i]) == county_index.end()) {
+      county_index[county_fips[i]] = this->counties.size();
+      this->counties.push_back(new County(county_fips[i]));
+    }
+  }
+  const int64_t* census_tract = snapshot.get_column<int64_t>(PLACE_NEW_CENSUS_TRACTS, new_tracts);
+  for(int64_t i = 0; i < new_tracts; ++i) {
+    if(census_tract_index.find(census_tract[i]) == census_tract_index.end()) {
+      census_tract_index[census_tract[i]] = this->census_tracts.size();
+      this->census_tracts.push_back(census_tract[i]);
+    }
+  }
+
+  for(uint64_t i = 0; i < n; ++i) {
+    int county = -1;
+    if(fips[i] != -1) {
+      std::map<int, int>::iterator found = county_index.find(fips[i]);
+      if(found == county_index.end()) {
+        county_index[fips[i]] = this->counties.size();
+        this->counties.push_back(new County(fips[i]));
+        found = county_index.find(fips[i]);
+      }
+      county = found->second;
+    }
+    int tract_index = -1;
+    if(tract[i] != -1) {
+      std::map<long int, int>::iterator found = census_tract_index.find(tract[i]);
+      if(found == census_tract_index.end()) {
+        census_tract_index[tract[i]] = this->census_tracts.size();
+        this->census_tracts.push_back(tract[i]);
+        found = census_tract_index.find(tract[i]);
+      }
+      tract_index = found->second;
+    }
+    // the snapshot is in set order, so each insert goes at the end
+    pids.insert(pids.end(),
+        Place_Init_Data(snapshot.get_label(PLACE_LABEL, i), type[i], subtype[i], lat[i], lon[i], deme_id, county,
+            tract_index, income[i], is_gq[i] != 0, workers[i], units[i], gq_type[i],
+            snapshot.get_label(PLACE_GROUP_QUARTERS_WORKPLACE_LABEL, gq_workplace[i])));
+  }
+  FRED_VERBOSE(0, "read %d places from snapshot %s\n", (int) n, snapshot_file);
+  return true;
+}
+
+void Place_List::write_places_snapshot(const char* snapshot_file, uint64_t key, const InitSetT &pids,
+    int first_county, int first_census_tract) {
+  uint64_t n = pids.size();
+  Snapshot_Labels label;
+  Snapshot_Labels gq_workplace_label;
+  std::vector<char> type, subtype, is_gq, gq_type;
+  std::vector<fred::geo> lat, lon;
+  std::vector<int> income, fips, workers, units, gq_workplace;
+  std::vector<int64_t> tract;
+  for(InitSetT::const_iterator itr = pids.begin(); itr != pids.end(); ++itr) {
+    label.add(itr->s);
+    type.push_back(itr->place_type);
+    subtype.push_back(itr->place_subtype);
+    lat.push_back(itr->lat);
+    lon.push_back(itr->lon);
+    income.push_back(itr->income);
+    // counties and tracts are stored by value since their indices depend
+    // on the population ids read before this one
+    int county = itr->county;
+    fips.push_back(0 <= county && county < this->counties.size() ? this->counties[county]->get_fips() : -1);
+    int tract_index = itr->census_tract_index;
+    tract.push_back(0 <= tract_index && tract_index < this->census_tracts.size() ?
+        this->census_tracts[tract_index] : -1);
+    is_gq.push_back(itr->is_group_quarters);
+    workers.push_back(itr->num_workers_assigned);
+    units.push_back(itr->group_quarters_units);
+    gq_type.push_back(itr->gq_type[0]);
+    gq_workplace.push_back(gq_workplace_label.add(itr->gq_workplace));
+  }
+  std::vector<int> new_counties;
+  for(int i = first_county; i < this->counties.size(); ++i) {
+    new_counties.push_back(this->counties[i]->get_fips());
+  }
+  std::vector<int64_t> new_tracts(this->census_tracts.begin() + first_census_tract, this->census_tracts.end());
+
+  Snapshot_Writer writer(Snapshot::PLACES, key, n);
+  writer.add_labels(label);
+  writer.add_column(type);
+  writer.add_column(subtype);
+  writer.add_column(lat);
+  writer.add_column(lon);
+  writer.add_column(income);
+  writer.add_column(fips);
+  writer.add_column(tract);
+  writer.add_column(is_gq);
+  writer.add_column(workers);
+  writer.add_column(units);
+  writer.add_column(gq_type);
+  writer.add_column(gq_workplace);
+  writer.add_labels(gq_workplace_label);
+  writer.add_column(new_counties);
+  writer.add_column(new_tracts);
+  if(writer.write(snapshot_file)) {
+    FRED_VERBOSE(0, "wrote %d places to snapshot %s\n", (int) n, snapshot_file);
+  } else {
+    FRED_WARNING("could not write places snapshot %s\n", snapshot_file);
+  }
+}
+
 void Place_List::prepare() {
 
   FRED_STATUS(0, "prepare places entered\n", "");
@@ -1281,10 +1516,25 @@ void Place_List::update(int day) {
   }
 
   if(Global::Enable_Vector_Transmission) {
-    int number_places = this->places.size();
-    for(int p = 0; p < number_places; ++p) {
-      Place* place = this->places[p];
-      place->update_vector_population(day);
+    // the vector-borne epidemics keep the places that now have infectious vectors
+    std::vector<Epidemic*> vector_epidemics;
+    for(int d = 0; d < Global::Diseases.get_number_of_diseases(); ++d) {
+      Disease* disease = Global::Diseases.get_disease(d);
+      if(strcmp("vector", disease->get_transmission_mode()) == 0) {
+        disease->get_epidemic()->clear_infectious_vector_places();
+        vector_epidemics.push_back(disease->get_epidemic());
+      }
+    }
+    Global::Vectors->update_vector_population(day);
+    const Vector_State &state = Global::Vectors->get_vector_state();
+    int number_places = state.get_number_of_places();
+    for(int i = 0; i < vector_epidemics.size(); ++i) {
+      int disease_id = vector_epidemics[i]->get_id();
+      for(int p = 0; p < number_places; ++p) {
+        if(state.get_infectious_vectors(p, disease_id) > 0 && state.get_place(p)->is_neighborhood() == false) {
+          vector_epidemics[i]->add_infectious_vector_place(state.get_place(p));
+        }
+      }
     }
   }
 
@@ -1444,12 +1694,12 @@ Place* Place_List::get_place_from_label(const char* s) const {
   if(strcmp(s, "-1") == 0) {
     return NULL;
   }
-  string str(s);
-
-  if(this->place_label_map->find(str) != this->place_label_map->end()) {
-    return this->places[(*this->place_label_map)[str]];
+  // a single find, so that threads can look up labels at the same time
+  LabelMapT::const_iterator found = this->place_label_map->find(string(s));
+  if(found != this->place_label_map->end()) {
+    return this->places[found->second];
   } else {
-    FRED_VERBOSE(1, "Help!  can't find place with label = %s\n", str.c_str());
+    FRED_VERBOSE(1, "Help!  can't find place with label = %s\n", s);
     return NULL;
   }
 }
@@ -1818,6 +2068,7 @@ Place* Place_List::get_random_workplace() {
 
 void Place_List::assign_hospitals_to_households() {
   if(Global::Enable_Hospitals) {
+    this->hospital_index.setup(this->hospitals, Place_List::Hospitalization_radius);
     int number_hh = (int)this->households.size();
     for(int i = 0; i < number_hh; ++i) {
       Household* hh = static_cast<Household*>(this->households[i]);
@@ -1889,6 +2140,17 @@ void Place_List::prepare_primary_care_assignment() {
   }
 }
 
+const std::vector<int> & Place_List::get_hospital_candidates(Household* hh, Person* per, bool check_insurance, bool use_search_radius_limit) {
+  if(!this->hospital_index.is_ready()) {
+    this->hospital_index.setup(this->hospitals, Place_List::Hospitalization_radius);
+  }
+  Insurance_assignment_index::e insurance = Insurance_assignment_index::UNSET;
+  if(check_insurance) {
+    insurance = per->get_health()->get_insurance_type();
+  }
+  return this->hospital_index.get_candidates(hh, use_search_radius_limit, insurance);
+}
+
 Hospital* Place_List::get_random_open_hospital_matching_criteria(int sim_day, Person* per, bool check_insurance, bool use_search_radius_limit) {
   if(!Global::Enable_Hospitals) {
     return NULL;
@@ -1911,9 +2173,13 @@ Hospital* Place_List::get_random_open_hospital_matching_criteria(int sim_day, Pe
   //First, only try Hospitals within a certain radius (* that accept insurance)
   std::vector<double> hosp_probs;
   double probability_total = 0.0;
-  for(int i = 0; i < number_hospitals; ++i) {
-    Hospital* hospital = static_cast<Hospital*>(this->hospitals[i]);
-    double distance = distance_between_places(hh, hospital);
+  const std::vector<int> &candidates = get_hospital_candidates(hh, per, check_insurance, use_search_radius_limit);
+  int number_candidates = candidates.size();
+  double hh_x = Geo::get_x(hh->get_longitude());
+  double hh_y = Geo::get_y(hh->get_latitude());
+  for(int c = 0; c < number_candidates; ++c) {
+    Hospital* hospital = this->get_hospital_ptr(candidates[c]);
+    double distance = this->hospital_index.get_distance(hh_x, hh_y, candidates[c]);
     double cur_prob = 0.0;
     int increment = 0;
     overnight_cap = hospital->get_bed_count(sim_day);
@@ -1971,10 +2237,10 @@ Hospital* Place_List::get_random_open_hospital_matching_criteria(int sim_day, Pe
     probability_total += cur_prob;
     number_possible_hospitals += increment;
   }
-  assert(static_cast<int>(hosp_probs.size()) == number_hospitals);
+  assert(static_cast<int>(hosp_probs.size()) == number_candidates);
   if(number_possible_hospitals > 0) {
     if(probability_total > 0.0) {
-      for(int i = 0; i < number_hospitals; ++i) {
+      for(int i = 0; i < number_candidates; ++i) {
         hosp_probs[i] /= probability_total;
       }
     }
@@ -1982,10 +2248,10 @@ Hospital* Place_List::get_random_open_hospital_matching_criteria(int sim_day, Pe
     double rand = Random::draw_random();
     double cum_prob = 0.0;
     int i = 0;
-    while(i < number_hospitals) {
+    while(i < number_candidates) {
       cum_prob += hosp_probs[i];
       if(rand < cum_prob) {
-        return static_cast<Hospital*>(this->hospitals[i]);
+        return this->get_hospital_ptr(candidates[i]);
       }
       ++i;
     }
@@ -2019,10 +2285,14 @@ Hospital* Place_List::get_random_open_healthcare_facility_matching_criteria(int
   //First, only try Hospitals within a certain radius (* that accept insurance)
   std::vector<double> hosp_probs;
   double probability_total = 0.0;
-  for(int i = 0; i < number_hospitals; ++i) {
-    Hospital* hospital = static_cast<Hospital*>(this->hospitals[i]);
+  const std::vector<int> &candidates = get_hospital_candidates(hh, per, check_insurance, use_search_radius_limit);
+  int number_candidates = candidates.size();
+  double hh_x = Geo::get_x(hh->get_longitude());
+  double hh_y = Geo::get_y(hh->get_latitude());
+  for(int c = 0; c < number_candidates; ++c) {
+    Hospital* hospital = this->get_hospital_ptr(candidates[c]);
     daily_hosp_cap = hospital->get_daily_patient_capacity(sim_day);
-    double distance = distance_between_places(hh, hospital);
+    double distance = this->hospital_index.get_distance(hh_x, hh_y, candidates[c]);
     double cur_prob = 0.0;
     int increment = 0;
 
@@ -2080,10 +2350,10 @@ Hospital* Place_List::get_random_open_healthcare_facility_matching_criteria(int
     number_possible_hospitals += increment;
   } // end for loop
 
-  assert(static_cast<int>(hosp_probs.size()) == number_hospitals);
+  assert(static_cast<int>(hosp_probs.size()) == number_candidates);
   if(number_possible_hospitals > 0) {
     if(probability_total > 0.0) {
-      for(int i = 0; i < number_hospitals; ++i) {
+      for(int i = 0; i < number_candidates; ++i) {
         hosp_probs[i] /= probability_total;
       }
     }
@@ -2091,10 +2361,10 @@ Hospital* Place_List::get_random_open_healthcare_facility_matching_criteria(int
     double rand = Random::draw_random();
     double cum_prob = 0.0;
     int i = 0;
-    while(i < number_hospitals) {
+    while(i < number_candidates) {
       cum_prob += hosp_probs[i];
       if(rand < cum_prob) {
-        return static_cast<Hospital*>(this->hospitals[i]);
+        return this->get_hospital_ptr(candidates[i]);
       }
       ++i;
     }
@@ -2133,10 +2403,14 @@ Hospital* Place_List::get_random_primary_care_facility_matching_criteria(Person*
   //First, only try Hospitals within a certain radius (* that accept insurance)
   std::vector<double> hosp_probs;
   double probability_total = 0.0;
-  for(int i = 0; i < number_hospitals; ++i) {
-    Hospital* hospital = static_cast<Hospital*>(this->hospitals[i]);
+  const std::vector<int> &candidates = get_hospital_candidates(hh, per, check_insurance, use_search_radius_limit);
+  int number_candidates = candidates.size();
+  double hh_x = Geo::get_x(hh->get_longitude());
+  double hh_y = Geo::get_y(hh->get_latitude());
+  for(int c = 0; c < number_candidates; ++c) {
+    Hospital* hospital = this->get_hospital_ptr(candidates[c]);
     daily_hosp_cap = hospital->get_daily_patient_capacity(0);
-    double distance = distance_between_places(hh, hospital);
+    double distance = this->hospital_index.get_distance(hh_x, hh_y, candidates[c]);
     double cur_prob = 0.0;
     int increment = 0;
 
@@ -2225,10 +2499,10 @@ Hospital* Place_List::get_random_primary_care_facility_matching_criteria(Person*
     number_possible_hospitals += increment;
   }  // end for loop
 
-  assert(static_cast<int>(hosp_probs.size()) == number_hospitals);
+  assert(static_cast<int>(hosp_probs.size()) == number_candidates);
   if(number_possible_hospitals > 0) {
     if(probability_total > 0.0) {
-      for(int i = 0; i < number_hospitals; ++i) {
+      for(int i = 0; i < number_candidates; ++i) {
         hosp_probs[i] /= probability_total;
       }
     }
@@ -2236,10 +2510,10 @@ Hospital* Place_List::get_random_primary_care_facility_matching_criteria(Person*
     double rand = Random::draw_random();
     double cum_prob = 0.0;
     int i = 0;
-    while(i < number_hospitals) {
+    while(i < number_candidates) {
       cum_prob += hosp_probs[i];
       if(rand < cum_prob) {
-        return static_cast<Hospital*>(this->hospitals[i]);
+        return this->get_hospital_ptr(candidates[i]);
       }
       ++i;
     }
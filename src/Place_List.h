@@ -21,6 +21,7 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <stdint.h>
 #include <unordered_map>
 #include <vector>
 using namespace std;
@@ -34,6 +35,7 @@ using namespace std;
 #include "Neighborhood.h"
 #include "School.h"
 #include "Hospital.h"
+#include "Hospital_Index.h"
 #include "Workplace.h"
 class Classroom;
 class Office;
@@ -358,6 +360,11 @@ private:
   place_vector_t workplaces;
   place_vector_t hospitals;
 
+  void read_place_files(const char* pop_dir, const char* pop_id, unsigned char deme_id, InitSetT &pids);
+  uint64_t get_places_snapshot_key(const char* pop_dir, const char* pop_id);
+  bool read_places_snapshot(const char* snapshot_file, uint64_t key, unsigned char deme_id, InitSetT &pids);
+  void write_places_snapshot(const char* snapshot_file, uint64_t key, const InitSetT &pids, int first_county,
+      int first_census_tract);
   void read_household_file(unsigned char deme_id, char* location_file, InitSetT &pids);
   void read_workplace_file(unsigned char deme_id, char* location_file, InitSetT &pids);
   void read_hospital_file(unsigned char deme_id, char* location_file, InitSetT &pids);
@@ -376,6 +383,14 @@ private:
    * @return a pointer to the Hospital that is assigned to the Household
    */
   Hospital* get_hospital_assigned_to_household(Household* hh);
+
+  /**
+   * @return indices of the hospitals the searches above might choose for per,
+   * in hospital order (see Hospital_Index)
+   */
+  const std::vector<int> & get_hospital_candidates(Household* hh, Person* per, bool check_insurance, bool use_search_radius_limit);
+  Hospital_Index hospital_index;
+
   int number_of_demes;
   bool is_primary_care_assignment_initialized;
 
@@ -533,6 +548,7 @@ struct Place_Init_Data {
       int _num_workers_assigned, int _group_quarters_units, const char* _gq_type, const char* _gq_workplace) {
     place_type = _place_type;
     place_subtype = _place_subtype;
+    deme_id = _deme_id;
     strcpy(s, _s);
     sscanf(_lat, "%f", &lat);
     sscanf(_lon, "%f", &lon);
@@ -562,6 +578,28 @@ struct Place_Init_Data {
         _num_workers_assigned, _group_quarters_units, gq_type, gq_workplace);
   }
 
+  // from the already-parsed values stored in a places snapshot
+  Place_Init_Data(const char* _s, char _place_type, char _place_subtype, fred::geo _lat, fred::geo _lon,
+      unsigned char _deme_id, int _county, int _census_tract_index, int _income, bool _is_group_quarters,
+      int _num_workers_assigned, int _group_quarters_units, char _gq_type, const char* _gq_workplace) {
+    strcpy(s, _s);
+    place_type = _place_type;
+    place_subtype = _place_subtype;
+    admin_id = 0;
+    income = _income;
+    deme_id = _deme_id;
+    lat = _lat;
+    lon = _lon;
+    is_group_quarters = _is_group_quarters;
+    county = _county;
+    census_tract_index = _census_tract_index;
+    num_workers_assigned = _num_workers_assigned;
+    group_quarters_units = _group_quarters_units;
+    gq_type[0] = _gq_type;
+    gq_type[1] = '\0';
+    strcpy(gq_workplace, _gq_workplace);
+  }
+
   bool operator<(const Place_Init_Data & other) const {
 
     if(place_type != other.place_type) {
@@ -14,6 +14,10 @@
 // File: Population.cc
 //
 
+#include <ctype.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "Activities.h"
@@ -37,6 +41,7 @@
 #include "Population.h"
 #include "Random.h"
 #include "School.h"
+#include "Snapshot.h"
 #include "Travel.h"
 #include "Utils.h"
 #include "Vaccine_Manager.h"
@@ -217,52 +222,150 @@ void Population::setup() {
   FRED_STATUS(0, "population setup finished\n", "");
 }
 
-Person_Init_Data Population::get_person_init_data(char* line,
+namespace {
+
+  // one comma-separated field of a line of a population file
+  struct Field {
+    const char* begin;
+    int length;
+  };
+
+  const char* const MISSING = "-1";
+
+  // Split the line [begin, end) at commas into fields, as
+  // Utils::replace_csv_missing_data and Utils::split_by_delim do: an empty
+  // field reads as "-1", a trailing \r is dropped and a quoted field loses
+  // its quotes (and may contain commas).  Stores at most max_fields fields
+  // and returns the number of fields on the line.
+  int split_fields(const char* begin, const char* end, Field* fields, int max_fields) {
+    if(end > begin && end[-1] == '\r') {
+      --end;
+    }
+    int n = 0;
+    const char* p = begin;
+    while(p <= end) {
+      Field f;
+      const char* next;
+      const char* close = NULL;
+      if(p < end && (*p == '"' || *p == '\'')) {
+        close = static_cast<const char*>(memchr(p + 1, *p, end - p - 1));
+      }
+      if(close != NULL) {
+        f.begin = p + 1;
+        f.length = close - p - 1;
+        next = static_cast<const char*>(memchr(close, ',', end - close));
+      } else {
+        next = static_cast<const char*>(memchr(p, ',', end - p));
+        f.begin = p;
+        f.length = (next != NULL ? next : end) - p;
+      }
+      if(f.length == 0) {
+        f.begin = MISSING;
+        f.length = 2;
+      }
+      if(n < max_fields) {
+        fields[n] = f;
+      }
+      ++n;
+      if(next == NULL) {
+        break;
+      }
+      p = next + 1;
+    }
+    return n;
+  }
+
+  bool is_missing(const Field &f) {
+    return f.length == 2 && f.begin[0] == '-' && f.begin[1] == '1';
+  }
+
+  // read an int as sscanf("%d") would, leaving value alone if the field
+  // does not start with a number
+  void parse_int(const Field &f, int* value) {
+    const char* p = f.begin;
+    const char* end = f.begin + f.length;
+    while(p < end && isspace(*p)) {
+      ++p;
+    }
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    if(p == end || !isdigit(*p)) {
+      return;
+    }
+    int v = 0;
+    for(; p < end && isdigit(*p); ++p) {
+      v = 10 * v + (*p - '0');
+    }
+    *value = negative ? -v : v;
+  }
+
+  // label = prefix followed by the field
+  void set_label(char* label, size_t size, const char* prefix, const Field &f) {
+    size_t prefix_length = strlen(prefix);
+    if(prefix_length + f.length >= size) {
+      Utils::fred_abort("population label %s%.*s is longer than %d characters\n",
+			prefix, f.length, f.begin, (int) size - 1);
+    }
+    memcpy(label, prefix, prefix_length);
+    memcpy(label + prefix_length, f.begin, f.length);
+    label[prefix_length + f.length] = '\0';
+  }
+
+  bool is_header(const char* begin, const char* end) {
+    return (end - begin >= 4 && strncmp(begin, "p_id", 4) == 0)
+      || (end - begin >= 5 && strncmp(begin, "sp_id", 5) == 0);
+  }
+}
+
+Person_Init_Data Population::get_person_init_data(const char* begin, const char* end,
 						  bool is_group_quarters_population,
 						  bool is_2010_ver1_format) {
-  char newline[1024];
-  Utils::replace_csv_missing_data(newline, line, "-1");
-  Utils::Tokens tokens = Utils::split_by_delim(newline, ',', false);
+  const int max_columns = 16;
+  Field fields[max_columns];
   const PopFileColIndex &col = get_pop_file_col_index(is_group_quarters_population, is_2010_ver1_format);
-  assert(int(tokens.size()) == col.number_of_columns);
+  int n = split_fields(begin, end, fields, max_columns);
+  if(n != col.number_of_columns) {
+    Utils::fred_abort("population file line \"%.*s\" has %d columns instead of %d\n",
+		      (int) (end - begin), begin, n, col.number_of_columns);
+  }
   // initialized with default values
   Person_Init_Data pid = Person_Init_Data();
-  strcpy(pid.label, tokens[col.p_id]);
+  set_label(pid.label, sizeof(pid.label), "", fields[col.p_id]);
   // add type indicator to label for places
   if(is_group_quarters_population) {
     pid.in_grp_qrtrs = true;
-    sscanf(tokens[col.gq_type], "%c", &pid.gq_type);
-    // columns present in group quarters population
-    if(strcmp(tokens[col.home_id], "-1")) {
-      sprintf(pid.house_label, "H%s", tokens[col.home_id]);
-    }
-    if(strcmp(tokens[col.workplace_id], "-1")) {
-      sprintf(pid.work_label, "W%s", tokens[col.workplace_id]);
-    }
-    // printf("GQ person %s house %s work %s\n", pid.label, pid.house_label, pid.work_label);
+    pid.gq_type = fields[col.gq_type].begin[0];
   } else {
     // columns not present in group quarters population
-    sscanf(tokens[col.relate], "%d", &pid.relationship);
-    sscanf(tokens[col.race_str], "%d", &pid.race);
+    parse_int(fields[col.relate], &pid.relationship);
+    parse_int(fields[col.race_str], &pid.race);
     // schools only defined for synth_people
-    if(strcmp(tokens[col.school_id], "-1")) {
-      sprintf(pid.school_label, "S%s", tokens[col.school_id]);
-    }
-    // standard formatting for house and workplace labels
-    if(strcmp(tokens[col.home_id], "-1")) {
-      sprintf(pid.house_label, "H%s", tokens[col.home_id]);
-    }
-    if(strcmp(tokens[col.workplace_id], "-1")) {
-      sprintf(pid.work_label, "W%s", tokens[col.workplace_id]);
+    if(!is_missing(fields[col.school_id])) {
+      set_label(pid.school_label, sizeof(pid.school_label), "S", fields[col.school_id]);
     }
   }
+  // standard formatting for house and workplace labels
+  if(!is_missing(fields[col.home_id])) {
+    set_label(pid.house_label, sizeof(pid.house_label), "H", fields[col.home_id]);
+  }
+  if(!is_missing(fields[col.workplace_id])) {
+    set_label(pid.work_label, sizeof(pid.work_label), "W", fields[col.workplace_id]);
+  }
   // age, sex same for synth_people and synth_gq_people
-  sscanf(tokens[col.age_str], "%d", &pid.age);
-  pid.sex = strcmp(tokens[col.sex_str], "1") == 0 ? 'M' : 'F';
+  parse_int(fields[col.age_str], &pid.age);
+  const Field &sex = fields[col.sex_str];
+  pid.sex = (sex.length == 1 && sex.begin[0] == '1') ? 'M' : 'F';
   // set pointer to primary places in init data object
   pid.house = Global::Places.get_place_from_label(pid.house_label);
   pid.work =  Global::Places.get_place_from_label(pid.work_label);
   pid.school = Global::Places.get_place_from_label(pid.school_label);
+  return pid;
+}
+
+void Population::check_person_places(Person_Init_Data &pid) {
   // warn if we can't find workplace
   if(strcmp(pid.work_label, "-1") != 0 && pid.work == NULL) {
     FRED_VERBOSE(2, "WARNING: person %s -- no workplace found for label = %s\n", pid.label,
@@ -278,11 +381,10 @@ Person_Init_Data Population::get_person_init_data(char* line,
   // warn if we can't find school.  No school for gq_people
   FRED_CONDITIONAL_VERBOSE(0, (strcmp(pid.school_label,"-1") != 0 && pid.school == NULL),
 			   "WARNING: person %s -- no school found for label = %s\n", pid.label, pid.school_label);
-
-  return pid;
 }
 
-void Population::parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop) {
+void Population::parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop,
+					 std::vector<Person_Init_Data>* records) {
 
   // vector used for batch add of new persons
   std::vector<Person_Init_Data> pidv;
@@ -307,9 +409,10 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
       continue;
     }
 
-    const Person_Init_Data &pid = get_person_init_data(line,
-						       is_group_quarters_pop,
-						       is_2010_ver1_format);
+    Person_Init_Data pid = get_person_init_data(line, line + strlen(line),
+						is_group_quarters_pop,
+						is_2010_ver1_format);
+    check_person_places(pid);
 
     // verbose printing of all person initialization data
     if(Global::Verbose > 1) {
@@ -321,6 +424,10 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
       continue;
     }
 
+    if(records != NULL) {
+      records->push_back(pid);
+    }
+
     if(pid.house != NULL) {
       // create a Person_Init_Data object
       pidv.push_back(pid);
@@ -334,7 +441,10 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
     n++;
   } // <----- end while loop over stream
   FRED_VERBOSE(0, "end of stream, persons = %d\n", n);
+  add_persons(pidv);
+}
 
+void Population::add_persons(std::vector<Person_Init_Data> &pidv) {
   // Iterate through vector of already parsed initialization data and
   // add to population bloque.  More efficient to do this in batches; also
   // preserves the (fine-grained) order in the population file.  Protect
@@ -351,6 +461,98 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
   }
 }
 
+void Population::parse_population_file(const char* pop_file, bool is_group_quarters_pop,
+				       std::vector<Person_Init_Data>* records) {
+  int fd = open(pop_file, O_RDONLY);
+  struct stat st;
+  if(fd < 0 || fstat(fd, &st) != 0) {
+    Utils::fred_abort("can't read population_file %s\n", pop_file);
+  }
+  size_t length = st.st_size;
+  const char* text = "";
+  if(length > 0) {
+    void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(p == MAP_FAILED) {
+      Utils::fred_abort("can't map population_file %s\n", pop_file);
+    }
+    madvise(p, length, MADV_SEQUENTIAL);
+    text = static_cast<const char*>(p);
+  }
+  close(fd);
+  const char* end = text + length;
+
+  // a 2010_ver1 file starts with an sp_id header
+  bool is_2010_ver1_format = length >= 5 && strncmp(text, "sp_id", 5) == 0;
+
+  // Split the file at line boundaries into a few chunks per thread (of
+  // at least a megabyte) and parse the chunks in parallel.
+  size_t chunks = 4 * fred::omp_get_max_threads();
+  chunks = std::max(static_cast<size_t>(1), std::min(chunks, length >> 20));
+  std::vector<const char*> bounds(chunks + 1, end);
+  bounds[0] = text;
+  for(size_t c = 1; c < chunks; ++c) {
+    const char* p = std::max(text + length / chunks * c, bounds[c - 1]);
+    if(p > text && p < end && p[-1] != '\n') {
+      const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+      p = (eol != NULL ? eol + 1 : end);
+    }
+    bounds[c] = p;
+  }
+
+  std::vector<std::vector<Person_Init_Data> > parsed(chunks);
+#pragma omp parallel for schedule(dynamic, 1)
+  for(size_t c = 0; c < chunks; ++c) {
+    const char* p = bounds[c];
+    while(p < bounds[c + 1]) {
+      const char* eol = static_cast<const char*>(memchr(p, '\n', bounds[c + 1] - p));
+      if(eol == NULL) {
+        eol = bounds[c + 1];
+      }
+      // skip empty lines and headers
+      if(eol > p && !(eol == p + 1 && *p == '\r') && !is_header(p, eol)) {
+        parsed[c].push_back(get_person_init_data(p, eol, is_group_quarters_pop, is_2010_ver1_format));
+      }
+      p = eol + 1;
+    }
+  }
+  if(length > 0) {
+    munmap(const_cast<char*>(text), length);
+  }
+
+  // add the people in file order, so that their ids do not depend on the
+  // number of threads
+  int n = 0;
+  for(size_t c = 0; c < chunks; ++c) {
+    std::vector<Person_Init_Data> &pidv = parsed[c];
+    size_t housed = 0;
+    for(size_t i = 0; i < pidv.size(); ++i) {
+      Person_Init_Data &pid = pidv[i];
+      check_person_places(pid);
+      // verbose printing of all person initialization data
+      if(Global::Verbose > 1) {
+        FRED_VERBOSE(1, "%s\n", pid.to_string().c_str());
+      }
+      if(records != NULL) {
+        records->push_back(pid);
+      }
+      if(pid.house != NULL) {
+        pidv[housed++] = pid;
+      } else {
+        // we need at least a household (homeless people not yet supported), so
+        // skip this person
+        FRED_VERBOSE(0, "WARNING: skipping person %s -- %s %s\n", pid.label,
+		     "no household found for label =", pid.house_label);
+      }
+      FRED_VERBOSE(1, "person %d = %s -- house_label %s\n", n, pid.label, pid.house_label);
+      n++;
+    }
+    pidv.resize(housed);
+    add_persons(pidv);
+    std::vector<Person_Init_Data>().swap(pidv);
+  }
+  FRED_VERBOSE(0, "end of file, persons = %d\n", n);
+}
+
 void Population::split_synthetic_populations_by_deme() {
   using namespace std;
   using namespace Utils;
@@ -461,6 +663,20 @@ void Population::read_population(const char* pop_dir, const char* pop_id, const
   bool is_group_quarters_pop = strcmp(pop_type, "gq_people") == 0 ? true : false;
   FILE* fp = NULL;
 
+  // a current snapshot replaces the text file entirely
+  char snapshot_file[FRED_STRING_SIZE];
+  uint64_t snapshot_key = 0;
+  bool use_snapshot = strcmp(Global::Population_cache_directory, "none") != 0;
+  if(use_snapshot) {
+    sprintf(population_file, "%s/%s/%s_synth_%s.txt", pop_dir, pop_id, pop_id, pop_type);
+    snapshot_key = Snapshot::get_file_key(population_file);
+    sprintf(snapshot_file, "%s/%s_%s.snap", Global::Population_cache_directory, pop_id, pop_type);
+    if(read_population_snapshot(snapshot_file, snapshot_key)) {
+      FRED_VERBOSE(0, "finished reading population snapshot, pop_size = %d\n", pop_size);
+      return;
+    }
+  }
+
 #if SNAPPY
 
   // try to open compressed population file
@@ -522,14 +738,144 @@ void Population::read_population(const char* pop_dir, const char* pop_id, const
   } else {
     pop_file = population_file;
   }
-  std::ifstream stream(pop_file, ifstream::in);
-  parse_lines_from_stream(stream, is_group_quarters_pop);
+  if(use_snapshot) {
+    std::vector<Person_Init_Data> records;
+    parse_population_file(pop_file, is_group_quarters_pop, &records);
+    Utils::fred_make_directory(Global::Population_cache_directory);
+    write_population_snapshot(snapshot_file, snapshot_key, records);
+  } else {
+    parse_population_file(pop_file, is_group_quarters_pop);
+  }
   if(this->enable_copy_files) {
     unlink(temp_file);
   }
   FRED_VERBOSE(0, "finished reading uncompressed population, pop_size = %d\n", pop_size);
 }
 
+// columns of a people snapshot.  Person and place labels share one table
+// (two columns) and the other label columns index it, with -1 for none.
+enum people_snapshot_column_t {
+  PERSON_LABELS = 0,
+  PERSON_ID = 2,
+  PERSON_HOUSE,
+  PERSON_WORK,
+  PERSON_SCHOOL,
+  PERSON_AGE,
+  PERSON_RACE,
+  PERSON_RELATIONSHIP,
+  PERSON_SEX,
+  PERSON_IN_GROUP_QUARTERS,
+  PERSON_GROUP_QUARTERS_TYPE
+};
+
+bool Population::read_population_snapshot(const char* snapshot_file, uint64_t key) {
+  Snapshot snapshot;
+  if(!snapshot.open(snapshot_file, Snapshot::PEOPLE, key)) {
+    FRED_VERBOSE(0, "no current population snapshot in %s\n", snapshot_file);
+    return false;
+  }
+  uint64_t n = snapshot.get_rows();
+  int64_t labels = snapshot.get_label_count(PERSON_LABELS);
+  const int* id = snapshot.get_column<int>(PERSON_ID, n);
+  const int* house = snapshot.get_column<int>(PERSON_HOUSE, n);
+  const int* work = snapshot.get_column<int>(PERSON_WORK, n);
+  const int* school = snapshot.get_column<int>(PERSON_SCHOOL, n);
+  const int* age = snapshot.get_column<int>(PERSON_AGE, n);
+  const int* race = snapshot.get_column<int>(PERSON_RACE, n);
+  const int* relationship = snapshot.get_column<int>(PERSON_RELATIONSHIP, n);
+  const char* sex = snapshot.get_column<char>(PERSON_SEX, n);
+  const char* in_grp_qrtrs = snapshot.get_column<char>(PERSON_IN_GROUP_QUARTERS, n);
+  const char* gq_type = snapshot.get_column<char>(PERSON_GROUP_QUARTERS_TYPE, n);
+  bool ok = labels >= 0 && id != NULL && house != NULL && work != NULL && school != NULL && age != NULL
+    && race != NULL && relationship != NULL && sex != NULL && in_grp_qrtrs != NULL && gq_type != NULL;
+  // labels must fit the Person_Init_Data buffers
+  for(int64_t i = 0; ok && i < labels; ++i) {
+    ok = strlen(snapshot.get_label(PERSON_LABELS, i)) < sizeof(Person_Init_Data().label);
+  }
+  for(uint64_t i = 0; ok && i < n; ++i) {
+    ok = 0 <= id[i] && id[i] < labels && -1 <= house[i] && house[i] < labels
+      && -1 <= work[i] && work[i] < labels && -1 <= school[i] && school[i] < labels;
+  }
+  if(!ok) {
+    FRED_WARNING("population snapshot %s is malformed; reading the text file\n", snapshot_file);
+    return false;
+  }
+
+  // many people share a household or workplace, so each label is looked
+  // up once
+  std::vector<Place*> place(labels, NULL);
+  std::vector<bool> found(labels, false);
+  std::vector<Person_Init_Data> pidv;
+  pidv.reserve(n);
+  for(uint64_t i = 0; i < n; ++i) {
+    Person_Init_Data pid(age[i], race[i], relationship[i], sex[i], false, 0);
+    strcpy(pid.label, snapshot.get_label(PERSON_LABELS, id[i]));
+    pid.in_grp_qrtrs = in_grp_qrtrs[i] != 0;
+    pid.gq_type = gq_type[i];
+    int ref[3] = { house[i], work[i], school[i] };
+    char* ref_label[3] = { pid.house_label, pid.work_label, pid.school_label };
+    Place** ref_place[3] = { &pid.house, &pid.work, &pid.school };
+    for(int r = 0; r < 3; ++r) {
+      if(ref[r] < 0) {
+        continue;
+      }
+      strcpy(ref_label[r], snapshot.get_label(PERSON_LABELS, ref[r]));
+      if(!found[ref[r]]) {
+        place[ref[r]] = Global::Places.get_place_from_label(ref_label[r]);
+        found[ref[r]] = true;
+      }
+      *ref_place[r] = place[ref[r]];
+    }
+    check_person_places(pid);
+    if(pid.house != NULL) {
+      pidv.push_back(pid);
+    } else {
+      FRED_VERBOSE(0, "WARNING: skipping person %s -- %s %s\n", pid.label,
+		   "no household found for label =", pid.house_label);
+    }
+  }
+  FRED_VERBOSE(0, "read %d persons from snapshot %s\n", (int) n, snapshot_file);
+  add_persons(pidv);
+  return true;
+}
+
+void Population::write_population_snapshot(const char* snapshot_file, uint64_t key,
+					   const std::vector<Person_Init_Data> &records) {
+  Snapshot_Labels labels;
+  std::vector<int> id, house, work, school, age, race, relationship;
+  std::vector<char> sex, in_grp_qrtrs, gq_type;
+  for(size_t i = 0; i < records.size(); ++i) {
+    const Person_Init_Data &pid = records[i];
+    id.push_back(labels.add(pid.label));
+    house.push_back(strcmp(pid.house_label, "-1") != 0 ? labels.add(pid.house_label) : -1);
+    work.push_back(strcmp(pid.work_label, "-1") != 0 ? labels.add(pid.work_label) : -1);
+    school.push_back(strcmp(pid.school_label, "-1") != 0 ? labels.add(pid.school_label) : -1);
+    age.push_back(pid.age);
+    race.push_back(pid.race);
+    relationship.push_back(pid.relationship);
+    sex.push_back(pid.sex);
+    in_grp_qrtrs.push_back(pid.in_grp_qrtrs);
+    gq_type.push_back(pid.gq_type);
+  }
+  Snapshot_Writer writer(Snapshot::PEOPLE, key, records.size());
+  writer.add_labels(labels);
+  writer.add_column(id);
+  writer.add_column(house);
+  writer.add_column(work);
+  writer.add_column(school);
+  writer.add_column(age);
+  writer.add_column(race);
+  writer.add_column(relationship);
+  writer.add_column(sex);
+  writer.add_column(in_grp_qrtrs);
+  writer.add_column(gq_type);
+  if(writer.write(snapshot_file)) {
+    FRED_VERBOSE(0, "wrote %d persons to snapshot %s\n", (int) records.size(), snapshot_file);
+  } else {
+    FRED_WARNING("could not write population snapshot %s\n", snapshot_file);
+  }
+}
+
 void Population::remove_dead_from_population(int day) {
   size_t deaths = this->death_list.size();
   for(size_t i = 0; i < deaths; ++i) {
@@ -1510,7 +1856,7 @@ void Population::report_mean_hh_stats_per_income_category_per_census_tract() {
   }
 
   for(int i = Household_income_level_code::CAT_I; i < Household_income_level_code::UNCLASSIFIED; ++i) {
-    if(count_hh_per_income_cat > 0) {
+    if(count_hh_per_income_cat[i] > 0) {
       Global::Income_Category_Tracker->set_index_key_pair(i, "mean_household_income", (hh_income_per_income_cat[i] / (double)count_hh_per_income_cat[i]));
     } else {
       Global::Income_Category_Tracker->set_index_key_pair(i, "mean_household_income", (double)0.0);
@@ -23,6 +23,7 @@
 #include <map>
 #include <new>
 #include <sstream>
+#include <stdint.h>
 #include <stdio.h>
 #include <string>
 #include <vector>
@@ -290,12 +291,30 @@ private:
 
   std::vector<Utils::Tokens> demes;
 
-  void parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop);
+  // records, if given, receives every person read (for writing a snapshot)
+  void parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop,
+			       std::vector<Person_Init_Data>* records = NULL);
 
-  Person_Init_Data get_person_init_data(char* line,
+  // Parse the text population file with one thread per chunk of lines, then
+  // add the people in file order.  records, if given, receives every person read.
+  void parse_population_file(const char* pop_file, bool is_group_quarters_pop,
+			     std::vector<Person_Init_Data>* records = NULL);
+
+  // the person on the line [begin, end), with the places looked up but not
+  // yet checked (check_person_places)
+  Person_Init_Data get_person_init_data(const char* begin, const char* end,
 					bool is_group_quarters_population,
 					bool is_2010_ver1_format);
 
+  void check_person_places(Person_Init_Data &pid);
+
+  void add_persons(std::vector<Person_Init_Data> &pidv);
+
+  bool read_population_snapshot(const char* snapshot_file, uint64_t key);
+
+  void write_population_snapshot(const char* snapshot_file, uint64_t key,
+				 const std::vector<Person_Init_Data> &records);
+
 
   bloque<Person, fred::Pop_Masks> blq;   // all Persons in the population
   vector<Person*> death_list;		  // list of agents to die today
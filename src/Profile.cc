@@ -0,0 +1,196 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Profile.cc
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "Profile.h"
+#include "Global.h"
+#include "Params.h"
+#include "Utils.h"
+
+bool Profile::Enabled = false;
+Profile::Thread_Profile* Profile::Threads = NULL;
+
+namespace {
+
+  std::chrono::steady_clock::time_point Profile_start;
+
+  double seconds(int64_t nanoseconds) {
+    return 1e-9 * nanoseconds;
+  }
+
+}
+
+void Profile::get_parameters() {
+  int temp_int = 0;
+  Params::get_param_from_string("enable_profile", &temp_int);
+  Profile::Enabled = (temp_int == 1);
+  if(Profile::Enabled && Profile::Threads == NULL) {
+    Profile::Threads = new Thread_Profile [fred::omp_get_max_threads()];
+    for(int t = 0; t < fred::omp_get_max_threads(); ++t) {
+      add_child(Profile::Threads[t].nodes, -1, "run", -1);
+      Profile::Threads[t].current = 0;
+    }
+    Profile_start = std::chrono::steady_clock::now();
+  }
+}
+
+int Profile::add_child(std::vector<Node> &nodes, int parent, const char* name, int key) {
+  Node node = { name, key, parent, -1, -1, 0, 0 };
+  int index = nodes.size();
+  if(parent >= 0) {
+    // keep the children in the order they were first entered
+    int* link = &nodes[parent].first_child;
+    while(*link >= 0) {
+      link = &nodes[*link].next_sibling;
+    }
+    *link = index;
+  }
+  nodes.push_back(node);
+  return index;
+}
+
+int Profile::enter(const char* name, int key) {
+  Thread_Profile &thread = Profile::Threads[fred::omp_get_thread_num()];
+  std::vector<Node> &nodes = thread.nodes;
+  int child = nodes[thread.current].first_child;
+  while(child >= 0) {
+    if(nodes[child].key == key && (nodes[child].name == name || strcmp(nodes[child].name, name) == 0)) {
+      break;
+    }
+    child = nodes[child].next_sibling;
+  }
+  if(child < 0) {
+    child = add_child(nodes, thread.current, name, key);
+  }
+  thread.current = child;
+  return child;
+}
+
+void Profile::leave(int node, int64_t nanoseconds) {
+  Thread_Profile &thread = Profile::Threads[fred::omp_get_thread_num()];
+  Node &n = thread.nodes[node];
+  ++n.calls;
+  n.nanoseconds += nanoseconds;
+  thread.current = n.parent;
+}
+
+void Profile::merge(const std::vector<Node> &from, int from_node, std::vector<Node> &to, int to_node) {
+  for(int child = from[from_node].first_child; child >= 0; child = from[child].next_sibling) {
+    int match = to[to_node].first_child;
+    while(match >= 0 && (to[match].key != from[child].key || strcmp(to[match].name, from[child].name) != 0)) {
+      match = to[match].next_sibling;
+    }
+    if(match < 0) {
+      match = add_child(to, to_node, from[child].name, from[child].key);
+    }
+    to[match].calls += from[child].calls;
+    to[match].nanoseconds += from[child].nanoseconds;
+    merge(from, child, to, match);
+  }
+}
+
+namespace {
+
+  struct Report_Context {
+    FILE* json;
+    FILE* csv;
+  };
+
+  template <class Node>
+  int64_t child_nanoseconds(const std::vector<Node> &nodes, int node) {
+    int64_t total = 0;
+    for(int child = nodes[node].first_child; child >= 0; child = nodes[child].next_sibling) {
+      total += nodes[child].nanoseconds;
+    }
+    return total;
+  }
+
+  template <class Node>
+  void write_node(Report_Context &out, const std::vector<Node> &nodes, int node, const std::string &parent_path, int depth) {
+    const Node &n = nodes[node];
+    char label[256];
+    if(n.key >= 0) {
+      snprintf(label, sizeof(label), "%s[%d]", n.name, n.key);
+    } else {
+      snprintf(label, sizeof(label), "%s", n.name);
+    }
+    std::string path = parent_path.empty() ? std::string(label) : parent_path + "/" + label;
+    int64_t self = n.nanoseconds - child_nanoseconds(nodes, node);
+    fprintf(out.csv, "%s,%d,%ld,%.6f,%.6f\n", path.c_str(), depth, n.calls, seconds(n.nanoseconds), seconds(self));
+
+    std::string indent(2 * depth + 4, ' ');
+    fprintf(out.json, "%s{\"name\": \"%s\", ", indent.c_str(), n.name);
+    if(n.key >= 0) {
+      fprintf(out.json, "\"key\": %d, ", n.key);
+    }
+    fprintf(out.json, "\"calls\": %ld, \"seconds\": %.6f, \"self_seconds\": %.6f", n.calls, seconds(n.nanoseconds), seconds(self));
+    if(n.first_child >= 0) {
+      fprintf(out.json, ", \"children\": [\n");
+      for(int child = n.first_child; child >= 0; child = nodes[child].next_sibling) {
+        write_node(out, nodes, child, path, depth + 1);
+        fprintf(out.json, "%s\n", nodes[child].next_sibling >= 0 ? "," : "");
+      }
+      fprintf(out.json, "%s]", indent.c_str());
+    }
+    fprintf(out.json, "}");
+  }
+
+}
+
+void Profile::report(const char* directory, int run) {
+  if(!Profile::Enabled) {
+    return;
+  }
+  std::vector<Node> nodes = Profile::Threads[0].nodes;
+  for(int t = 1; t < fred::omp_get_max_threads(); ++t) {
+    merge(Profile::Threads[t].nodes, 0, nodes, 0);
+  }
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - Profile_start;
+  nodes[0].calls = 1;
+  nodes[0].nanoseconds = elapsed.count();
+
+  char filename[FRED_STRING_SIZE];
+  Report_Context out;
+  sprintf(filename, "%s/profile%d.json", directory, run);
+  out.json = fopen(filename, "w");
+  sprintf(filename, "%s/profile%d.csv", directory, run);
+  out.csv = fopen(filename, "w");
+  if(out.json == NULL || out.csv == NULL) {
+    FRED_WARNING("Help! Can't write profile to %s\n", directory);
+    if(out.json != NULL) {
+      fclose(out.json);
+    }
+    if(out.csv != NULL) {
+      fclose(out.csv);
+    }
+    return;
+  }
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  fprintf(out.json, "{\n  \"run\": %d,\n  \"threads\": %d,\n  \"maxrss_kb\": %ld,\n", run, fred::omp_get_max_threads(), usage.ru_maxrss);
+  fprintf(out.json, "  \"user_seconds\": %.6f,\n  \"system_seconds\": %.6f,\n",
+          usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec, usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec);
+  fprintf(out.json, "  \"regions\":\n");
+  fprintf(out.csv, "path,depth,calls,seconds,self_seconds\n");
+  write_node(out, nodes, 0, std::string(), 0);
+  fprintf(out.json, "\n}\n");
+  fclose(out.json);
+  fclose(out.csv);
+}
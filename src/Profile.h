@@ -0,0 +1,159 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Profile.h
+//
+// Hierarchical timing of the phases of a run.  A region is opened with
+//
+//   FRED_PROFILE("name");           or   FRED_PROFILE("name", key);
+//
+// and closed at the end of the enclosing block.  A sequence of phases in
+// one block is timed with
+//
+//   FRED_PROFILE_PHASES(phases);
+//   FRED_PROFILE_PHASE(phases, "first");  ...  FRED_PROFILE_PHASE(phases, "second");  ...
+//
+// where each phase ends when the next one starts or the block ends.
+// Regions opened inside another region are nested under it, and a region
+// reached along the same path again (e.g. on every day) adds to the same
+// entry.  The key
+// separates instances of a region, such as one disease from another.
+// Each thread keeps its own tree; the trees are merged at the end of the
+// run and written as profile<run>.json and profile<run>.csv in the
+// output directory.
+//
+// Regions are compiled in only with -DFREDPROFILE and record only when
+// enable_profile is set, so a disabled region costs one test of a
+// static flag.
+//
+
+#ifndef _FRED_PROFILE_H
+#define _FRED_PROFILE_H
+
+#include <chrono>
+#include <stdint.h>
+#include <vector>
+
+class Profile {
+public:
+  static void get_parameters();
+
+  static bool is_enabled() {
+    return Profile::Enabled;
+  }
+
+  /**
+   * Open the region name/key under the calling thread's current region
+   * and return its index.
+   */
+  static int enter(const char* name, int key);
+
+  /**
+   * Close region node of the calling thread, adding the elapsed time.
+   */
+  static void leave(int node, int64_t nanoseconds);
+
+  /**
+   * Write the merged profile of all threads for this run.
+   */
+  static void report(const char* directory, int run);
+
+private:
+  struct Node {
+    const char* name;
+    int key;
+    int parent;
+    int first_child;
+    int next_sibling;
+    long calls;
+    int64_t nanoseconds;
+  };
+
+  struct Thread_Profile {
+    std::vector<Node> nodes;
+    int current;
+  };
+
+  static int add_child(std::vector<Node> &nodes, int parent, const char* name, int key);
+  static void merge(const std::vector<Node> &from, int from_node, std::vector<Node> &to, int to_node);
+
+  static bool Enabled;
+  static Thread_Profile* Threads;
+};
+
+class Profile_Region {
+public:
+  Profile_Region(const char* name, int key = -1) {
+    this->node = -1;
+    if(Profile::is_enabled()) {
+      this->node = Profile::enter(name, key);
+      this->start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~Profile_Region() {
+    if(this->node >= 0) {
+      std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - this->start;
+      Profile::leave(this->node, elapsed.count());
+    }
+  }
+
+private:
+  int node;
+  std::chrono::steady_clock::time_point start;
+};
+
+class Profile_Phases {
+public:
+  Profile_Phases() {
+    this->node = -1;
+  }
+
+  ~Profile_Phases() {
+    end();
+  }
+
+  void next(const char* name, int key = -1) {
+    end();
+    if(Profile::is_enabled()) {
+      this->node = Profile::enter(name, key);
+      this->start = std::chrono::steady_clock::now();
+    }
+  }
+
+private:
+  void end() {
+    if(this->node >= 0) {
+      std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - this->start;
+      Profile::leave(this->node, elapsed.count());
+      this->node = -1;
+    }
+  }
+
+  int node;
+  std::chrono::steady_clock::time_point start;
+};
+
+#ifdef FREDPROFILE
+#define FRED_PROFILE_JOIN(a, b) a##b
+#define FRED_PROFILE_REGION(line) FRED_PROFILE_JOIN(fred_profile_region_, line)
+#define FRED_PROFILE(...) Profile_Region FRED_PROFILE_REGION(__LINE__)(__VA_ARGS__)
+#define FRED_PROFILE_PHASES(phases) Profile_Phases phases
+#define FRED_PROFILE_PHASE(phases, ...) phases.next(__VA_ARGS__)
+#else
+#define FRED_PROFILE(...)
+#define FRED_PROFILE_PHASES(phases)
+#define FRED_PROFILE_PHASE(phases, ...)
+#endif
+
+#endif // _FRED_PROFILE_H
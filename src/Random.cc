@@ -19,7 +19,19 @@
 Thread_RNG Random::Random_Number_Generator;
 
 Thread_RNG::Thread_RNG() {
-  thread_rng = new RNG [fred::omp_get_max_threads()];
+  int threads = fred::omp_get_max_threads();
+  thread_state = new Thread_State [threads];
+  for(int t = 0; t < threads; ++t) {
+    thread_state[t].in_stream = false;
+  }
+  metaseed = 0;
+}
+
+// splitmix64 finalizer; spreads nearby metaseeds over the whole key space
+static unsigned long mix_bits(unsigned long z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+  return z ^ (z >> 31);
 }
 
 void Thread_RNG::set_seed(unsigned long metaseed) {
@@ -27,16 +39,27 @@ void Thread_RNG::set_seed(unsigned long metaseed) {
   seed_generator.seed(metaseed);
   for(int t = 0; t < fred::omp_get_max_threads(); ++t) {
     unsigned long new_seed = seed_generator();
-    thread_rng[t].set_seed(new_seed);
+    thread_state[t].rng.set_seed(new_seed);
+    thread_state[t].stream_rng.set_seed(mix_bits(metaseed));
   }
+  this->metaseed = metaseed;
 }
 
+void Thread_RNG::begin_stream(int kind, int day, int disease_id, int id) {
+  Thread_State & state = thread_state[fred::omp_get_thread_num()];
+  uint32_t tag = ((uint32_t) disease_id << 8) | (uint32_t) kind;
+  state.stream_rng.get_engine().set_stream((uint32_t) id, (uint32_t) day, tag);
+  state.stream_rng.reset();
+  state.in_stream = true;
+}
 
-void RNG::set_seed(unsigned long seed) {
-  mt_engine.seed(seed);
+template <class Engine>
+void Basic_RNG<Engine>::set_seed(unsigned long seed) {
+  engine.seed(seed);
 }
 
-int RNG::draw_from_distribution(int n, double* dist) {
+template <class Engine>
+int Basic_RNG<Engine>::draw_from_distribution(int n, double* dist) {
   double r = random();
   int i = 0;
   while(i <= n && dist[i] < r) {
@@ -55,22 +78,39 @@ int RNG::draw_from_distribution(int n, double* dist) {
   }
 }
 
-double RNG::exponential(double lambda) {
+template <class Engine>
+double Basic_RNG<Engine>::exponential(double lambda) {
   double u = random();
   return (-log(u) / lambda);
 }
 
-double RNG::normal(double mu, double sigma) {
-  return mu + sigma * normal_dist(mt_engine);
+// the number of successes in n trials with probability p (0 if n <= 0)
+template <class Engine>
+int Basic_RNG<Engine>::binomial(int n, double p) {
+  if(n <= 0 || p <= 0.0) {
+    return 0;
+  }
+  if(p >= 1.0) {
+    return n;
+  }
+  std::binomial_distribution<int> dist(n, p);
+  return dist(engine);
+}
+
+template <class Engine>
+double Basic_RNG<Engine>::normal(double mu, double sigma) {
+  return mu + sigma * normal_dist(engine);
 }
 
-double RNG::lognormal(double mu, double sigma) {
+template <class Engine>
+double Basic_RNG<Engine>::lognormal(double mu, double sigma) {
   double z = normal(0.0,1.0);
   return exp(mu + sigma * z);
 }
 
 
-int RNG::draw_from_cdf(double* v, int size) {
+template <class Engine>
+int Basic_RNG<Engine>::draw_from_cdf(double* v, int size) {
   double r = random();
   int top = size - 1;
   int bottom = 0;
@@ -98,7 +138,8 @@ int RNG::draw_from_cdf(double* v, int size) {
   return -1;
 }
 
-int RNG::draw_from_cdf_vector(const vector<double>& v) {
+template <class Engine>
+int Basic_RNG<Engine>::draw_from_cdf_vector(const vector<double>& v) {
   int size = v.size();
   double r = random();
   int top = size - 1;
@@ -141,7 +182,8 @@ double binomial_coefficient(int n, int k) {
   return c;
 }
 
-void RNG::build_binomial_cdf(double p, int n, std::vector<double> &cdf) {
+template <class Engine>
+void Basic_RNG<Engine>::build_binomial_cdf(double p, int n, std::vector<double> &cdf) {
   for(int i = 0; i <= n; ++i) {
     double prob = 0.0;
     for(int j = 0; j <= i; ++j) {
@@ -161,7 +203,8 @@ void RNG::build_binomial_cdf(double p, int n, std::vector<double> &cdf) {
   cdf.back() = 1.0;
 }
 
-void RNG::build_lognormal_cdf(double mu, double sigma, std::vector<double> &cdf) {
+template <class Engine>
+void Basic_RNG<Engine>::build_lognormal_cdf(double mu, double sigma, std::vector<double> &cdf) {
   int maxval = -1;
   int count[1000];
   for(int i = 0; i < 1000; i++) {
@@ -193,7 +236,8 @@ void RNG::build_lognormal_cdf(double mu, double sigma, std::vector<double> &cdf)
   cdf.back() = 1.0;
 }
 
-void RNG::sample_range_without_replacement(int N, int s, int* result) {
+template <class Engine>
+void Basic_RNG<Engine>::sample_range_without_replacement(int N, int s, int* result) {
   std::vector<bool> selected(N, false);
   for(int n = 0; n < s; ++n) {
     int i = random_int(0, N - 1);
@@ -212,4 +256,48 @@ void RNG::sample_range_without_replacement(int N, int s, int* result) {
   }
 }
 
+void Alias_Table::set_cdf(const double* cdf, int size) {
+  this->cdf.assign(cdf, cdf + size);
+  this->prob.assign(size, 1.0);
+  this->alias.resize(size);
+  if(size == 0) {
+    return;
+  }
+
+  // Vose's method: scale the probabilities to mean 1, then repeatedly
+  // fill a column that is under 1 with its shortfall from one that is over
+  double total = cdf[size - 1];
+  std::vector<int> small;
+  std::vector<int> large;
+  for(int i = 0; i < size; ++i) {
+    double p = cdf[i] - (i > 0 ? cdf[i - 1] : 0.0);
+    this->prob[i] = (p > 0.0 && total > 0.0) ? p * size / total : 0.0;
+    this->alias[i] = i;
+    if(this->prob[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while(!small.empty() && !large.empty()) {
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+    this->alias[s] = l;
+    this->prob[l] -= 1.0 - this->prob[s];
+    if(this->prob[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // whatever is left is 1 up to rounding error
+  for(size_t i = 0; i < small.size(); ++i) {
+    this->prob[small[i]] = 1.0;
+  }
+  for(size_t i = 0; i < large.size(); ++i) {
+    this->prob[large[i]] = 1.0;
+  }
+}
 
+template class Basic_RNG<std::mt19937_64>;
+template class Basic_RNG<Philox_Engine>;
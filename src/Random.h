@@ -17,22 +17,93 @@
 #ifndef _FRED_RANDOM_H
 #define _FRED_RANDOM_H
 
+#include <stdint.h>
+#include <algorithm>
 #include <vector>
 #include <random>
 #include "Global.h"
 using namespace std;
 
-class RNG {
+// Philox4x32-10 counter-based engine (Salmon et al., SC11).  Each
+// output block is a pure function of (key, counter), so a stream can be
+// positioned anywhere in O(1) without carrying generator state between
+// days or threads.  The counter holds the draw index in its low word and
+// the stream coordinates (entity id, day, disease and stream kind) in the
+// other three.
+class Philox_Engine {
+public:
+  typedef uint64_t result_type;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~(result_type) 0; }
+
+  Philox_Engine() {
+    seed(0);
+  }
+  void seed(uint64_t seed) {
+    this->key[0] = (uint32_t) seed;
+    this->key[1] = (uint32_t) (seed >> 32);
+    set_stream(0, 0, 0);
+  }
+  void set_stream(uint32_t id, uint32_t day, uint32_t tag) {
+    this->counter[0] = 0;
+    this->counter[1] = id;
+    this->counter[2] = day;
+    this->counter[3] = tag;
+    this->next = 2;
+  }
+  result_type operator()() {
+    if(this->next == 2) {
+      generate();
+    }
+    return this->block[this->next++];
+  }
+
+private:
+  void generate() {
+    uint32_t c0 = this->counter[0], c1 = this->counter[1];
+    uint32_t c2 = this->counter[2], c3 = this->counter[3];
+    uint32_t k0 = this->key[0], k1 = this->key[1];
+    for(int round = 0; round < 10; ++round) {
+      uint64_t p0 = (uint64_t) 0xD2511F53 * c0;
+      uint64_t p1 = (uint64_t) 0xCD9E8D57 * c2;
+      c0 = (uint32_t) (p1 >> 32) ^ c1 ^ k0;
+      c1 = (uint32_t) p1;
+      c2 = (uint32_t) (p0 >> 32) ^ c3 ^ k1;
+      c3 = (uint32_t) p0;
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+    this->block[0] = ((uint64_t) c0 << 32) | c1;
+    this->block[1] = ((uint64_t) c2 << 32) | c3;
+    this->next = 0;
+    ++this->counter[0];
+  }
+
+  uint32_t key[2];
+  uint32_t counter[4];
+  uint64_t block[2];
+  int next;
+};
+
+template <class Engine>
+class Basic_RNG {
 
 public:
   void set_seed(unsigned long seed);
+  void reset() {
+    normal_dist.reset();
+  }
+  Engine & get_engine() {
+    return engine;
+  }
   double random() {
-    return unif_dist(mt_engine);
+    return unif_dist(engine);
   }
   int random_int(int low, int high) {
     return low + (int) ((high - low + 1) * random());
   }
   double exponential(double lambda);
+  int binomial(int n, double p);
   int draw_from_distribution(int n, double *dist);
   double normal(double mu, double sigma);
   double lognormal(double mu, double sigma);
@@ -43,55 +114,87 @@ public:
   void sample_range_without_replacement(int N, int s, int* result);
 
 private:
-  std::mt19937_64 mt_engine;
+  Engine engine;
   std::uniform_real_distribution<double> unif_dist;
   std::normal_distribution<double> normal_dist;
 };
 
+// sequential per-thread generator used outside of keyed streams
+typedef Basic_RNG<std::mt19937_64> RNG;
+
+// counter-based generator used inside keyed streams
+typedef Basic_RNG<Philox_Engine> Stream_RNG;
+
+// draws from the active keyed stream if the calling thread has one,
+// otherwise from the thread's sequential generator
+#define THREAD_RNG_DRAW(call) \
+  Thread_State & state = this->thread_state[fred::omp_get_thread_num()]; \
+  return state.in_stream ? state.stream_rng.call : state.rng.call
 
 class Thread_RNG {
 public:
   Thread_RNG();
 
   void set_seed(unsigned long seed);
+
+  // While a stream is active, the calling thread draws from a Philox
+  // generator keyed by the metaseed and positioned by (kind, day, disease,
+  // id, draw index), so the draws do not depend on which thread runs the
+  // work or in what order.
+  void begin_stream(int kind, int day, int disease_id, int id);
+  void end_stream() {
+    this->thread_state[fred::omp_get_thread_num()].in_stream = false;
+  }
+
   double get_random() {
-    return thread_rng[fred::omp_get_thread_num()].random();
+    THREAD_RNG_DRAW(random());
   }
   double get_random(double low, double high) {
-    return low + (high-low)*thread_rng[fred::omp_get_thread_num()].random();
+    return low + (high-low)*get_random();
   }
   int get_random_int(int low, int high) {
-    return thread_rng[fred::omp_get_thread_num()].random_int(low,high);
+    THREAD_RNG_DRAW(random_int(low,high));
   }
   int draw_from_cdf(double *v, int size) {
-    return thread_rng[fred::omp_get_thread_num()].draw_from_cdf(v, size);
+    THREAD_RNG_DRAW(draw_from_cdf(v, size));
   }
   int draw_from_cdf_vector(const std::vector <double>& v) {
-    return thread_rng[fred::omp_get_thread_num()].draw_from_cdf_vector(v);
+    THREAD_RNG_DRAW(draw_from_cdf_vector(v));
   }
   int draw_from_distribution(int n, double *dist) {
-    return thread_rng[fred::omp_get_thread_num()].draw_from_distribution(n, dist);
+    THREAD_RNG_DRAW(draw_from_distribution(n, dist));
   }
   double exponential(double lambda) {
-    return thread_rng[fred::omp_get_thread_num()].exponential(lambda);
+    THREAD_RNG_DRAW(exponential(lambda));
+  }
+  int binomial(int n, double p) {
+    THREAD_RNG_DRAW(binomial(n, p));
   }
   double normal(double mu, double sigma) {
-    return thread_rng[fred::omp_get_thread_num()].normal(mu, sigma);
+    THREAD_RNG_DRAW(normal(mu, sigma));
   }
   double lognormal(double mu, double sigma) {
-    return thread_rng[fred::omp_get_thread_num()].lognormal(mu, sigma);
+    THREAD_RNG_DRAW(lognormal(mu, sigma));
   }
   void build_binomial_cdf(double p, int n, std::vector<double> &cdf) {
-    thread_rng[fred::omp_get_thread_num()].build_binomial_cdf(p, n, cdf);
+    THREAD_RNG_DRAW(build_binomial_cdf(p, n, cdf));
   }
   void sample_range_without_replacement(int N, int s, int* result) {
-    thread_rng[fred::omp_get_thread_num()].sample_range_without_replacement(N, s, result);
+    THREAD_RNG_DRAW(sample_range_without_replacement(N, s, result));
   }
 
 private:
-  RNG * thread_rng;
+  struct Thread_State {
+    RNG rng;
+    Stream_RNG stream_rng;
+    bool in_stream;
+  };
+  Thread_State * thread_state;
+  unsigned long metaseed;
 };
 
+#undef THREAD_RNG_DRAW
+
 class Random {
 public:
   static void set_seed(unsigned long seed) { 
@@ -109,6 +212,9 @@ public:
   static double draw_exponential(double lambda) { 
     return Random_Number_Generator.exponential(lambda);
   }
+  static int draw_binomial(int n, double p) { 
+    return Random_Number_Generator.binomial(n,p);
+  }
   static double draw_normal(double mu, double sigma) { 
     return Random_Number_Generator.normal(mu,sigma);
   }
@@ -131,10 +237,77 @@ public:
     Random_Number_Generator.sample_range_without_replacement(N,s,result);
   }
 
+  // keyed streams for work that must give the same results for any
+  // number of threads (e.g. parallel transmission)
+  enum {
+    PLACE_STREAM,
+    PERSON_STREAM,
+    VECTOR_STREAM,
+    INITIAL_STATE_STREAM
+  };
+  static void begin_stream(int day, int disease_id, int place_id) {
+    Random_Number_Generator.begin_stream(PLACE_STREAM, day, disease_id, place_id);
+  }
+  static void begin_person_stream(int day, int disease_id, int person_id) {
+    Random_Number_Generator.begin_stream(PERSON_STREAM, day, disease_id, person_id);
+  }
+  static void begin_vector_stream(int day, int vector_slot) {
+    Random_Number_Generator.begin_stream(VECTOR_STREAM, day, 0, vector_slot);
+  }
+  static void begin_initial_state_stream(int disease_id, int person_id) {
+    Random_Number_Generator.begin_stream(INITIAL_STATE_STREAM, 0, disease_id, person_id);
+  }
+  static void end_stream() {
+    Random_Number_Generator.end_stream();
+  }
+
 private:
   static Thread_RNG Random_Number_Generator;
 };
 
+// Draws from a fixed discrete distribution over 0 .. size-1, given by
+// its cdf.  With enable_alias_sampling the cdf is turned into a
+// Walker/Vose alias table once, and each draw takes O(1) time: one
+// uniform picks a column and, by its fractional part, either the column
+// or its alias.  Otherwise a draw inverts the cdf by binary search,
+// giving the same values as draw_from_cdf_vector for the same
+// random number.  Either way a draw
+// uses exactly one random number, and an empty table draws -1, as
+// draw_from_cdf_vector does.
+class Alias_Table {
+public:
+  Alias_Table() {
+  }
+
+  void set_cdf(const double* cdf, int size);
+  void set_cdf(const std::vector<double> &cdf) {
+    set_cdf(cdf.data(), cdf.size());
+  }
+
+  int size() const {
+    return this->cdf.size();
+  }
+
+  int draw() const {
+    int n = this->cdf.size();
+    double r = Random::draw_random();
+    if(Global::Enable_Alias_Sampling && n > 0) {
+      double x = r * n;
+      int column = static_cast<int>(x);
+      if(column >= n) {
+        column = n - 1;
+      }
+      return (x - column < this->prob[column]) ? column : this->alias[column];
+    }
+    int i = std::lower_bound(this->cdf.begin(), this->cdf.end(), r) - this->cdf.begin();
+    return (i < n) ? i : n - 1;
+  }
+
+private:
+  std::vector<double> cdf;
+  std::vector<double> prob;
+  std::vector<int> alias;
+};
 
 template <typename T> 
 void FYShuffle( std::vector <T> &array){
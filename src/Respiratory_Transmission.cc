@@ -16,9 +16,11 @@
 #include <algorithm>
 
 #include "Respiratory_Transmission.h"
+#include "Contact_Sampler.h"
 #include "Date.h"
 #include "Disease.h"
 #include "Disease_List.h"
+#include "Epidemic.h"
 #include "Global.h"
 #include "Household.h"
 #include "Params.h"
@@ -32,13 +34,17 @@ Respiratory_Transmission::Respiratory_Transmission() {
   this->enable_neighborhood_density_transmission = false;
   this->enable_density_transmission_maximum_infectees = false;
   this->density_transmission_maximum_infectees = 10.0;
+  this->enable_skip_contact_sampling = false;
   this->prob_contact = NULL;
+  this->defer_infections = false;
+  this->buffer = new Transmission_Buffer [fred::omp_get_max_threads()];
 }
 
 Respiratory_Transmission::~Respiratory_Transmission() {
   if(this->prob_contact != NULL) {
     delete[] this->prob_contact;
   }
+  delete[] this->buffer;
 }
 
 void Respiratory_Transmission::setup(Disease* disease) {
@@ -49,6 +55,8 @@ void Respiratory_Transmission::setup(Disease* disease) {
   this->enable_density_transmission_maximum_infectees = (temp_int == 1);
   Params::get_param_from_string("density_transmission_maximum_infectees",
 				&(this->density_transmission_maximum_infectees));
+  Params::get_param_from_string("enable_skip_contact_sampling", &temp_int);
+  this->enable_skip_contact_sampling = (temp_int == 1);
 
   /*
   Respiratory_Transmission::prob_contact = new double * [101];
@@ -118,6 +126,8 @@ void Respiratory_Transmission::spread_infection(int day, int disease_id, Place*
 
   if(place->is_neighborhood() && this->enable_neighborhood_density_transmission == true) {
     density_transmission_model(day, disease_id, place);
+  } else if(this->enable_skip_contact_sampling) {
+    skip_sampling_transmission_model(day, disease_id, place);
   } else {
     default_transmission_model(day, disease_id, place);
   }
@@ -134,15 +144,94 @@ void Respiratory_Transmission::spread_infection(int day, int disease_id, Place*
 
   return;
 }
+void Respiratory_Transmission::spread_infection_in_parallel(int day, int disease_id, place_vector_t &places) {
+
+  int number_of_places = places.size();
+  FRED_VERBOSE(1, "spread_infection_in_parallel day %d disease %d places %d\n",
+	       day, disease_id, number_of_places);
+
+  // Closure decisions and schedule updates draw random numbers and touch
+  // shared state, so make them serially, in place order, before the
+  // parallel pass.  Afterwards is_present() is read-only for enrollees.
+  for(int p = 0; p < number_of_places; ++p) {
+    Place* place = places[p];
+    if(place->is_open(day) == false || place->should_be_open(day, disease_id) == false) {
+      continue;
+    }
+    person_vec_t* enrollees = place->get_enrollees();
+    int size = enrollees->size();
+    for(int i = 0; i < size; ++i) {
+      (*enrollees)[i]->update_schedule(day);
+    }
+  }
+
+  // where each place's infections were recorded
+  std::vector<int> thread_of_place(number_of_places);
+  std::vector<int> first_infection(number_of_places);
+  std::vector<int> last_infection(number_of_places);
+
+  this->defer_infections = true;
+#pragma omp parallel for schedule(dynamic, 16)
+  for(int p = 0; p < number_of_places; ++p) {
+    int t = fred::omp_get_thread_num();
+    Transmission_Buffer* buf = &(this->buffer[t]);
+    Place* place = places[p];
+    buf->place_start = buf->infections.size();
+    Random::begin_stream(day, disease_id, place->get_id());
+    spread_infection(day, disease_id, place);
+    Random::end_stream();
+    place->clear_infectious_people(disease_id);
+    thread_of_place[p] = t;
+    first_infection[p] = buf->place_start;
+    last_infection[p] = buf->infections.size();
+  }
+  this->defer_infections = false;
+
+  // commit the new infections in place order
+  Epidemic* epidemic = Global::Diseases.get_disease(disease_id)->get_epidemic();
+  for(int p = 0; p < number_of_places; ++p) {
+    std::vector<Pending_Infection> &infections = this->buffer[thread_of_place[p]].infections;
+    for(int i = first_infection[p]; i < last_infection[p]; ++i) {
+      Person* infectee = infections[i].infectee;
+      // a person enrolled in two places of this type may be infected in both
+      if(infectee->is_susceptible(disease_id) == false) {
+	continue;
+      }
+      infections[i].infector->infect(infectee, disease_id, infections[i].place, day);
+      epidemic->become_exposed(infectee, day);
+    }
+  }
+  for(int t = 0; t < fred::omp_get_max_threads(); ++t) {
+    this->buffer[t].infections.clear();
+  }
+}
+
 /////////////////////////////////////////
 //
 // RESPIRATORY TRANSMISSION MODELS
 //
 /////////////////////////////////////////
 
+bool Respiratory_Transmission::is_susceptible(Person* infectee, int disease_id) {
+  if(infectee->is_susceptible(disease_id) == false) {
+    return false;
+  }
+  if(this->defer_infections) {
+    // an infection already found in this place counts as if it had been applied
+    Transmission_Buffer* buf = &(this->buffer[fred::omp_get_thread_num()]);
+    int size = buf->infections.size();
+    for(int i = buf->place_start; i < size; ++i) {
+      if(buf->infections[i].infectee == infectee) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 
 bool Respiratory_Transmission::attempt_transmission(double transmission_prob, Person* infector, Person* infectee,
-					int disease_id, int day, Place* place) {
+					int disease_id, int day, Place* place, int contacts) {
 
   assert(infectee->is_susceptible(disease_id));
   FRED_STATUS(1, "infector %d -- infectee %d is susceptible\n", infector->get_id(), infectee->get_id());
@@ -175,8 +264,17 @@ bool Respiratory_Transmission::attempt_transmission(double transmission_prob, Pe
 
   double r = Random::draw_random();
   double infection_prob = transmission_prob * susceptibility;
+  infection_prob = Contact_Sampler::prob_of_any(infection_prob, contacts);
 
   if(r < infection_prob) {
+    if(this->defer_infections) {
+      // successful transmission; spread_infection_in_parallel() creates the infection
+      Pending_Infection pending = { infector, infectee, place };
+      this->buffer[fred::omp_get_thread_num()].infections.push_back(pending);
+      FRED_VERBOSE(1, "transmission deferred: r = %f  prob = %f\n", r, infection_prob);
+      return true;
+    }
+
     // successful transmission; create a new infection in infectee
     infector->infect(infectee, disease_id, place, day);
 
@@ -241,21 +339,7 @@ void Respiratory_Transmission::default_transmission_model(int day, int disease_i
 
     std::map<int, int> sampling_map;
     // get a susceptible target for each contact resulting in infection
-    for(int c = 0; c < contact_count; ++c) {
-      // select a target infectee from among susceptibles with replacement
-      int pos = Random::draw_random_int(0, number_targets - 1);
-      if(pos < susceptibles->size()) {
-        if(infector == (*susceptibles)[pos]) {
-          if(susceptibles->size() > 1) {
-            --(c); // redo
-            continue;
-          } else {
-            break; // give up
-          }
-        }
-        sampling_map[pos]++;
-      }
-    }
+    Contact_Sampler::draw_contacts(contact_count, number_targets, *susceptibles, infector, sampling_map);
 
     std::map<int, int>::iterator i;
     for(i = sampling_map.begin(); i != sampling_map.end(); ++i) {
@@ -276,7 +360,7 @@ void Respiratory_Transmission::default_transmission_model(int day, int disease_i
       }
       for(int draw = 0; draw < times_drawn; ++draw) {
         // only proceed if person is susceptible
-        if(infectee->is_susceptible(disease_id)) {
+        if(is_susceptible(infectee, disease_id)) {
           attempt_transmission(transmission_prob, infector, infectee, disease_id, day, place);
         }
       }
@@ -285,6 +369,65 @@ void Respiratory_Transmission::default_transmission_model(int day, int disease_i
   place->reset_place_state(disease_id);
 }
 
+// Same contact process as default_transmission_model, but the contacts of
+// each infector are placed with a Contact_Sampler instead of one draw (and
+// one map entry) per contact, and the repeated attempts on a target are
+// collapsed into one.  The infector's own slot is removed from the range
+// instead of being redrawn.  The infectious list is processed in order,
+// as the default model does in practice (its shuffle index is empty).
+void Respiratory_Transmission::skip_sampling_transmission_model(int day, int disease_id, Place* place) {
+  int N = place->get_size();
+
+  person_vec_t* infectious = place->get_infectious_people(disease_id);
+  person_vec_t* susceptibles = place->get_enrollees();
+  int number_of_susceptibles = susceptibles->size();
+
+  FRED_VERBOSE(1, "skip_sampling_transmission DAY %d PLACE %s N %d susc %d inf %d\n",
+	       day, place->get_label(), N, number_of_susceptibles, (int) infectious->size());
+
+  // possible infectees per infector, as in default_transmission_model
+  int number_targets = (N - 1 > number_of_susceptibles ? N - 1 : number_of_susceptibles);
+
+  double contact_rate = place->get_contact_rate(day, disease_id);
+
+  int number_of_infectious = infectious->size();
+  for(int n = 0; n < number_of_infectious; ++n) {
+    Person* infector = (*infectious)[n];
+    if(infector->is_infectious(disease_id) == false) {
+      continue;
+    }
+
+    int contact_count = place->get_contact_count(infector, disease_id, day, contact_rate);
+
+    // the infector's own slot, if it is among the enrollees
+    int self = infector->get_enrollee_index(place);
+    if(self < 0 || self >= number_of_susceptibles || (*susceptibles)[self] != infector) {
+      self = std::find(susceptibles->begin(), susceptibles->end(), infector) - susceptibles->begin();
+      if(self == number_of_susceptibles) {
+        self = -1;
+      }
+    }
+    Contact_Targets targets(contact_count, number_targets, number_of_susceptibles, self);
+    while(targets.next()) {
+      Person* infectee = (*susceptibles)[targets.get_target()];
+      infectee->update_schedule(day);
+      if(!infectee->is_present(day, place)) {
+        continue;
+      }
+      double transmission_prob = 1.0;
+      if(Global::Enable_Transmission_Bias) {
+        transmission_prob = place->get_transmission_probability(disease_id, infector, infectee);
+      } else {
+        transmission_prob = place->get_transmission_prob(disease_id, infector, infectee);
+      }
+      if(is_susceptible(infectee, disease_id)) {
+        attempt_transmission(transmission_prob, infector, infectee, disease_id, day, place, targets.get_hits());
+      }
+    }
+  }
+  place->reset_place_state(disease_id);
+}
+
 
 void Respiratory_Transmission::pairwise_transmission_model(int day, int disease_id, Place* place) {
 
@@ -332,7 +475,7 @@ void Respiratory_Transmission::pairwise_transmission_model(int day, int disease_
 	      continue;
       }
       // only proceed if person is susceptible
-      if(infectee->is_susceptible(disease_id)) {
+      if(is_susceptible(infectee, disease_id)) {
 	      FRED_VERBOSE(1, "pairwise_transmission DAY %d PLACE %s infectee %d is present and susceptible\n",
 		                 day, label, infectee_id);
 	      // get the transmission probs for infector/infectee pair
@@ -408,7 +551,7 @@ void Respiratory_Transmission::density_transmission_model(int day, int disease_i
     FRED_VERBOSE(1,"selected host %d age %d\n", infectee->get_id(), infectee->get_age());
 
     // only proceed if person is susceptible
-    if(infectee->is_susceptible(disease_id)) {
+    if(is_susceptible(infectee, disease_id)) {
       // select a random infector
       int infector_pos = Random::draw_random_int(0,inf_hosts-1);
       Person* infector = (*infectious)[infector_pos];
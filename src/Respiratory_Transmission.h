@@ -17,6 +17,9 @@
 #ifndef _FRED_RESPIRATORY_TRANSMISSION_H
 #define _FRED_RESPIRATORY_TRANSMISSION_H
 
+#include <vector>
+
+#include "Global.h"
 #include "Transmission.h"
 class Disease;
 class Mixing_Group;
@@ -33,20 +36,59 @@ public:
   void spread_infection(int day, int disease_id, Mixing_Group* mixing_group);
   void spread_infection(int day, int disease_id, Place* place);
 
+  /**
+   * Spread infection in each of the given places in parallel.  Infections
+   * found in a place are buffered by the thread that processed it and are
+   * committed after all places are done, in the order of the places vector.
+   * Each place draws from its own random stream, so the results do not
+   * depend on the number of threads.
+   *
+   * @param day the simulation day
+   * @param disease_id the disease being spread
+   * @param places the active places, in commit order
+   */
+  void spread_infection_in_parallel(int day, int disease_id, place_vector_t &places);
+
 private:
 
+  // an infection found during a parallel pass, not yet applied
+  struct Pending_Infection {
+    Person* infector;
+    Person* infectee;
+    Place* place;
+  };
+
+  // per-thread buffer of pending infections
+  struct Transmission_Buffer {
+    std::vector<Pending_Infection> infections;
+    int place_start;   // first infection recorded for the current place
+  };
+
   // place-specific transmission mode parameters
   bool enable_neighborhood_density_transmission;
   bool enable_density_transmission_maximum_infectees;
   int density_transmission_maximum_infectees;
+  bool enable_skip_contact_sampling;
   double** prob_contact;
 
+  // set during spread_infection_in_parallel()
+  bool defer_infections;
+  Transmission_Buffer* buffer;
+
   void default_transmission_model(int day, int disease_id, Place* place);
+  void skip_sampling_transmission_model(int day, int disease_id, Place* place);
   void age_based_transmission_model(int day, int disease_id, Place* place);
   void pairwise_transmission_model(int day, int disease_id, Place* place);
   void density_transmission_model(int day, int disease_id, Place* place);
 
-  bool attempt_transmission(double transmission_prob, Person* infector, Person* infectee, int disease_id, int day, Place* place);
+  bool is_susceptible(Person* infectee, int disease_id);
+
+  /**
+   * Try to infect infectee.  With contacts > 1 this is a single draw
+   * standing for that many independent attempts at the same probability.
+   */
+  bool attempt_transmission(double transmission_prob, Person* infector, Person* infectee, int disease_id, int day, Place* place,
+                            int contacts = 1);
 };
 
 
@@ -0,0 +1,217 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Snapshot.cc
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Snapshot.h"
+
+namespace {
+
+  const char MAGIC[8] = { 'F', 'R', 'E', 'D', 'S', 'N', 'A', 'P' };
+
+  struct snapshot_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint64_t key;
+    uint64_t rows;
+    uint32_t columns;
+    uint32_t reserved;
+    uint64_t offset[Snapshot::MAX_COLUMNS];
+    uint64_t bytes[Snapshot::MAX_COLUMNS];
+  };
+
+  uint64_t align8(uint64_t n) {
+    return (n + 7) & ~static_cast<uint64_t>(7);
+  }
+
+}
+
+Snapshot::Snapshot() {
+  this->base = NULL;
+  this->length = 0;
+}
+
+Snapshot::~Snapshot() {
+  close();
+}
+
+bool Snapshot::open(const char* path, int kind, uint64_t key) {
+  close();
+  int fd = ::open(path, O_RDONLY);
+  if(fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(snapshot_header_t)) {
+    ::close(fd);
+    return false;
+  }
+  void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(p == MAP_FAILED) {
+    return false;
+  }
+  this->base = static_cast<const unsigned char*>(p);
+  this->length = st.st_size;
+
+  const snapshot_header_t* header = reinterpret_cast<const snapshot_header_t*>(this->base);
+  bool ok = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION
+    && header->kind == static_cast<uint32_t>(kind) && header->key == key && header->columns <= MAX_COLUMNS;
+  for(uint32_t c = 0; ok && c < header->columns; ++c) {
+    ok = header->offset[c] % 8 == 0 && header->offset[c] <= this->length
+      && header->bytes[c] <= this->length - header->offset[c];
+  }
+  if(!ok) {
+    close();
+  }
+  return ok;
+}
+
+void Snapshot::close() {
+  if(this->base != NULL) {
+    munmap(const_cast<unsigned char*>(this->base), this->length);
+  }
+  this->base = NULL;
+  this->length = 0;
+}
+
+uint64_t Snapshot::get_rows() const {
+  return reinterpret_cast<const snapshot_header_t*>(this->base)->rows;
+}
+
+uint64_t Snapshot::column_offset(int c) const {
+  return reinterpret_cast<const snapshot_header_t*>(this->base)->offset[c];
+}
+
+int64_t Snapshot::get_count(int c, size_t elem_size) const {
+  const snapshot_header_t* header = reinterpret_cast<const snapshot_header_t*>(this->base);
+  if(c < 0 || static_cast<uint32_t>(c) >= header->columns || header->bytes[c] % elem_size != 0) {
+    return -1;
+  }
+  return header->bytes[c] / elem_size;
+}
+
+int64_t Snapshot::get_label_count(int c) const {
+  int64_t n = get_count(c, sizeof(uint32_t));
+  int64_t chars = get_count(c + 1, 1);
+  if(n < 0 || chars < 0) {
+    return -1;
+  }
+  // every label must start inside the char column and be terminated there
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(this->base + column_offset(c));
+  const char* text = reinterpret_cast<const char*>(this->base + column_offset(c + 1));
+  if(chars > 0 && text[chars - 1] != '\0') {
+    return -1;
+  }
+  for(int64_t i = 0; i < n; ++i) {
+    if(offsets[i] >= chars) {
+      return -1;
+    }
+  }
+  return n;
+}
+
+uint64_t Snapshot::get_file_key(const char* path) {
+  struct stat st;
+  if(stat(path, &st) != 0) {
+    return 0;
+  }
+  return mix_key(mix_key(0, st.st_size), st.st_mtime);
+}
+
+uint64_t Snapshot::mix_key(uint64_t key, uint64_t value) {
+  // splitmix64 finalizer over the running key
+  uint64_t z = key + 0x9e3779b97f4a7c15ULL + value;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+int Snapshot_Labels::add(const char* s) {
+  std::pair<std::map<std::string, int>::iterator, bool> result =
+    this->index.insert(std::make_pair(std::string(s), static_cast<int>(this->offsets.size())));
+  if(result.second) {
+    this->offsets.push_back(static_cast<uint32_t>(this->chars.size()));
+    this->chars.insert(this->chars.end(), s, s + strlen(s) + 1);
+  }
+  return result.first->second;
+}
+
+Snapshot_Writer::Snapshot_Writer(int kind, uint64_t key, uint64_t rows) {
+  this->kind = kind;
+  this->key = key;
+  this->rows = rows;
+}
+
+void Snapshot_Writer::add_bytes(const void* data, size_t bytes) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  this->columns.push_back(std::vector<unsigned char>(p, p + bytes));
+}
+
+void Snapshot_Writer::add_labels(const Snapshot_Labels & labels) {
+  add_column(labels.offsets);
+  add_column(labels.chars);
+}
+
+bool Snapshot_Writer::write(const char* path) {
+  if(this->columns.size() > static_cast<size_t>(Snapshot::MAX_COLUMNS)) {
+    return false;
+  }
+  snapshot_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = Snapshot::VERSION;
+  header.kind = this->kind;
+  header.key = this->key;
+  header.rows = this->rows;
+  header.columns = this->columns.size();
+  uint64_t offset = align8(sizeof(header));
+  for(size_t c = 0; c < this->columns.size(); ++c) {
+    header.offset[c] = offset;
+    header.bytes[c] = this->columns[c].size();
+    offset = align8(offset + header.bytes[c]);
+  }
+
+  char temp_path[FILENAME_MAX];
+  snprintf(temp_path, sizeof(temp_path), "%s.tmp-%d", path, static_cast<int>(getpid()));
+  FILE* fp = fopen(temp_path, "wb");
+  if(fp == NULL) {
+    return false;
+  }
+  static const char padding[8] = { 0 };
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  uint64_t position = sizeof(header);
+  for(size_t c = 0; ok && c < this->columns.size(); ++c) {
+    ok = fwrite(padding, 1, header.offset[c] - position, fp) == header.offset[c] - position;
+    if(ok && header.bytes[c] > 0) {
+      ok = fwrite(&this->columns[c][0], 1, header.bytes[c], fp) == header.bytes[c];
+    }
+    position = header.offset[c] + header.bytes[c];
+  }
+  ok = (fclose(fp) == 0) && ok;
+  // the rename is atomic, so a concurrent reader sees either no file or a whole one
+  if(!ok || rename(temp_path, path) != 0) {
+    unlink(temp_path);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,160 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Snapshot.h
+//
+// A Snapshot is a versioned binary file of typed columns.  The header
+// records the kind of data, a 64-bit key describing what it was built
+// from (source file sizes and dates, relevant parameters), the number
+// of rows and a table of column extents; the columns follow, each one
+// aligned to 8 bytes.  A Snapshot is read by mapping the file into
+// memory, so columns are used in place without any parsing.
+//
+// Snapshot_Writer collects columns and writes the file under a temporary
+// name that is renamed into place, so concurrent runs never see a
+// partial file.  Snapshot_Labels packs a table of strings into an offset
+// column and a character column.
+//
+
+#ifndef _FRED_SNAPSHOT_H
+#define _FRED_SNAPSHOT_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Snapshot {
+public:
+
+  enum snapshot_kind_t {
+    PLACES = 1,
+    PEOPLE = 2
+  };
+
+  static const uint32_t VERSION = 1;
+  static const int MAX_COLUMNS = 32;
+
+  Snapshot();
+  ~Snapshot();
+
+  /**
+   * Map the file and check its magic number, version, kind and key.
+   * Returns false (and leaves the Snapshot closed) on any mismatch.
+   */
+  bool open(const char* path, int kind, uint64_t key);
+  void close();
+
+  bool is_open() const {
+    return this->base != NULL;
+  }
+
+  uint64_t get_rows() const;
+
+  /**
+   * Number of elements of size elem_size in column c, or -1 if the
+   * column is missing or its size is not a multiple of elem_size.
+   */
+  int64_t get_count(int c, size_t elem_size) const;
+
+  /**
+   * Column c as an array of count values of type T, or NULL if the
+   * column does not hold exactly that many.
+   */
+  template <class T>
+  const T* get_column(int c, uint64_t count) const {
+    if(get_count(c, sizeof(T)) != static_cast<int64_t>(count)) {
+      return NULL;
+    }
+    return reinterpret_cast<const T*>(this->base + column_offset(c));
+  }
+
+  /**
+   * Label i of the table stored in columns c (offsets) and c+1 (chars).
+   */
+  const char* get_label(int c, int i) const {
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(this->base + column_offset(c));
+    return reinterpret_cast<const char*>(this->base + column_offset(c + 1)) + offsets[i];
+  }
+
+  /**
+   * Number of labels in the table stored in columns c and c+1, or -1 if
+   * the table is malformed.
+   */
+  int64_t get_label_count(int c) const;
+
+  /**
+   * A key summarizing the size and modification time of a file (zero if
+   * the file does not exist), for detecting stale snapshots.
+   */
+  static uint64_t get_file_key(const char* path);
+
+  /**
+   * Fold a value into a key.
+   */
+  static uint64_t mix_key(uint64_t key, uint64_t value);
+
+private:
+  uint64_t column_offset(int c) const;
+
+  const unsigned char* base;
+  size_t length;
+};
+
+class Snapshot_Labels {
+public:
+  /**
+   * Index of label s in the table, adding it if necessary.
+   */
+  int add(const char* s);
+
+  int size() const {
+    return static_cast<int>(this->offsets.size());
+  }
+
+private:
+  friend class Snapshot_Writer;
+  std::map<std::string, int> index;
+  std::vector<uint32_t> offsets;
+  std::vector<char> chars;
+};
+
+class Snapshot_Writer {
+public:
+  Snapshot_Writer(int kind, uint64_t key, uint64_t rows);
+
+  template <class T>
+  void add_column(const std::vector<T> & values) {
+    add_bytes(values.empty() ? NULL : &values[0], values.size() * sizeof(T));
+  }
+
+  // adds two columns (offsets, then chars)
+  void add_labels(const Snapshot_Labels & labels);
+
+  /**
+   * Write the file; returns false if it could not be written.
+   */
+  bool write(const char* path);
+
+private:
+  void add_bytes(const void* data, size_t bytes);
+
+  int kind;
+  uint64_t key;
+  uint64_t rows;
+  std::vector<std::vector<unsigned char> > columns;
+};
+
+#endif // _FRED_SNAPSHOT_H
@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Writes a synthetic population in the 2010_ver1 format, so benchmarks
+// can run at any size without downloading population files.  The places
+// are spread over a box in Jefferson County, PA (FIPS 42065), whose
+// county files ship with FRED; household sizes, ages, school and work
+// assignments follow simple fixed distributions.  The same arguments
+// always give the same files.
+//
+// usage: FRED_Bench_Population directory people [seed]
+//
+// The population is written to directory/bench_<people>/ and its id,
+// bench_<people>, is printed on stdout.
+
+#define LAT_MIN 40.95
+#define LAT_MAX 41.40
+#define LON_MIN -79.30
+#define LON_MAX -78.75
+
+static std::mt19937_64 rng;
+
+static double uniform(double low, double high) {
+  return std::uniform_real_distribution<double>(low, high)(rng);
+}
+
+static int uniform_int(int low, int high) {
+  return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+static FILE* open_file(const string &dir, const string &id, const char* suffix, const char* header) {
+  string path = dir + "/" + id + "_" + suffix;
+  FILE* fp = fopen(path.c_str(), "w");
+  if(fp == NULL) {
+    fprintf(stderr, "can't write %s\n", path.c_str());
+    exit(1);
+  }
+  fprintf(fp, "%s\n", header);
+  return fp;
+}
+
+int main(int argc, char* argv[]) {
+  if(argc < 3) {
+    fprintf(stderr, "usage: FRED_Bench_Population directory people [seed]\n");
+    return 1;
+  }
+  int people = atoi(argv[2]);
+  rng.seed(argc > 3 ? atol(argv[3]) : 12345);
+  char id_buf[64];
+  snprintf(id_buf, sizeof(id_buf), "bench_%d", people);
+  string id = id_buf;
+  string dir = string(argv[1]) + "/" + id;
+  mkdir(argv[1], 0777);
+  mkdir(dir.c_str(), 0777);
+
+  // about 1700 people per school and 11 per workplace, as in the 42065 population
+  int schools = people / 1700 + 1;
+  int workplaces = people / 11 + 1;
+  int tracts = people / 4000 + 1;
+
+  FILE* fp = open_file(dir, id, "schools.txt",
+                       "sp_id,name,stabbr,address,city,county,zipcode,zip4,nces_id,total,prek,kinder,gr01_gr12,ungraded,latitude,longitude,source,stco");
+  for(int s = 0; s < schools; ++s) {
+    fprintf(fp, "%d,\"SCHOOL %d\",\"PA\",,,\"JEFFERSON COUNTY\",,,\"%d\",%d,0,%d,%d,,%.6f,%.6f,\"NCES\",\"42065\"\n",
+            450100000 + s, s, 420000000 + s, 500, 40, 460, uniform(LAT_MIN, LAT_MAX), uniform(LON_MIN, LON_MAX));
+  }
+  fclose(fp);
+
+  fp = open_file(dir, id, "workplaces.txt", "sp_id,workers,latitude,longitude");
+  for(int w = 0; w < workplaces; ++w) {
+    // mostly small workplaces, a few large ones
+    int workers = uniform(0, 1) < 0.9 ? uniform_int(1, 15) : uniform_int(16, 300);
+    fprintf(fp, "%d,%d,%.7f,%.7f\n", 514200000 + w, workers, uniform(LAT_MIN, LAT_MAX), uniform(LON_MIN, LON_MAX));
+  }
+  fclose(fp);
+
+  fclose(open_file(dir, id, "synth_gq.txt", "sp_id,gq_type,persons,stcotrbg,latitude,longitude"));
+  fclose(open_file(dir, id, "synth_gq_people.txt", "sp_id,sp_gq_id,sporder,age,sex"));
+
+  FILE* hh_fp = open_file(dir, id, "synth_households.txt",
+                          "sp_id,serialno,stcotrbg,hh_race,hh_income,hh_size,hh_age,latitude,longitude");
+  FILE* people_fp = open_file(dir, id, "synth_people.txt",
+                              "sp_id,sp_hh_id,serialno,stcotrbg,age,sex,race,sporder,relate,sp_school_id,sp_work_id");
+  // household size distribution, sizes 1 to 7
+  std::discrete_distribution<int> size_dist({ 28, 34, 15, 13, 6, 2.5, 1.5 });
+  int person_id = 164000000;
+  int household_id = 11000000;
+  int written = 0;
+  while(written < people) {
+    int size = size_dist(rng) + 1;
+    if(size > people - written) {
+      size = people - written;
+    }
+    char stcotrbg[16];
+    snprintf(stcotrbg, sizeof(stcotrbg), "42065%04d%02d%d", 9500 + uniform_int(1, tracts), 0, uniform_int(1, 5));
+    long serialno = 2007000000000L + household_id;
+    int head_age = uniform_int(20, 85);
+    fprintf(hh_fp, "%d,%ld,\"%s\",1,%d,%d,%d,%.7f,%.7f\n", household_id, serialno, stcotrbg,
+            uniform_int(5000, 150000), size, head_age, uniform(LAT_MIN, LAT_MAX), uniform(LON_MIN, LON_MAX));
+    for(int p = 0; p < size; ++p) {
+      int age;
+      int relate;
+      if(p == 0) {
+        age = head_age;
+        relate = 0;
+      } else if(p == 1 && uniform(0, 1) < 0.7) {
+        age = head_age + uniform_int(-5, 5);
+        if(age < 18) {
+          age = 18;
+        }
+        relate = 1;
+      } else {
+        age = head_age > 60 ? uniform_int(18, 50) : uniform_int(0, 22);
+        relate = 2;
+      }
+      char school[16] = "";
+      char work[16] = "";
+      if(age >= 5 && age <= 18) {
+        snprintf(school, sizeof(school), "%d", 450100000 + uniform_int(0, schools - 1));
+      } else if(age >= 18 && age < 67 && uniform(0, 1) < 0.7) {
+        snprintf(work, sizeof(work), "%d", 514200000 + uniform_int(0, workplaces - 1));
+      }
+      fprintf(people_fp, "%d,%d,%ld,\"%s\",%d,%d,1,%d,%d,%s,%s\n", person_id++, household_id, serialno,
+              stcotrbg, age, uniform_int(1, 2), p + 1, relate, school, work);
+    }
+    written += size;
+    ++household_id;
+  }
+  fclose(hh_fp);
+  fclose(people_fp);
+  printf("%s\n", id.c_str());
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <chrono>
+#include <random>
+
+#include "Events.h"
+using namespace std;
+
+// Startup memory and event throughput of the Events calendar queue for
+// the queues of a 5-disease run (6 per disease, 3 for demographics and
+// 1 for travel), compared with the old fixed MAX_DAYS bucket array.
+//
+// usage: FRED_Bench_Events [days] [people] [events_per_person]
+
+#define DISEASES 5
+#define QUEUES (6 * DISEASES + 4)
+
+// the previous layout: one bucket per possible day and a linear-scan delete
+class Legacy_Events {
+public:
+  void add_event(int day, event_t item) {
+    this->events[day].push_back(item);
+  }
+  void delete_event(int day, event_t item) {
+    for(unsigned pos = 0; pos < this->events[day].size(); ++pos) {
+      if(this->events[day][pos] == item) {
+        this->events[day][pos] = this->events[day].back();
+        this->events[day].pop_back();
+        return;
+      }
+    }
+  }
+  int get_size(int day) {
+    return static_cast<int>(this->events[day].size());
+  }
+  event_t get_event(int day, int i) {
+    return this->events[day][i];
+  }
+  void clear_events(int day) {
+    this->events[day] = events_t();
+  }
+private:
+  events_t events[MAX_DAYS];
+};
+
+static long resident_kb() {
+  long pages = 0, resident = 0;
+  FILE* fp = fopen("/proc/self/statm", "r");
+  if(fp != NULL) {
+    if(fscanf(fp, "%ld %ld", &pages, &resident) != 2) {
+      resident = 0;
+    }
+    fclose(fp);
+  }
+  return resident * 4;
+}
+
+static double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+  return elapsed.count();
+}
+
+// each person gets events a few days ahead; a quarter of them are
+// cancelled before they fire, like a recovery or death would
+template <class Queue>
+static void run(const char* name, int days, int people, int events_per_person) {
+  long rss = resident_kb();
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  Queue* queue = new Queue [QUEUES];
+  double setup = seconds_since(start);
+  long setup_kb = resident_kb() - rss;
+
+  std::vector<char> person(people);
+  std::mt19937_64 rng(12345);
+  long processed = 0;
+  long operations = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for(int day = 0; day < days; ++day) {
+    for(int e = 0; e < people * events_per_person / days; ++e) {
+      event_t item = reinterpret_cast<event_t>(&person[rng() % people]);
+      int q = rng() % QUEUES;
+      int event_day = day + 1 + rng() % 14;
+      if(event_day >= days) {
+        continue;
+      }
+      queue[q].add_event(event_day, item);
+      ++operations;
+      if(rng() % 4 == 0) {
+        queue[q].delete_event(event_day, item);
+        ++operations;
+      }
+    }
+    for(int q = 0; q < QUEUES; ++q) {
+      int size = queue[q].get_size(day);
+      for(int i = 0; i < size; ++i) {
+        processed += (queue[q].get_event(day, i) != NULL);
+      }
+      queue[q].clear_events(day);
+    }
+  }
+  double t = seconds_since(start);
+  operations += processed;
+  printf("%-10s %10.4f %12ld %12.3f %14.2f\n", name, setup, setup_kb, t, operations / t * 1e-6);
+  delete[] queue;
+}
+
+int main(int argc, char* argv[]) {
+  int days = 365;
+  int people = 1000000;
+  int events_per_person = 4;
+  if(argc > 1) {
+    days = atoi(argv[1]);
+  }
+  if(argc > 2) {
+    people = atoi(argv[2]);
+  }
+  if(argc > 3) {
+    events_per_person = atoi(argv[3]);
+  }
+  Events::set_horizon(days);
+  printf("%d queues, %d days, %d people, %d events per person\n", QUEUES, days, people, events_per_person);
+  printf("%-10s %10s %12s %12s %14s\n", "queue", "setup sec", "setup KB", "run sec", "Mops/sec");
+  run<Legacy_Events>("legacy", days, people, events_per_person);
+  run<Events>("calendar", days, people, events_per_person);
+  return 0;
+}
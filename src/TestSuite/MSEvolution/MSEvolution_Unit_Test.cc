@@ -0,0 +1,152 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: MSEvolution_Unit_Test.cc
+//
+// Fills people's infection histories directly and checks that
+// MSEvolution's cached probability of taking a strain matches the loop
+// over the history, across repeated challenges, other strains and days,
+// and after the history changes.  Exits with 1 after any mismatch.
+//
+// Reads $FRED_HOME/input_files/defaults (FRED_HOME defaults to ..).
+//
+// make FRED_Unit_MSEvolution && TestSuite/MSEvolution/FRED_Unit_MSEvolution
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Disease.h"
+#include "Global.h"
+#include "MSEvolution.h"
+#include "Params.h"
+#include "Past_Infection.h"
+#include "Person.h"
+
+using namespace std;
+
+static int Failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    printf("FAILED: %s\n", what);
+    ++Failures;
+  }
+}
+
+// exposes the per-challenge terms
+class Test_Evolution : public MSEvolution {
+public:
+  using MSEvolution::prob_past_infections;
+  using MSEvolution::prob_inf_blocking;
+};
+
+// prob_past_infections without the cache
+static double uncached(Test_Evolution &evolution, Person* person, int strain, int day) {
+  double prob_taking = 1.0;
+  for(int i = 0; i < person->get_num_past_infections(0); ++i) {
+    Past_Infection* past_infection = person->get_past_infection(0, i);
+    prob_taking *= (1 - evolution.prob_inf_blocking(past_infection->get_strain(), strain,
+						     day - past_infection->get_infectious_end_date(),
+						     past_infection->get_age_at_exposure()));
+  }
+  return prob_taking;
+}
+
+static bool matches(Test_Evolution &evolution, Person* person, int strain, int day) {
+  double expected = uncached(evolution, person, strain, day);
+  return fabs(evolution.prob_past_infections(person, strain, day) - expected) <= 1e-12 * expected;
+}
+
+// the evolution parameters of tests/evolution, in Age_Map form
+static void write_params(const char* paramfile) {
+  FILE* fp = fopen(paramfile, "w");
+  fprintf(fp, "half_life_inf_age_groups[0] = 1 110\n");
+  fprintf(fp, "half_life_inf_values[0] = 1 100\n");
+  fprintf(fp, "half_life_vac_age_groups[0] = 2 61 100\n");
+  fprintf(fp, "half_life_vac_values[0] = 2 270 60\n");
+  fprintf(fp, "init_protection_inf = 1.0\n");
+  fprintf(fp, "init_protection_vac = 0.3\n");
+  fprintf(fp, "saturation_quantity = 0.1\n");
+  fprintf(fp, "strain_dependent_protection_dists[0] = 5 0 1 2 12 18\n");
+  fprintf(fp, "strain_dependent_protection_probs[0] = 5 1.0 0.99 0.99 0.25 0.00\n");
+  fclose(fp);
+}
+
+int main(void) {
+  setenv("FRED_HOME", "..", 0);
+  char paramfile[] = "/tmp/FRED_Unit_MSEvolution_XXXXXX";
+  int fd = mkstemp(paramfile);
+  if(fd < 0) {
+    printf("MSEvolution: cannot create %s\n", paramfile);
+    return 1;
+  }
+  close(fd);
+  write_params(paramfile);
+  Params::read_parameters(paramfile);
+  unlink(paramfile);
+
+  Global::Diseases.get_parameters();
+  Disease* disease = Global::Diseases.get_disease(0);
+  Test_Evolution evolution;
+  evolution.setup(disease);
+
+  int n = 200;
+  Person* people = new Person [n];
+  for(int i = 0; i < n; ++i) {
+    people[i].set_pop_index(i);
+    people[i].get_health()->setup(&people[i]);
+  }
+
+  srand(12345);
+  for(int day = 0; day < 400; day += 7) {
+    for(int i = 0; i < n; ++i) {
+      Person* person = &people[i];
+      // histories grow at different rates, up to a few dozen infections
+      if(rand() % (1 + i % 5) == 0) {
+	person->add_past_infection(rand() % 4, day - 1 - rand() % 30, rand() % 90, disease);
+      }
+      int strain = rand() % 4;
+      // the first challenge fills the cache, the second reads it
+      if(!matches(evolution, person, strain, day) || !matches(evolution, person, strain, day)) {
+	check(false, "repeated challenge");
+	break;
+      }
+      // another strain and the next day replace the entry
+      if(!matches(evolution, person, (strain + 1) % 4, day)
+	 || !matches(evolution, person, strain, day + 1)) {
+	check(false, "another strain or day");
+	break;
+      }
+      // a new past infection on the same day invalidates the entry
+      person->add_past_infection(strain, day - 2, 30, disease);
+      if(!matches(evolution, person, strain, day + 1)) {
+	check(false, "after add_past_infection");
+	break;
+      }
+    }
+  }
+
+  // no history left: nothing is taken away
+  people[0].clear_past_infections(0);
+  check(evolution.prob_past_infections(&people[0], 1, 500) == 1.0, "after clear_past_infections");
+
+  if(Failures > 0) {
+    printf("MSEvolution: %d failures\n", Failures);
+    return 1;
+  }
+  printf("MSEvolution: all tests passed\n");
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "Random.h"
+using namespace std;
+
+// Compares the sequential mt19937_64 generator behind RNG::random with
+// the counter-based Philox generator used for keyed streams, both for
+// straight-line draws and for the short per-place streams used by
+// parallel transmission (open a stream, take a few draws, move on).
+
+static double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+  return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+  long draws = 100000000;
+  long streams = 1000000;
+  int draws_per_stream = 8;
+  if(argc > 1) {
+    draws = atol(argv[1]);
+  }
+  if(argc > 2) {
+    streams = atol(argv[2]);
+  }
+
+  RNG rng;
+  rng.set_seed(123456);
+  Stream_RNG stream_rng;
+  stream_rng.set_seed(123456);
+  double sum;
+
+  printf("%-28s %12s %14s\n", "benchmark", "seconds", "Mdraws/sec");
+
+  sum = 0.0;
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  for(long i = 0; i < draws; ++i) {
+    sum += rng.random();
+  }
+  double t = seconds_since(start);
+  printf("%-28s %12.3f %14.1f  (mean %.4f)\n", "mt19937_64 random", t, draws / t * 1e-6, sum / draws);
+
+  sum = 0.0;
+  start = std::chrono::high_resolution_clock::now();
+  for(long i = 0; i < draws; ++i) {
+    sum += stream_rng.random();
+  }
+  t = seconds_since(start);
+  printf("%-28s %12.3f %14.1f  (mean %.4f)\n", "philox random", t, draws / t * 1e-6, sum / draws);
+
+  // the per-place pattern: the old keyed streams reseeded an mt19937_64
+  // (2.5 KB of state) for every place; Philox only resets its counter
+  long total = streams * draws_per_stream;
+  sum = 0.0;
+  start = std::chrono::high_resolution_clock::now();
+  for(long s = 0; s < streams; ++s) {
+    rng.set_seed(123456 ^ s);
+    rng.reset();
+    for(int i = 0; i < draws_per_stream; ++i) {
+      sum += rng.random();
+    }
+  }
+  t = seconds_since(start);
+  printf("%-28s %12.3f %14.1f  (mean %.4f)\n", "mt19937_64 reseeded streams", t, total / t * 1e-6, sum / total);
+
+  sum = 0.0;
+  start = std::chrono::high_resolution_clock::now();
+  for(long s = 0; s < streams; ++s) {
+    stream_rng.get_engine().set_stream((uint32_t) s, 1, 0);
+    stream_rng.reset();
+    for(int i = 0; i < draws_per_stream; ++i) {
+      sum += stream_rng.random();
+    }
+  }
+  t = seconds_since(start);
+  printf("%-28s %12.3f %14.1f  (mean %.4f)\n", "philox keyed streams", t, total / t * 1e-6, sum / total);
+
+  return 0;
+}
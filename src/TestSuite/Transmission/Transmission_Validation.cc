@@ -0,0 +1,208 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Transmission_Validation.cc
+//
+// Checks that the skip-sampling transmission kernel (Contact_Targets plus
+// one collapsed attempt per target) gives the same attack rates as the
+// default kernel (Contact_Sampler::draw_contacts and one attempt per
+// draw), on a synthetic place where the first few enrollees are
+// infectious and the place is a little larger than its enrollee list.
+// Both kernels use the contact processes that Respiratory_Transmission
+// runs; only the transmission attempt is reduced to a fixed probability.
+// For each kernel it reports the mean and variance of the number of new
+// infections per day, a two-sample chi-square test of their distributions,
+// the per-position infection rates, and the time per day.
+//
+// usage: FRED_Validate_Transmission [trials] [enrollees] [infectious] [contacts] [prob]
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "Contact_Sampler.h"
+using namespace std;
+
+struct Setup {
+  int size;        // N, the place size
+  int enrollees;   // S
+  int infectious;  // infectors are enrollees 0 .. infectious-1
+  int contacts;    // contacts per infector per day
+  double prob;     // transmission probability per contact
+};
+
+static double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+  return elapsed.count();
+}
+
+// Respiratory_Transmission::default_transmission_model on the place
+static int legacy_day(const Setup & setup, std::vector<char> & infected) {
+  int number_targets = setup.size - 1 > setup.enrollees ? setup.size - 1 : setup.enrollees;
+  // enrollee i is person i
+  std::vector<int> enrollees(setup.enrollees);
+  for(int i = 0; i < setup.enrollees; ++i) {
+    enrollees[i] = i;
+  }
+  int count = 0;
+  for(int infector = 0; infector < setup.infectious; ++infector) {
+    std::map<int, int> sampling_map;
+    Contact_Sampler::draw_contacts(setup.contacts, number_targets, enrollees, infector, sampling_map);
+    for(std::map<int, int>::iterator i = sampling_map.begin(); i != sampling_map.end(); ++i) {
+      for(int draw = 0; draw < i->second; ++draw) {
+        if(i->first >= setup.infectious && !infected[i->first]) {
+          if(Random::draw_random() < setup.prob) {
+            infected[i->first] = 1;
+            ++count;
+          }
+        }
+      }
+    }
+  }
+  return count;
+}
+
+// Respiratory_Transmission::skip_sampling_transmission_model on the place
+static int skip_day(const Setup & setup, std::vector<char> & infected) {
+  int number_targets = setup.size - 1 > setup.enrollees ? setup.size - 1 : setup.enrollees;
+  int count = 0;
+  for(int infector = 0; infector < setup.infectious; ++infector) {
+    Contact_Targets targets(setup.contacts, number_targets, setup.enrollees, infector);
+    while(targets.next()) {
+      int pos = targets.get_target();
+      if(pos >= setup.infectious && !infected[pos]) {
+        double prob = Contact_Sampler::prob_of_any(setup.prob, targets.get_hits());
+        if(Random::draw_random() < prob) {
+          infected[pos] = 1;
+          ++count;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+struct Result {
+  std::vector<long> histogram;   // days with k new infections
+  std::vector<long> position;    // infections at each enrollee position
+  double mean;
+  double variance;
+  double seconds;
+};
+
+template <class Kernel>
+static Result run(const Setup & setup, int trials, Kernel kernel) {
+  Result result;
+  result.histogram.assign(setup.enrollees + 1, 0);
+  result.position.assign(setup.enrollees, 0);
+  std::vector<char> infected(setup.enrollees);
+  double sum = 0.0;
+  double sum2 = 0.0;
+  result.seconds = 0.0;
+  for(int t = 0; t < trials; ++t) {
+    infected.assign(setup.enrollees, 0);
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    int k = kernel(setup, infected);
+    result.seconds += seconds_since(start);
+    result.histogram[k]++;
+    for(int i = 0; i < setup.enrollees; ++i) {
+      result.position[i] += infected[i];
+    }
+    sum += k;
+    sum2 += static_cast<double>(k) * k;
+  }
+  result.mean = sum / trials;
+  result.variance = sum2 / trials - result.mean * result.mean;
+  return result;
+}
+
+// two-sample chi-square over histogram bins, pooling sparse tails
+static void chi_square(const std::vector<long> & a, const std::vector<long> & b, double* stat, int* df) {
+  *stat = 0.0;
+  *df = -1;
+  long pool_a = 0;
+  long pool_b = 0;
+  for(size_t k = 0; k < a.size(); ++k) {
+    pool_a += a[k];
+    pool_b += b[k];
+    if(pool_a + pool_b >= 20 || k + 1 == a.size()) {
+      if(pool_a + pool_b > 0) {
+        double d = pool_a - pool_b;
+        *stat += d * d / (pool_a + pool_b);
+        ++(*df);
+      }
+      pool_a = 0;
+      pool_b = 0;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int trials = 200000;
+  Setup setup = { 120, 100, 5, 20, 0.05 };
+  if(argc > 1) {
+    trials = atoi(argv[1]);
+  }
+  if(argc > 2) {
+    setup.enrollees = atoi(argv[2]);
+    setup.size = setup.enrollees + setup.enrollees / 5;
+  }
+  if(argc > 3) {
+    setup.infectious = atoi(argv[3]);
+  }
+  if(argc > 4) {
+    setup.contacts = atoi(argv[4]);
+  }
+  if(argc > 5) {
+    setup.prob = atof(argv[5]);
+  }
+  printf("%d trials, place size %d, %d enrollees, %d infectious, %d contacts each, prob %.3f\n",
+         trials, setup.size, setup.enrollees, setup.infectious, setup.contacts, setup.prob);
+
+  Random::set_seed(12345);
+  Result legacy = run(setup, trials, legacy_day);
+  Random::set_seed(67890);
+  Result skip = run(setup, trials, skip_day);
+
+  printf("%-8s %12s %12s %12s\n", "kernel", "mean", "variance", "usec/day");
+  printf("%-8s %12.4f %12.4f %12.3f\n", "legacy", legacy.mean, legacy.variance, legacy.seconds / trials * 1e6);
+  printf("%-8s %12.4f %12.4f %12.3f\n", "skip", skip.mean, skip.variance, skip.seconds / trials * 1e6);
+
+  double stat;
+  int df;
+  chi_square(legacy.histogram, skip.histogram, &stat, &df);
+  // Wilson-Hilferty approximation to the chi-square upper tail
+  double z = (pow(stat / df, 1.0 / 3.0) - (1.0 - 2.0 / (9.0 * df))) / sqrt(2.0 / (9.0 * df));
+  printf("new infections per day: chi-square %.2f on %d df, z = %.2f\n", stat, df, z);
+
+  // per-position rates should be flat across susceptible positions
+  double worst = 0.0;
+  for(int i = setup.infectious; i < setup.enrollees; ++i) {
+    double p1 = static_cast<double>(legacy.position[i]) / trials;
+    double p2 = static_cast<double>(skip.position[i]) / trials;
+    double se = sqrt((p1 * (1 - p1) + p2 * (1 - p2)) / trials);
+    if(se > 0.0 && fabs(p1 - p2) / se > worst) {
+      worst = fabs(p1 - p2) / se;
+    }
+  }
+  printf("largest per-position difference: %.2f standard errors over %d positions\n",
+         worst, setup.enrollees - setup.infectious);
+
+  bool ok = fabs(z) < 4.0 && worst < 5.0;
+  printf("%s\n", ok ? "PASSED" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Vaccine_Queue_Unit_Test.cc
+//
+// Checks Vaccine_Queue against a deque holding the same people,
+// including people queued more than once, and walks through it that
+// stop only at the people in some groups.  Exits with 1 after any
+// mismatch.
+//
+// make FRED_Unit_Vaccine_Queue && TestSuite/Vaccine_Queue/FRED_Unit_Vaccine_Queue
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "Person.h"
+#include "Vaccine_Queue.h"
+
+using namespace std;
+
+static int Failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    printf("FAILED: %s\n", what);
+    ++Failures;
+  }
+}
+
+static bool same(Vaccine_Queue &queue, const deque<Person*> &expected) {
+  if(queue.size() != static_cast<int>(expected.size())) {
+    return false;
+  }
+  for(int i = 0; i < queue.size(); ++i) {
+    if(queue.get(i) != expected[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool remove_first(deque<Person*> &expected, Person* person) {
+  deque<Person*>::iterator found = std::find(expected.begin(), expected.end(), person);
+  if(found == expected.end()) {
+    return false;
+  }
+  expected.erase(found);
+  return true;
+}
+
+// a person queued twice, one copy erased by position, then removed by
+// person: the block recorded for the remaining copy must be current
+static void test_duplicate_then_remove(Person* people, int n) {
+  vector<Person*> order;
+  deque<Person*> expected;
+  for(int i = 0; i < n; ++i) {
+    order.push_back(&people[i]);
+    expected.push_back(&people[i]);
+  }
+  Vaccine_Queue queue;
+  queue.assign(order);
+
+  queue.push_back(&people[5]);
+  expected.push_back(&people[5]);
+  queue.erase(5);
+  expected.erase(expected.begin() + 5);
+  check(same(queue, expected), "duplicate: erase by position");
+
+  check(queue.remove(&people[5]), "duplicate: remove finds the remaining copy");
+  remove_first(expected, &people[5]);
+  check(same(queue, expected), "duplicate: remove the remaining copy");
+  check(queue.remove(&people[5]) == false, "duplicate: nothing left to remove");
+}
+
+// random inserts (often of people already queued), erases and removes
+static void test_random_operations(Person* people, int n) {
+  Vaccine_Queue queue;
+  deque<Person*> expected;
+  srand(12345);
+  for(int step = 0; step < 100000; ++step) {
+    int op = rand() % 10;
+    Person* person = &people[rand() % n];
+    if(op < 4) {
+      int position = rand() % (queue.size() + 1);
+      queue.insert(position, person);
+      expected.insert(expected.begin() + position, person);
+    } else if(op < 6 && !expected.empty()) {
+      int position = rand() % queue.size();
+      queue.erase(position);
+      expected.erase(expected.begin() + position);
+    } else if(op < 9) {
+      bool found = remove_first(expected, person);
+      if(queue.remove(person) != found) {
+        check(false, "random: remove");
+        return;
+      }
+    } else if(step % 1000 == 9) {
+      vector<Person*> order(expected.begin(), expected.end());
+      queue.assign(order);
+    }
+    if(step % 97 == 0 && !same(queue, expected)) {
+      check(false, "random: contents");
+      return;
+    }
+  }
+  check(same(queue, expected), "random: final contents");
+}
+
+// walks that stop only at the people in some groups, erasing some of
+// them, against the same walk over a deque
+static void test_cursor_walks(Person* people, int n) {
+  vector<Person*> order;
+  for(int i = 0; i < n; ++i) {
+    order.push_back(&people[(i * 7919) % n]);
+  }
+  Vaccine_Queue queue;
+  queue.assign(order);
+  deque<Person*> expected(order.begin(), order.end());
+  srand(54321);
+  for(int walk = 0; walk < 200 && !expected.empty(); ++walk) {
+    // a run of groups, or every group in the last walks
+    Vaccine_Queue::Group_Set groups;
+    int first = rand() % Vaccine_Queue::Groups;
+    int last = first + rand() % 8;
+    for(int group = first; group <= last && group < Vaccine_Queue::Groups; ++group) {
+      groups.set(group);
+    }
+    if(walk >= 190) {
+      groups.set();
+    }
+    // erase half of the people stopped at, or all of them at the end
+    int erase_percent = (walk >= 190 ? 100 : 50);
+
+    Vaccine_Queue::Cursor cursor = queue.begin();
+    queue.seek(cursor, groups);
+    int i = 0;
+    while(true) {
+      while(i < static_cast<int>(expected.size()) && !groups[Vaccine_Queue::get_group(expected[i])]) {
+        ++i;
+      }
+      if(i == static_cast<int>(expected.size()) || queue.at_end(cursor)) {
+        break;
+      }
+      if(queue.get(cursor) != expected[i]) {
+        check(false, "walk: stopped at the wrong person");
+        return;
+      }
+      if(rand() % 100 < erase_percent) {
+        queue.erase(cursor);
+        expected.erase(expected.begin() + i);
+      } else {
+        queue.next(cursor);
+        ++i;
+      }
+      queue.seek(cursor, groups);
+    }
+    if(i != static_cast<int>(expected.size()) || !queue.at_end(cursor)) {
+      check(false, "walk: ended in the wrong place");
+      return;
+    }
+    if(!same(queue, expected)) {
+      check(false, "walk: contents");
+      return;
+    }
+    // some newcomers between walks
+    for(int k = 0; k < 20; ++k) {
+      Person* person = &people[rand() % n];
+      int position = rand() % (queue.size() + 1);
+      queue.insert(position, person);
+      expected.insert(expected.begin() + position, person);
+    }
+  }
+  check(same(queue, expected), "walk: final contents");
+}
+
+int main(void) {
+  int n = 20000;
+  Person* people = new Person [n];
+  for(int i = 0; i < n; ++i) {
+    people[i].set_pop_index(i);
+    // birthdays over every group (a newborn's birthday is the given day)
+    int birthday = -42000 + (i * 104729) % 47000;
+    people[i].get_demographics()->setup(&people[i], 0, 'F', 0, 0, birthday, true);
+  }
+  test_duplicate_then_remove(people, 1000);
+  test_random_operations(people, 1000);
+  test_cursor_walks(people, n);
+  if(Failures > 0) {
+    printf("Vaccine_Queue: %d failures\n", Failures);
+    return 1;
+  }
+  printf("Vaccine_Queue: all tests passed\n");
+  return 0;
+}
@@ -26,7 +26,17 @@
 #include <iomanip>
 #include <fstream>
 #include <sstream>
+#include <stdint.h>
+#include <stdio.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+
+// Global.h includes this file before it declares the fred namespace
+namespace fred {
+  int omp_get_max_threads();
+}
+#endif
 
 #ifdef UNIT_TEST
 #define ERROR_PRINT printf
@@ -43,8 +53,26 @@ const string allowed_typenames[] = { "double", "int", "string" };
  * The Tracker Class is a class that contains maps that allow one to 
  * log on a daily basis different counts of things throughout FRED
  *
- * It basically contains three maps for integers, doubles, and strings
- * and stores a key, and then allows you to log daily values.
+ * It stores a column of int, double or string values for each key, with
+ * one entry per index (e.g. per day).  A key name resolves once to an
+ * integer key handle (get_key_handle) and an index to an index handle
+ * (add_index); set_value and increment_value then go straight to the
+ * column.  The string-keyed *_index_key_pair functions do the same lookups
+ * on every call and are kept for the many callers that report once a day.
+ *
+ * increment_value (and increment_index_key_pair) may be called from
+ * several threads.  Each thread adds to its own counts for one index and
+ * passes them on when it moves to another index or when the tracker is
+ * merged.  Setting values, merging and the printers are for serial code;
+ * they merge first, so they always see every increment.
+ *
+ * The binary columnar format (output_binary_report_format) is
+ *   char magic[8] "FREDTRKC", int32 version (1), int32 indices, int32 keys,
+ *   int64 index values[indices],
+ * then for each key, in the order of the csv columns,
+ *   int32 type (0 double, 1 int, 2 string), int32 name length, the name,
+ *   and the column: double[indices], int32[indices], or for strings an
+ *   int32 length and the characters of each value.
  */
 
 // TO DO - reimplement with the counts being members of a template class
@@ -52,12 +80,20 @@ const string allowed_typenames[] = { "double", "int", "string" };
 template <typename T>
 class Tracker {
 public:
+  // key types, in the order of allowed_typenames
+  enum {
+    DOUBLE_KEY,
+    INT_KEY,
+    STRING_KEY
+  };
+
   /**
    * Default constructor
    */
   Tracker() {
     this->title = "Tracker";
     this->index_name = "Generic Index";
+    this->_setup_pending();
   }
   
   /**
@@ -66,6 +102,7 @@ public:
   Tracker(string _title, string _index_name) {
     this->title = _title;
     this->index_name = _index_name;
+    this->_setup_pending();
   }
 
   /**
@@ -87,8 +124,7 @@ public:
   }
   
   bool is_allowed_type(string type_name) {
-    vector<string> atypes = this->_get_allowed_typenames();
-    return find(atypes.begin(), atypes.end(), type_name) != atypes.end();
+    return this->_type_of(type_name) != -1;
   }
 
 #ifdef UNIT_TEST
@@ -100,20 +136,17 @@ public:
   
     
   string has_key(string key) {
-    vector<string> aTypes = this->_get_allowed_typenames();
-    for(int i=0; i < aTypes.size(); ++i) {
-      vector<string> keys = this->_get_keys(aTypes[i]);
-      vector<string>::iterator iter_index = find(keys.begin(), keys.end(), key);
-      if(iter_index != keys.end()) {
-        return aTypes[i];
-      }
+    int handle = this->_key_handle(key);
+    if(handle == -1) {
+      return "None";
     }
-    return "None";
+    return allowed_typenames[this->columns[handle].type];
   }
 
   // Modifiers
   
-  // A new index adds an element to each array for each existing category
+  // A new index adds an element to each array for each existing category.
+  // The position returned is the index handle.
   int add_index(T index, bool unique = true, bool hardfail = false) {
     if(unique) {
       if(this->_index_pos(index) != -1) {
@@ -124,15 +157,24 @@ public:
 	}
       }
     }
+    int index_position;
 #pragma omp critical
     { 
+      index_position = this->indices.size();
       this->indices.push_back(index);
-      vector<string> aTypes = _get_allowed_typenames();
-      for(int i = 0; i < aTypes.size(); ++i) {
-	this->_add_new_index(aTypes[i]);
+      // the first of equal indices keeps the handle
+      this->index_positions.insert(std::make_pair(index, index_position));
+      for(int i = 0; i < this->int_values.size(); ++i) {
+	this->int_values[i].push_back(0);
+      }
+      for(int i = 0; i < this->double_values.size(); ++i) {
+	this->double_values[i].push_back(0.0);
+      }
+      for(int i = 0; i < this->string_values.size(); ++i) {
+	this->string_values[i].push_back(" ");
       }
     }
-    return this->indices.size() - 1;
+    return index_position;
   }
   
   void add_key(string key_name,string TypeName) {
@@ -146,6 +188,76 @@ public:
       this->_add_new_key(key_name, TypeName);
     }
   }
+
+  /**
+   * The handle of key key_name, which is added with type TypeName if it
+   * is new.  Register keys from serial code.
+   */
+  int get_key_handle(string key_name, string TypeName) {
+    int handle = this->_key_handle(key_name);
+    if(handle == -1) {
+      this->add_key(key_name, TypeName);
+      handle = this->_key_handle(key_name);
+    } else if(allowed_typenames[this->columns[handle].type] != TypeName) {
+      ERROR_PRINT("Tracker.h::get_key_handle key %s is of type %s, not %s\n", key_name.c_str(),
+		  allowed_typenames[this->columns[handle].type].c_str(), TypeName.c_str());
+    }
+    return handle;
+  }
+
+  // Handle operations
+  void set_value(int index_handle, int key_handle, int value) {
+    this->merge();
+    this->int_values[this->_slot(key_handle, INT_KEY)][index_handle] = value;
+  }
+
+  void set_value(int index_handle, int key_handle, double value) {
+    this->merge();
+    this->double_values[this->_slot(key_handle, DOUBLE_KEY)][index_handle] = value;
+  }
+
+  void set_value(int index_handle, int key_handle, string value) {
+    this->string_values[this->_slot(key_handle, STRING_KEY)][index_handle] = value;
+  }
+
+  void increment_value(int index_handle, int key_handle, int value) {
+    int slot = this->_slot(key_handle, INT_KEY);
+    Pending* pending = this->_get_pending(index_handle);
+    if(pending == NULL) {
+#pragma omp atomic
+      this->int_values[slot][index_handle] += value;
+      return;
+    }
+    if(pending->ints.size() <= slot) {
+      pending->ints.resize(this->int_values.size(), 0);
+    }
+    pending->ints[slot] += value;
+  }
+
+  void increment_value(int index_handle, int key_handle, double value) {
+    int slot = this->_slot(key_handle, DOUBLE_KEY);
+    Pending* pending = this->_get_pending(index_handle);
+    if(pending == NULL) {
+#pragma omp atomic
+      this->double_values[slot][index_handle] += value;
+      return;
+    }
+    if(pending->doubles.size() <= slot) {
+      pending->doubles.resize(this->double_values.size(), 0.0);
+    }
+    pending->doubles[slot] += value;
+  }
+
+  /**
+   * Add every thread's pending increments to the columns (serial code).
+   */
+  void merge() {
+    for(int t = 0; t < this->pending.size(); ++t) {
+      if(this->pending[t].index_position != -1) {
+	this->_flush(this->pending[t]);
+      }
+    }
+  }
  
   /// STB make sure OMP is taken care of in these.
   void set_index_key_pair(T index, string key_name, int value, bool allow_add = true) {
@@ -168,7 +280,7 @@ public:
 	ERROR_PRINT("Tracker.h::set_index_key_pair with int, using a key that is not for integers");
       }
     }
-    this->values_map_int[key_name][index_position] = value;
+    this->set_value(index_position, this->_key_handle(key_name), value);
   }
   
   void set_index_key_pair(T index, string key_name, double value, bool allow_add = true){
@@ -190,7 +302,7 @@ public:
 	ERROR_PRINT("Tracker.h::set_index_key_pair with double, using a key that is not for integers");
       }
     }
-    this->values_map_double[key_name][index_position] = value;
+    this->set_value(index_position, this->_key_handle(key_name), value);
   }
   
   void set_index_key_pair(T index, string key_name, string value, bool allow_add = true) {
@@ -213,7 +325,7 @@ public:
 	ERROR_PRINT("Tracker.h::set_index_key_pair with string, using a key that is not for integers");
       }
     }
-    this->values_map_string[key_name][index_position] = value;
+    this->set_value(index_position, this->_key_handle(key_name), value);
   } 
   
   void increment_index_key_pair(T index, string key_name, int value) {
@@ -233,8 +345,7 @@ public:
     if(key_type != "int") {
       ERROR_PRINT("Tracker.h::increment_index_key_pair, (int) trying to increment a key %s with non integer type\n", key_name.c_str());
     }
-#pragma omp atomic
-    this->values_map_int[key_name][index_position] += value;
+    this->increment_value(index_position, this->_key_handle(key_name), value);
   }
 
   void increment_index_key_pair(T index, string key_name, double value) {
@@ -255,8 +366,7 @@ public:
     if(key_type != "double"){
       ERROR_PRINT("Tracker.h::increment_index_key_pair, (double) trying to increment a key %s with non double type\n", key_name.c_str());
     }
-#pragma omp atomic
-    this->values_map_double[key_name][index_position] += value;
+    this->increment_value(index_position, this->_key_handle(key_name), value);
   }
   
   void increment_index_key_pair(T index, string key_name, string value) {
@@ -293,16 +403,13 @@ public:
       ERROR_PRINT("Tracker.h::increment_index_key_pair there is no index %s\n",ss.str().c_str());
     }
     
-    for(map<string, vector<int> >::iterator iter = this->values_map_int.begin();
-	iter != this->values_map_int.end(); ++iter) {
-      (*iter).second[index_position] = 0;
+    this->merge();
+    for(int i = 0; i < this->int_values.size(); ++i) {
+      this->int_values[i][index_position] = 0;
     }
-    
-    for(map<string, vector<double> >::iterator iter=this->values_map_double.begin();
-	iter != this->values_map_double.end(); ++iter) {
-      (*iter).second[index_position] = 0.0;
+    for(int i = 0; i < this->double_values.size(); ++i) {
+      this->double_values[i][index_position] = 0.0;
     }
-    
   }
 
   
@@ -368,40 +475,16 @@ public:
     returnString << "--------------------------------------" << std::endl;
     returnString << "Index\t\tValue" << std::endl;
 
-    string key_type = this->has_key(key_name);
-    // Can't figure out how to not do this explicitly yet
-    if(key_type == "None") {
+    this->merge();
+    int handle = this->_key_handle(key_name);
+    if(handle == -1) {
       ERROR_PRINT("Tracker.h::print_key_index_list requesting a key %s that does not exist\n", key_name.c_str());
-    } else if(key_type == "int") {
-      if(this->indices.size() != this->values_map_int[key_name].size()) {
-	ERROR_PRINT("Tracker.h::print_key_index_list there is something wrong with the counts number of indices != number of values for key %s\n",
-		    key_name.c_str());
-      }
-      
-      for(int i = 0; i < this->indices.size(); ++i) {
-	returnString << this->indices[i] << "\t\t" << this->values_map_int[key_name][i] << std::endl;
-      }
-    } else if(key_type == "double") {
-      if(this->indices.size() != values_map_double[key_name].size()) {
-	ERROR_PRINT("Tracker.h::print_key_index_list there is something wrong with the counts number of indices != number of values for key %s\n",
-		    key_name.c_str());
-      }
-      
-      for(int i = 0; i < this->indices.size(); ++i) {
-	returnString << this->indices[i] << "\t\t" << this->values_map_double[key_name][i] << std::endl;
-      }
-    } else if(key_type == "string") {
-      if(this->indices.size() != this->values_map_string[key_name].size()) {
-	ERROR_PRINT("Tracker.h::print_key_index_list there is something wrong with the counts number of indices != number of values for key %s\n",
-		    key_name.c_str());
-      }
-      
+    } else {
       for(int i = 0; i < this->indices.size(); ++i) {
-	returnString << this->indices[i] << "\t\t" << this->values_map_string[key_name][i] << std::endl;
+	returnString << this->indices[i] << "\t\t";
+	this->_print_value(returnString, this->columns[handle], i);
+	returnString << std::endl;
       }
-    } else {
-      ERROR_PRINT("Tracker.h::print_key_index_list called with an unrecognized typename for key %s",
-		  key_name.c_str());
     }
     
     returnString << "--------------------------------------" << std::endl;
@@ -415,20 +498,18 @@ public:
     if(index_pos == -1) {
       ERROR_PRINT("Tracker.h::print_inline_report_format_for_index asked for index that does not exist");
     }
+    this->merge();
     stringstream returnStringSt;
     returnStringSt << this->index_name << " " << index << " ";
     
-    for(map<string, vector<string> >::iterator iter = this->values_map_string.begin();
-	iter != this->values_map_string.end(); ++iter) {
-      returnStringSt << (*iter).first << " " << (*iter).second[index_pos] << " ";
-    }
-    for(map<string, vector<int> >::iterator iter = this->values_map_int.begin();
-	iter != this->values_map_int.end(); ++iter){
-      returnStringSt << (*iter).first << " " << (*iter).second[index_pos] << " ";
-    }
-    for(map<string, vector<double> >::iterator iter = this->values_map_double.begin();
-	iter != this->values_map_double.end(); ++iter){
-      returnStringSt << (*iter).first << " " << setprecision(2) << fixed << (*iter).second[index_pos] << " ";
+    for(int i = 0; i < this->report_order.size(); ++i) {
+      const Column &column = this->columns[this->report_order[i]];
+      returnStringSt << column.name << " ";
+      if(column.type == DOUBLE_KEY) {
+	returnStringSt << setprecision(2) << fixed;
+      }
+      this->_print_value(returnStringSt, column, index_pos);
+      returnStringSt << " ";
     }
     
     string returnString = returnStringSt.str();
@@ -470,20 +551,13 @@ public:
     if(index_pos == -1) {
       ERROR_PRINT("Tracker.h::print_csv_report_format_for_index asked for index that does not exist");
     }
+    this->merge();
     
     stringstream returnString;
     returnString << index ;
-    for(map<string, vector<string> >::iterator iter = this->values_map_string.begin();
-	iter != this->values_map_string.end(); ++iter) {
-      returnString << "," << (*iter).second[index_pos];
-    }
-    for(map<string, vector<int> >::iterator iter = this->values_map_int.begin();
-	iter != this->values_map_int.end(); ++iter){
-      returnString << "," << (*iter).second[index_pos];
-    }
-    for(map<string, vector<double> >::iterator iter = this->values_map_double.begin();
-	iter != this->values_map_double.end(); ++iter) {
-      returnString << "," << (*iter).second[index_pos];
+    for(int i = 0; i < this->report_order.size(); ++i) {
+      returnString << ",";
+      this->_print_value(returnString, this->columns[this->report_order[i]], index_pos);
     }
     returnString << "\n";
 
@@ -503,18 +577,8 @@ public:
     stringstream returnString;
     
     returnString << this->index_name;
-    for(map<string, vector<string> >::iterator iter = this->values_map_string.begin();
-	iter != this->values_map_string.end(); ++iter) {
-      returnString << "," << (*iter).first;
-      
-    }
-    for(map<string, vector<int> >::iterator iter = this->values_map_int.begin();
-	iter != this->values_map_int.end(); ++iter){
-      returnString << "," << (*iter).first;
-    }
-    for(map<string, vector<double> >::iterator iter = this->values_map_double.begin();
-	iter != this->values_map_double.end(); ++iter){
-      returnString << "," << (*iter).first;
+    for(int i = 0; i < this->report_order.size(); ++i) {
+      returnString << "," << this->columns[this->report_order[i]].name;
     }
     returnString << "\n";
 
@@ -533,119 +597,227 @@ public:
     }
     fflush(outfile);
   }
+
+  void output_binary_report_format(FILE* outfile) {
+    this->merge();
+    int32_t header[3];
+    header[0] = 1;
+    header[1] = this->indices.size();
+    header[2] = this->report_order.size();
+    fwrite("FREDTRKC", 1, 8, outfile);
+    fwrite(header, sizeof(int32_t), 3, outfile);
+    for(int i = 0; i < this->indices.size(); ++i) {
+      int64_t index = this->indices[i];
+      fwrite(&index, sizeof(index), 1, outfile);
+    }
+    for(int i = 0; i < this->report_order.size(); ++i) {
+      const Column &column = this->columns[this->report_order[i]];
+      int32_t type = column.type;
+      int32_t length = column.name.size();
+      fwrite(&type, sizeof(type), 1, outfile);
+      fwrite(&length, sizeof(length), 1, outfile);
+      fwrite(column.name.data(), 1, length, outfile);
+      if(column.type == INT_KEY) {
+	const vector<int> &values = this->int_values[column.slot];
+	for(int j = 0; j < values.size(); ++j) {
+	  int32_t value = values[j];
+	  fwrite(&value, sizeof(value), 1, outfile);
+	}
+      } else if(column.type == DOUBLE_KEY) {
+	fwrite(this->double_values[column.slot].data(), sizeof(double), this->indices.size(), outfile);
+      } else {
+	const vector<string> &values = this->string_values[column.slot];
+	for(int j = 0; j < values.size(); ++j) {
+	  length = values[j].size();
+	  fwrite(&length, sizeof(length), 1, outfile);
+	  fwrite(values[j].data(), 1, length, outfile);
+	}
+      }
+    }
+    fflush(outfile);
+  }
   
 private:
+  struct Column {
+    string name;
+    int type;
+    int slot;		// in int_values, double_values or string_values
+  };
+
+  // one thread's increments to one index, not yet added to the columns
+  struct Pending {
+    int index_position;	// -1 if none
+    vector<int> ints;
+    vector<double> doubles;
+    char pad[64];	// keep the threads' entries apart
+  };
+
   //Private Variables
   string title;
   string index_name;
   vector<T> indices;
-  map<string, vector<int> > values_map_int;
-  map<string, vector<string> > values_map_string;
-  map<string, vector<double> > values_map_double;
+  map<T, int> index_positions;
+  map<string, int> key_handles;
+  vector<Column> columns;
+  // the keys in report order: strings, ints, then doubles, each by name
+  vector<int> report_order;
+  vector<vector<int> > int_values;	// [slot][index position]
+  vector<vector<double> > double_values;
+  vector<vector<string> > string_values;
+  vector<Pending> pending;		// per thread
 
   vector<string> _get_allowed_typenames(void) {
     vector<string> aTypes(allowed_typenames, allowed_typenames + 3);
     return aTypes;
   }
 
-  void _add_new_index(string TypeName){
-    if(this->is_allowed_type(TypeName) == false) {
-      ERROR_PRINT("Tracker.h::_add_new_index has been called with unsupported TypeName %s, use double, int, or string\n",
-		  TypeName.c_str());
+  int _type_of(string TypeName) {
+    for(int i = 0; i < 3; ++i) {
+      if(allowed_typenames[i] == TypeName) {
+	return i;
+      }
     }
-     
-    if(TypeName == "int") {
-      if(this->values_map_int.size() > 0){
-	for(map< string, vector<int> >::iterator iter = this->values_map_int.begin();
-	    iter != this->values_map_int.end(); ++iter){
-	  (*iter).second.push_back(0);
-	}
+    return -1;
+  }
+
+  void _setup_pending() {
+#ifdef _OPENMP
+    this->pending.resize(fred::omp_get_max_threads());
+#else
+    this->pending.resize(1);
+#endif
+    for(int t = 0; t < this->pending.size(); ++t) {
+      this->pending[t].index_position = -1;
+    }
+  }
+
+  // the calling thread's pending increments, switched to index_position,
+  // or NULL if the thread has none (it then adds to the column itself)
+  Pending* _get_pending(int index_position) {
+#ifdef _OPENMP
+    int t = omp_get_thread_num();
+#else
+    int t = 0;
+#endif
+    if(t >= this->pending.size()) {
+      return NULL;
+    }
+    Pending* p = &this->pending[t];
+    if(p->index_position != index_position) {
+      if(p->index_position != -1) {
+	this->_flush(*p);
       }
-    } else if(TypeName == "double") {
-      if(this->values_map_double.size() > 0) {
-	for(map< string, vector<double> >::iterator iter = this->values_map_double.begin();
-	    iter != this->values_map_double.end(); ++iter) {
-	  (*iter).second.push_back(0);
-	}
+      p->index_position = index_position;
+    }
+    return p;
+  }
+
+  void _flush(Pending &p) {
+    for(int i = 0; i < p.ints.size(); ++i) {
+      if(p.ints[i] != 0) {
+#pragma omp atomic
+	this->int_values[i][p.index_position] += p.ints[i];
+	p.ints[i] = 0;
       }
-    } else if(TypeName  == "string") {
-      if(this->values_map_string.size() > 0) {
-	for(map< string, vector<string> >::iterator iter = this->values_map_string.begin();
-	    iter != this->values_map_string.end(); ++iter) {
-	  (*iter).second.push_back(" ");
-	}
+    }
+    for(int i = 0; i < p.doubles.size(); ++i) {
+      if(p.doubles[i] != 0.0) {
+#pragma omp atomic
+	this->double_values[i][p.index_position] += p.doubles[i];
+	p.doubles[i] = 0.0;
       }
+    }
+    p.index_position = -1;
+  }
+
+  int _slot(int key_handle, int type) {
+    const Column &column = this->columns[key_handle];
+    if(column.type != type) {
+      ERROR_PRINT("Tracker.h::key %s is of type %s, not %s\n", column.name.c_str(),
+		  allowed_typenames[column.type].c_str(), allowed_typenames[type].c_str());
+    }
+    return column.slot;
+  }
+
+  void _print_value(ostream &stream, const Column &column, int index_position) {
+    if(column.type == INT_KEY) {
+      stream << this->int_values[column.slot][index_position];
+    } else if(column.type == DOUBLE_KEY) {
+      stream << this->double_values[column.slot][index_position];
     } else {
-      ERROR_PRINT("Tracker.h::add_new_index has been called with unsupported TypeName %s, use double, int, or string\n",
-		  TypeName.c_str());
+      stream << this->string_values[column.slot][index_position];
     }
   }
-	      
+
   void _add_new_key(string key_name,string TypeName) {
-    if(this->is_allowed_type(TypeName) == false) {
-      ERROR_PRINT("Tracker.h::_add_new_keys has been called with unsupported TypeName %s, use double, int, or string\n",
-		  TypeName.c_str());
-    }
-    
-    if(TypeName == "int") {
-      for(int i =0; i < this->indices.size(); ++i) {
-	this->values_map_int[key_name].push_back(0);
-      }
-    } else if(TypeName == "double") {
-      for(int i =0; i < this->indices.size(); ++i) {
-	this->values_map_double[key_name].push_back(0.0);
-      }
-    } else if(TypeName == "string") {
-      for(int i =0; i < this->indices.size(); ++i) {
-	this->values_map_string[key_name].push_back("A String");
-      }
+    int type = this->_type_of(TypeName);
+    Column column;
+    column.name = key_name;
+    column.type = type;
+    if(type == INT_KEY) {
+      column.slot = this->int_values.size();
+      this->int_values.push_back(vector<int>(this->indices.size(), 0));
+    } else if(type == DOUBLE_KEY) {
+      column.slot = this->double_values.size();
+      this->double_values.push_back(vector<double>(this->indices.size(), 0.0));
+    } else if(type == STRING_KEY) {
+      column.slot = this->string_values.size();
+      this->string_values.push_back(vector<string>(this->indices.size(), "A String"));
     } else {
       ERROR_PRINT("Tracker.h::_add_new_key got a type name %s for key %s it doesn't know how to handle (use int,double,or string)",
 		  key_name.c_str(), TypeName.c_str());
+      return;
+    }
+    int handle = this->columns.size();
+    this->columns.push_back(column);
+    this->key_handles[key_name] = handle;
+
+    // report strings, then ints, then doubles, each in order of name
+    const int rank[3] = { 2, 1, 0 };
+    vector<int>::iterator pos = this->report_order.begin();
+    while(pos != this->report_order.end()) {
+      const Column &other = this->columns[*pos];
+      if(rank[other.type] > rank[type] || (other.type == type && other.name > key_name)) {
+	break;
+      }
+      ++pos;
     }
+    this->report_order.insert(pos, handle);
   }
   
   int _index_pos(T index) {
-    typename vector<T>::iterator iter_index;
-    
-    //return index;
-    iter_index = find(this->indices.begin(), this->indices.end(), index);
-    if(iter_index != this->indices.end()) {
-      return distance(this->indices.begin(), iter_index);
+    typename map<T, int>::iterator iter = this->index_positions.find(index);
+    if(iter != this->index_positions.end()) {
+      return iter->second;
+    } else {
+      return -1;
+    }
+  }
+
+  int _key_handle(string key_name) {
+    map<string, int>::iterator iter = this->key_handles.find(key_name);
+    if(iter != this->key_handles.end()) {
+      return iter->second;
     } else {
       return -1;
     }
   }
   
   vector<string> _get_keys(string TypeName) {
-    if(this->is_allowed_type(TypeName) == false) {
+    int type = this->_type_of(TypeName);
+    if(type == -1) {
       ERROR_PRINT("Tracker.h::_get_keys has been called with unsupported TypeName %s, use double,int, or string\n",
 		  TypeName.c_str());
     }
     
     vector<string> returnVec;
-    if(TypeName == "int") {
-      for(map<string, vector<int> >::iterator iter = this->values_map_int.begin();
-	  iter != this->values_map_int.end(); ++iter) {
-	returnVec.push_back((*iter).first);
-      }
-    } else if (TypeName == "double") {
-      for(map<string, vector<double> >::iterator iter = this->values_map_double.begin();
-	  iter != values_map_double.end(); ++iter) {
-	returnVec.push_back((*iter).first);
+    for(map<string, int>::iterator iter = this->key_handles.begin(); iter != this->key_handles.end(); ++iter) {
+      if(this->columns[iter->second].type == type) {
+	returnVec.push_back(iter->first);
       }
-    } else if(TypeName == "string") {
-      for(map < string, vector< string > >::iterator iter = this->values_map_string.begin();
-	  iter != this->values_map_string.end(); ++iter) {
-	returnVec.push_back((*iter).first);
-      }
-    } else {
-      ERROR_PRINT("Tracker.h::_get_keys called with an unrecognized TypeName %s\n", TypeName.c_str());
     }
     return returnVec;
   }  
 };
 
 #endif
-     
-
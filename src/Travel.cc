@@ -35,8 +35,7 @@ typedef std::vector <Person*> pvec;		// vector of person ptrs
 Events * Travel::return_queue = new Events;
 
 // runtime parameters
-static double* Travel_Duration_Cdf;		// cdf for trip duration
-static int max_Travel_Duration = 0;		// number of days in cdf
+static Alias_Table Travel_Duration;		// draws trip duration from its cdf
 Age_Map* travel_age_prob;
 
 // travel hub record:
@@ -62,6 +61,12 @@ void Travel::setup(char* directory) {
   read_hub_file();
   read_trips_per_day_file();
   setup_travelers_per_hub();
+  vector<double> travel_duration_cdf;
+  Params::get_param_vector((char*)"travel_duration", travel_duration_cdf);
+  if(travel_duration_cdf.empty()) {
+    Utils::fred_abort("Help! travel_duration is empty\n");
+  }
+  Travel_Duration.set_cdf(travel_duration_cdf);
   travel_age_prob = new Age_Map("Travel Age Probability");
   travel_age_prob->read_from_input("travel_age_prob");
 }
@@ -238,7 +243,7 @@ void Travel::update_travel(int day) {
 	  traveler->start_traveling(host);
 	  if(traveler->get_travel_status()) {
 	    // put traveler on list for given number of days to travel
-	    int duration = Random::draw_from_distribution(max_Travel_Duration, Travel_Duration_Cdf);
+	    int duration = Travel_Duration.draw();
 	    int return_sim_day = day + duration;
 	    Travel::add_return_event(return_sim_day, traveler);
 	    traveler->get_activities()->set_return_from_travel_sim_day(return_sim_day);
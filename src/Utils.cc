@@ -16,9 +16,12 @@
 
 #include "Utils.h"
 #include "Global.h"
+#include "Infection_Log.h"
+#include "Log_Sink.h"
 #include <chrono>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace std::chrono;
@@ -28,12 +31,39 @@ static high_resolution_clock::time_point fred_timer;
 static high_resolution_clock::time_point day_timer;
 static high_resolution_clock::time_point initialization_timer;
 static high_resolution_clock::time_point update_timer;
-static high_resolution_clock::time_point epidemic_timer;
 
 static char ErrorFilename[FRED_STRING_SIZE];
 
+// output files named by run number, as "<directory>/<name><run>.txt"
+// (".bin" for a binary infection log)
+struct run_output_file_t {
+  FILE** fp;
+  const char* name;
+};
+
+static run_output_file_t Run_output_files[] = {
+  { &Global::Outfp, "out" },
+  { &Global::Tracefp, "trace" },
+  { &Global::Infectionfp, "infections" },
+  { &Global::VaccineTracefp, "vacctr" },
+  { &Global::Birthfp, "births" },
+  { &Global::Deathfp, "deaths" },
+  { &Global::Immunityfp, "immunity" },
+  { &Global::Tractfp, "tracts" },
+  { &Global::IncomeCatfp, "income_category" },
+  { &Global::ErrorLogfp, "err" }
+};
+
+static void get_run_output_file_name(char* filename, const char* directory, int i, int run) {
+  const char* suffix = (Run_output_files[i].fp == &Global::Infectionfp ? Infection_Log::get_file_suffix() : ".txt");
+  sprintf(filename, "%s/%s%d%s", directory, Run_output_files[i].name, run, suffix);
+}
+
 void Utils::fred_abort(const char* format, ...){
 
+  // the messages logged before the error come first
+  Log_Sink::flush();
+
   // open ErrorLog file if it doesn't exist
   if(Global::ErrorLogfp == NULL){
     Global::ErrorLogfp = fopen(ErrorFilename, "w");
@@ -132,11 +162,14 @@ void Utils::fred_open_output_files(){
   }
   Global::Infectionfp = NULL;
   if(Global::Track_infection_events > 0) {
-    sprintf(filename, "%s/infections%d.txt", directory, run);
-    Global::Infectionfp = fopen(filename, "w");
+    sprintf(filename, "%s/infections%d%s", directory, run, Infection_Log::get_file_suffix());
+    Global::Infectionfp = fopen(filename, Infection_Log::is_binary() ? "wb" : "w");
     if(Global::Infectionfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
+    if(Infection_Log::is_binary()) {
+      Infection_Log::write_header();
+    }
   }
   Global::VaccineTracefp = NULL;
   if(strcmp(Global::VaccineTracefilebase, "none") != 0) {
@@ -201,6 +234,71 @@ void Utils::fred_open_output_files(){
   return;
 }
 
+void Utils::fred_copy_output_files(const char* directory, int run) {
+  // copy what this run has written so far to the files of another run
+  int n = sizeof(Run_output_files) / sizeof(Run_output_files[0]);
+  for(int i = 0; i < n; ++i) {
+    FILE* fp = *Run_output_files[i].fp;
+    if(fp == NULL) {
+      continue;
+    }
+    fflush(fp);
+    char from[FRED_STRING_SIZE];
+    char to[FRED_STRING_SIZE];
+    get_run_output_file_name(from, Global::Simulation_directory, i, Global::Simulation_run_number);
+    get_run_output_file_name(to, directory, i, run);
+    FILE* in = fopen(from, "r");
+    FILE* out = fopen(to, "w");
+    if(in == NULL || out == NULL) {
+      Utils::fred_abort("Can't copy %s to %s\n", from, to);
+    }
+    char buffer[65536];
+    size_t bytes;
+    while((bytes = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+      if(fwrite(buffer, 1, bytes, out) != bytes) {
+        Utils::fred_abort("Can't copy %s to %s\n", from, to);
+      }
+    }
+    fclose(in);
+    fclose(out);
+  }
+}
+
+void Utils::fred_reopen_output_files(const char* directory, int run) {
+  // continue the output of this run in the files of another run (made by
+  // fred_copy_output_files)
+  int n = sizeof(Run_output_files) / sizeof(Run_output_files[0]);
+  for(int i = 0; i < n; ++i) {
+    FILE** fp = Run_output_files[i].fp;
+    if(*fp == NULL) {
+      continue;
+    }
+    fclose(*fp);
+    char filename[FRED_STRING_SIZE];
+    get_run_output_file_name(filename, directory, i, run);
+    *fp = fopen(filename, "a");
+    if(*fp == NULL) {
+      Utils::fred_abort("Can't open %s\n", filename);
+    }
+  }
+  sprintf(ErrorFilename, "%s/err%d.txt", directory, run);
+}
+
+void Utils::fred_remove_output_files() {
+  int n = sizeof(Run_output_files) / sizeof(Run_output_files[0]);
+  for(int i = 0; i < n; ++i) {
+    FILE** fp = Run_output_files[i].fp;
+    if(*fp == NULL) {
+      continue;
+    }
+    fclose(*fp);
+    *fp = NULL;
+    char filename[FRED_STRING_SIZE];
+    get_run_output_file_name(filename, Global::Simulation_directory, i, Global::Simulation_run_number);
+    unlink(filename);
+  }
+}
+
 void Utils::fred_make_directory(char* directory) {
   mode_t mask;        // the user's current umask
   mode_t mode = 0777; // as a start
@@ -215,6 +313,7 @@ void Utils::fred_make_directory(char* directory) {
 
 void Utils::fred_end(void){
   // This is a function that cleans up FRED and exits
+  Log_Sink::finish();
   if(Global::Outfp != NULL) {
     fclose(Global::Outfp);
   }
@@ -222,6 +321,7 @@ void Utils::fred_end(void){
     fclose(Global::Tracefp);
   }
   if(Global::Infectionfp != NULL) {
+    Infection_Log::finish();
     fclose(Global::Infectionfp);
   }
   if(Global::VaccineTracefp != NULL) {
@@ -268,18 +368,6 @@ void Utils::fred_start_timer(high_resolution_clock::time_point* lap_start_time)
   *lap_start_time = high_resolution_clock::now();
 }
 
-void Utils::fred_start_epidemic_timer() {
-  epidemic_timer = high_resolution_clock::now();
-}
-
-void Utils::fred_print_epidemic_timer(string msg) {
-  high_resolution_clock::time_point stop_timer = high_resolution_clock::now();
-  double duration = 0.000001 * std::chrono::duration_cast<std::chrono::microseconds>( stop_timer - epidemic_timer ).count();
-  fprintf(Global::Statusfp, "%s took %f seconds\n\n", msg.c_str(), duration);
-  fflush(Global::Statusfp);
-  epidemic_timer = stop_timer;
-}
-
 void Utils::fred_start_initialization_timer() {
   initialization_timer = high_resolution_clock::now();
 }
@@ -348,6 +436,11 @@ void Utils::fred_verbose(int verbosity, const char* format, ...) {
   if(Global::Verbose > verbosity) {
     va_list ap;
     va_start(ap, format);
+    if(Log_Sink::is_enabled()) {
+      Log_Sink::write(stdout, format, ap);
+      va_end(ap);
+      return;
+    }
     vprintf(format, ap);
     va_end(ap);
     fflush(stdout);
@@ -358,6 +451,11 @@ void Utils::fred_verbose_statusfp(int verbosity, const char* format, ...) {
   if(Global::Verbose > verbosity) {
     va_list ap;
     va_start(ap,format);
+    if(Log_Sink::is_enabled()) {
+      Log_Sink::write(Global::Statusfp, format, ap);
+      va_end(ap);
+      return;
+    }
     vfprintf(Global::Statusfp, format, ap);
     va_end(ap);
     fflush(Global::Statusfp);
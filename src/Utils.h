@@ -35,10 +35,17 @@ using namespace std::chrono;
 ////// To ensure compatibility, always provide at least one varg (which may be an empty string,
 ////// eg: (vebosity, format, "")
 
+// FRED_MAX_VERBOSE is the highest verbosity of FRED_VERBOSE, FRED_STATUS and FRED_DEBUG
+// messages compiled into a module (set per module in the Makefile).  The verbosity is a
+// constant, so a message above it is removed by the compiler whatever the verbose param says.
+#ifndef FRED_MAX_VERBOSE
+#define FRED_MAX_VERBOSE 9
+#endif
+
 // FRED_VERBOSE and FRED_CONDITIONAL_VERBOSE print to the stout using Utils::fred_verbose
 #ifdef FREDVERBOSE
 #define FRED_VERBOSE(verbosity, format, ...){				\
-    if ( Global::Verbose > verbosity ) {				\
+    if ( verbosity <= FRED_MAX_VERBOSE && Global::Verbose > verbosity ) { \
       Utils::fred_verbose(verbosity, "FRED_VERBOSE: <%s, LINE:%d> " format, __FILE__, __LINE__, ## __VA_ARGS__); \
     }									\
   }
@@ -50,7 +57,7 @@ using namespace std::chrono;
 // FRED_CONDITIONAL_VERBOSE prints to the stout if the verbose level is exceeded and the supplied conditional is true
 #ifdef FREDVERBOSE
 #define FRED_CONDITIONAL_VERBOSE(verbosity, condition, format, ...){	\
-    if ( Global::Verbose > verbosity && condition ) {			\
+    if ( verbosity <= FRED_MAX_VERBOSE && Global::Verbose > verbosity && condition ) { \
       Utils::fred_verbose(verbosity, "FRED_CONDITIONAL_VERBOSE: <%s, LINE:%d> " format, __FILE__, __LINE__, ## __VA_ARGS__); \
     }									\
   }
@@ -64,7 +71,9 @@ using namespace std::chrono;
 // If Global::Verbose == 0, then abbreviated output is produced
 #ifdef FREDSTATUS
 #define FRED_STATUS(verbosity, format, ...){				\
-    if ( verbosity == 0 && Global::Verbose <= 1 ) {			\
+    if ( verbosity > FRED_MAX_VERBOSE ) {				\
+    }									\
+    else if ( verbosity == 0 && Global::Verbose <= 1 ) {		\
       Utils::fred_verbose_statusfp(verbosity, format, ## __VA_ARGS__);	\
     }									\
     else if ( Global::Verbose > verbosity ) {				\
@@ -79,7 +88,9 @@ using namespace std::chrono;
 // FRED_CONDITIONAL_STATUS prints to Global::Statusfp if the verbose level is exceeded and the supplied conditional is true
 #ifdef FREDSTATUS
 #define FRED_CONDITIONAL_STATUS(verbosity, condition, format, ...){	\
-    if ( verbosity == 0 && Global::Verbose <= 1 && condition ) {	\
+    if ( verbosity > FRED_MAX_VERBOSE ) {				\
+    }									\
+    else if ( verbosity == 0 && Global::Verbose <= 1 && condition ) {	\
       Utils::fred_verbose_statusfp(verbosity, format, ## __VA_ARGS__);	\
     }									\
     else if ( Global::Verbose > verbosity && condition ) {		\
@@ -95,7 +106,7 @@ using namespace std::chrono;
 // FRED_DEBUG prints to Global::Statusfp using Utils::fred_verbose_statusfp
 #ifdef FREDDEBUG
 #define FRED_DEBUG(verbosity, format, ...){				\
-    if ( Global::Debug >= verbosity ) {					\
+    if ( verbosity <= FRED_MAX_VERBOSE && Global::Debug >= verbosity ) { \
       Utils::fred_verbose_statusfp(verbosity, "FRED_DEBUG: <%s, LINE:%d> " format, __FILE__, __LINE__, ## __VA_ARGS__);	\
     }									\
   }
@@ -133,6 +144,9 @@ namespace Utils {
   void fred_abort(const char* format, ...);
   void fred_warning(const char* format, ...);
   void fred_open_output_files();
+  void fred_copy_output_files(const char* directory, int run);
+  void fred_reopen_output_files(const char* directory, int run);
+  void fred_remove_output_files();
   void fred_make_directory(char* directory);
   void fred_end();
   void fred_print_wall_time(const char* format, ...);
@@ -142,8 +156,6 @@ namespace Utils {
   void fred_print_day_timer(int day);
   void fred_start_initialization_timer();
   void fred_print_initialization_timer();
-  void fred_start_epidemic_timer();
-  void fred_print_epidemic_timer(string  msg);
   void fred_print_finish_timer();
   void fred_print_update_time(const char* format, ...);
   void fred_print_lap_time(const char* format, ...);
@@ -151,28 +151,25 @@ void Vaccine_Manager::fill_queues() {
     return;
   }
   // We need to loop over the entire population that the Manager oversees to put them in a queue.
+  vector<Person *> random_priority_queue;
+  vector<Person *> random_queue;
   for(int ip = 0; ip < pop->get_index_size(); ip++) {
     Person * current_person = this->pop->get_person_by_index(ip);
     if (current_person != NULL) {
       if(this->policies[current_policy]->choose_first_positive(current_person, 0, 0) == true) {
-	priority_queue.push_back(current_person);
+	random_priority_queue.push_back(current_person);
       } else {
 	if(this->vaccine_priority_only == false)
-	  this->queue.push_back(current_person);
+	  random_queue.push_back(current_person);
       }
     }
   }
 
-  vector<Person *> random_queue(this->queue.size());
-  copy(this->queue.begin(), this->queue.end(), random_queue.begin());
   FYShuffle<Person *>(random_queue);
-  copy(random_queue.begin(), random_queue.end(), this->queue.begin());
+  this->queue.assign(random_queue);
 
-  vector<Person *> random_priority_queue(this->priority_queue.size());
-  copy(this->priority_queue.begin(), this->priority_queue.end(), random_priority_queue.begin());
   FYShuffle<Person *>(random_priority_queue);
-  copy(random_priority_queue.begin(), random_priority_queue.end(),
-       this->priority_queue.begin());
+  this->priority_queue.assign(random_priority_queue);
 
   if(Global::Verbose > 0) {
     cout << "Vaccine Queue Stats \n";
@@ -195,40 +192,24 @@ void Vaccine_Manager::add_to_queue(Person* person) {
 
 void Vaccine_Manager::remove_from_queue(Person* person) {
   // remove the person from the queue if they are in there
-  list<Person *>::iterator pq = find(this->priority_queue.begin(), this->priority_queue.end(),
-				     person);
-  if(pq != this->priority_queue.end()) {
-    this->priority_queue.erase(pq);
+  if(this->priority_queue.remove(person)) {
     return;
   }
-  pq = find(this->queue.begin(), this->queue.end(), person);
-  if(pq != this->queue.end()) {
-    this->queue.erase(pq);
-  }
+  this->queue.remove(person);
 }
 
 void Vaccine_Manager::add_to_priority_queue_random(Person* person) {
   // Find a position to put the person in
   int size = this->priority_queue.size();
   int position = (int)(Random::draw_random()*size);
-
-  list<Person*>::iterator pq = this->priority_queue.begin();
-  for(int i = 0; i < position; ++i) {
-    ++pq;
-  }
-  this->priority_queue.insert(pq, person);
+  this->priority_queue.insert(position, person);
 }
 
 void Vaccine_Manager::add_to_regular_queue_random(Person* person) {
   // Find a position to put the person in
   int size = this->queue.size();
   int position = (int)(Random::draw_random() * size);
-
-  list<Person*>::iterator pq = this->queue.begin();
-  for(int i = 0; i < position; ++i) {
-    ++pq;
-  }
-  this->queue.insert(pq, person);
+  this->queue.insert(position, person);
 }
 
 void Vaccine_Manager::add_to_priority_queue_begin(Person* person) {
@@ -291,6 +272,22 @@ void Vaccine_Manager::print() {
   this->vaccine_package->print();
 }
 
+void Vaccine_Manager::get_applicable_groups(int age_day, Vaccine_Queue::Group_Set &groups) {
+  // a whole year of age can be a year behind the real age, and a
+  // birthday can be a day or so off its date; allow two years
+  const double margin = 2.0;
+  groups.reset();
+  for(int group = 0; group < Vaccine_Queue::Groups; ++group) {
+    int first, last;
+    Vaccine_Queue::get_group_birthdays(group, &first, &last);
+    double low_age = (age_day - last) / 365.25 - margin;
+    double high_age = (age_day - first) / 365.25 + margin;
+    if(this->vaccine_package->may_be_applicable(low_age, high_age)) {
+      groups.set(group);
+    }
+  }
+}
+
 void Vaccine_Manager::vaccinate(int day) {
   if(this->do_vacc) {
     cout << "Vaccinating!\n";
@@ -326,14 +323,18 @@ void Vaccine_Manager::vaccinate(int day) {
   }
 
   // Start vaccinating Priority
-  list<Person*>::iterator ip;
-  ip = this->priority_queue.begin();
+  // (the priority queue goes by whole years of age, which only change
+  // on birthdays with population dynamics)
+  Vaccine_Queue::Group_Set groups;
+  get_applicable_groups(Global::Enable_Population_Dynamics ? day : 0, groups);
+  Vaccine_Queue::Cursor ip = this->priority_queue.begin();
+  this->priority_queue.seek(ip, groups);
   //int accept_count = 0;
   //int reject_count = 0;
   //int reject_state_count = 0;
   // Run through the priority queue first 
-  while(ip != this->priority_queue.end()) {
-    Person* current_person = *ip;
+  while(!this->priority_queue.at_end(ip)) {
+    Person* current_person = this->priority_queue.get(ip);
 
     int vacc_app = this->vaccine_package->pick_from_applicable_vaccines((double)(current_person->get_age()));
     // printf("person = %d age = %.1f vacc_app = %d\n", current_person->get_id(), current_person->get_real_age(), vacc_app);
@@ -361,7 +362,7 @@ void Vaccine_Manager::vaccinate(int day) {
         vacc->remove_stock(1);
         total_vaccines_avail--;
         current_person->take_vaccine(vacc, day, this);
-        ip = this->priority_queue.erase(ip);  // remove a vaccinated person
+        this->priority_queue.erase(ip);  // remove a vaccinated person
       } else {
         reject_count++;
 	// TODO: HBM FIX THIS!
@@ -369,10 +370,10 @@ void Vaccine_Manager::vaccinate(int day) {
         // skip non-compliant person under HBM
         // if(strcmp(Global::Behavior_model_type,"HBM") == 0) ++ip;
         if(0) {
-          ++ip;
+          this->priority_queue.next(ip);
         } else {
           // remove non-compliant person if not HBM
-          ip = this->priority_queue.erase(ip);
+          this->priority_queue.erase(ip);
         }
       }
     } else {
@@ -380,7 +381,7 @@ void Vaccine_Manager::vaccinate(int day) {
         cout << "Vaccine not applicable for agent " << current_person->get_id() << " "
 	     << current_person->get_real_age() << "\n";
       }
-      ++ip;
+      this->priority_queue.next(ip);
     }
 
     if(total_vaccines_avail == 0) {
@@ -413,6 +414,7 @@ void Vaccine_Manager::vaccinate(int day) {
       Global::Daily_Tracker->set_index_key_pair(day,"Vs", reject_state_count);
       return;
     }
+    this->priority_queue.seek(ip, groups);
   }
 
   if(Global::Verbose > 0) {
@@ -421,9 +423,11 @@ void Vaccine_Manager::vaccinate(int day) {
   }
 
   // Run now through the regular queue
+  get_applicable_groups(Global::Simulation_Day, groups);
   ip = this->queue.begin();
-  while(ip != this->queue.end()) {
-    Person* current_person = *ip;
+  this->queue.seek(ip, groups);
+  while(!this->queue.at_end(ip)) {
+    Person* current_person = this->queue.get(ip);
     int vacc_app = this->vaccine_package->pick_from_applicable_vaccines(current_person->get_real_age());
     if(vacc_app > -1) {
       bool accept_vaccine = true;
@@ -451,20 +455,20 @@ void Vaccine_Manager::vaccinate(int day) {
         vacc->remove_stock(1);
         total_vaccines_avail--;
         current_person->take_vaccine(vacc, day, this);
-        ip = this->queue.erase(ip);  // remove a vaccinated person
+        this->queue.erase(ip);  // remove a vaccinated person
       } else {
         // printf("vaccine rejected by person %d age %0.1f\n", current_person->get_id(), current_person->get_real_age());
         reject_count++;
         // skip non-compliant person under HBM
         // if(strcmp(Global::Behavior_model_type,"HBM") == 0) ip++;
         if(0)
-          ip++;
+          this->queue.next(ip);
         // remove non-compliant person if not HBM
         else
-          ip = this->queue.erase(ip);
+          this->queue.erase(ip);
       }
     } else {
-      ip++;
+      this->queue.next(ip);
     }
     if(total_vaccines_avail == 0) {
       if(Global::Verbose > 0) {
@@ -496,6 +500,7 @@ void Vaccine_Manager::vaccinate(int day) {
       Global::Daily_Tracker->set_index_key_pair(day,"Vs", reject_state_count);
       return;
     }
+    this->queue.seek(ip, groups);
   }
 
   if(Global::Verbose > 0) {
@@ -26,10 +26,10 @@
 #define VACC_DOSE_RAND_PRIORITY 2
 #define VACC_DOSE_LAST_PRIORITY 3
 
-#include <list>
 #include <vector>
 #include <string>
 #include "Manager.h"
+#include "Vaccine_Queue.h"
 
 using namespace std;
 
@@ -57,12 +57,6 @@ public:
     return this->vaccine_package;
   }
 
-  list<Person*> get_priority_queue() const {
-    return this->priority_queue;
-  }
-
-  list<Person*> get_queue() const {
-    return this->queue;}
   int get_number_in_priority_queue() const {
     return this->priority_queue.size();
   }
@@ -106,9 +100,13 @@ public:
   void print();
   
 private:
+  // the groups of the queues holding the people a vaccine in stock may
+  // apply to, for ages taken on age_day
+  void get_applicable_groups(int age_day, Vaccine_Queue::Group_Set &groups);
+
   Vaccines* vaccine_package;             //Pointer to the vaccines that this manager oversees
-  list<Person *> priority_queue;         //Queue for the priority agents
-  list<Person *> queue;                  //Queue for everyone else
+  Vaccine_Queue priority_queue;          //Queue for the priority agents
+  Vaccine_Queue queue;                   //Queue for everyone else
   
   //Parameters from Input 
   bool do_vacc;                           //Is Vaccination being performed
@@ -0,0 +1,404 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Vaccine_Queue.cc
+//
+
+#include <algorithm>
+
+#include "Vaccine_Queue.h"
+#include "Demographics.h"
+#include "Person.h"
+
+// people per block when the blocks are built; a block is split when it
+// grows to twice this size
+static const int Block_size = 256;
+
+// group 0 starts a year before the earliest initial birthday
+static const int Group_days = 365;
+static const int First_group_birthday = -Group_days * (Demographics::MAX_AGE + 2);
+
+int Vaccine_Queue::get_group(Person* person) {
+  int day = person->get_birthday_sim_day();
+  if(day < First_group_birthday) {
+    return 0;
+  }
+  int group = (day - First_group_birthday) / Group_days;
+  return group < Groups ? group : Groups - 1;
+}
+
+void Vaccine_Queue::get_group_birthdays(int group, int* first, int* last) {
+  *first = (group == 0 ? -0x3fffffff : First_group_birthday + group * Group_days);
+  *last = (group == Groups - 1 ? 0x3fffffff : First_group_birthday + (group + 1) * Group_days - 1);
+}
+
+void Vaccine_Queue::assign(const vector<Person*> &people) {
+  clear();
+  for(int i = 0; i < static_cast<int>(people.size()); ++i) {
+    int idx = people[i]->get_pop_index();
+    assert(0 <= idx);
+    if(static_cast<int>(this->copies.size()) <= idx) {
+      int new_size = 2 * static_cast<int>(this->copies.size());
+      if(new_size <= idx) {
+        new_size = idx + 1;
+      }
+      this->copies.resize(new_size, 0);
+      this->block_of.resize(new_size, -1);
+    }
+    this->copies[idx]++;
+  }
+  build(people);
+}
+
+void Vaccine_Queue::clear() {
+  // only the queued people have table entries to reset
+  for(int i = 0; i < static_cast<int>(this->blocks.size()); ++i) {
+    vector<Person*> &people = this->blocks[i].people;
+    for(int j = 0; j < static_cast<int>(people.size()); ++j) {
+      this->copies[people[j]->get_pop_index()] = 0;
+    }
+  }
+  this->blocks.clear();
+  this->order.clear();
+  this->tree.clear();
+  this->group_tree.clear();
+  this->group_leaves = 0;
+  this->count = 0;
+}
+
+Person* Vaccine_Queue::get(int position) {
+  assert(0 <= position && position < this->count);
+  int offset;
+  int rank = find(position, &offset);
+  return this->blocks[this->order[rank]].people[offset];
+}
+
+void Vaccine_Queue::insert(int position, Person* person) {
+  assert(0 <= position && position <= this->count);
+  int idx = person->get_pop_index();
+  assert(0 <= idx);
+  if(static_cast<int>(this->copies.size()) <= idx) {
+    // grow geometrically; the population index bound only changes with births
+    int new_size = 2 * static_cast<int>(this->copies.size());
+    if(new_size <= idx) {
+      new_size = idx + 1;
+    }
+    this->copies.resize(new_size, 0);
+    this->block_of.resize(new_size, -1);
+  }
+  if(this->order.empty()) {
+    Block block;
+    block.rank = 0;
+    block.group_count.assign(Groups, 0);
+    this->blocks.push_back(block);
+    this->order.push_back(0);
+    build_tree();
+  }
+
+  int rank;
+  int offset;
+  if(position == this->count) {
+    rank = static_cast<int>(this->order.size()) - 1;
+    offset = static_cast<int>(this->blocks[this->order[rank]].people.size());
+  } else {
+    rank = find(position, &offset);
+  }
+  int id = this->order[rank];
+  Block &block = this->blocks[id];
+  int group = get_group(person);
+  block.people.insert(block.people.begin() + offset, person);
+  block.group.insert(block.group.begin() + offset, static_cast<unsigned char>(group));
+  add_to_tree(rank, 1);
+  add_to_group(rank, group, 1);
+  this->count++;
+  this->copies[idx]++;
+  if(this->copies[idx] == 1) {
+    this->block_of[idx] = id;
+  }
+  if(static_cast<int>(block.people.size()) > 2 * Block_size) {
+    split_block(id);
+  }
+}
+
+void Vaccine_Queue::erase(int position) {
+  assert(0 <= position && position < this->count);
+  int offset;
+  int rank = find(position, &offset);
+  erase_from_block(this->order[rank], offset);
+}
+
+bool Vaccine_Queue::remove(Person* person) {
+  int idx = person->get_pop_index();
+  if(idx < 0 || static_cast<int>(this->copies.size()) <= idx || this->copies[idx] == 0) {
+    return false;
+  }
+  int offset;
+  int id = find_block(person, &offset);
+  erase_from_block(id, offset);
+  return true;
+}
+
+Vaccine_Queue::Cursor Vaccine_Queue::begin() const {
+  Cursor cursor;
+  cursor.rank = 0;
+  cursor.offset = 0;
+  skip_empty_blocks(cursor);
+  return cursor;
+}
+
+void Vaccine_Queue::next(Cursor &cursor) const {
+  cursor.offset++;
+  skip_empty_blocks(cursor);
+}
+
+void Vaccine_Queue::seek(Cursor &cursor, const Group_Set &groups) const {
+  while(!at_end(cursor)) {
+    const Block &block = this->blocks[this->order[cursor.rank]];
+    if((block.groups & groups).any()) {
+      int size = static_cast<int>(block.people.size());
+      for(; cursor.offset < size; cursor.offset++) {
+        if(groups[block.group[cursor.offset]]) {
+          return;
+        }
+      }
+    }
+    cursor.rank = find_rank_with(cursor.rank + 1, groups);
+    cursor.offset = 0;
+  }
+}
+
+void Vaccine_Queue::erase(Cursor &cursor) {
+  // the position of the next person, in case the blocks are rebuilt
+  int position = cursor.offset;
+  for(int i = cursor.rank; i > 0; i -= (i & -i)) {
+    position += this->tree[i];
+  }
+  if(erase_from_block(this->order[cursor.rank], cursor.offset)) {
+    if(position < this->count) {
+      cursor.rank = find(position, &cursor.offset);
+    } else {
+      cursor.rank = static_cast<int>(this->order.size());
+      cursor.offset = 0;
+    }
+  }
+  skip_empty_blocks(cursor);
+}
+
+void Vaccine_Queue::build(const vector<Person*> &people) {
+  this->blocks.clear();
+  this->order.clear();
+  int n = static_cast<int>(people.size());
+  for(int first = 0; first < n; first += Block_size) {
+    int last = (first + Block_size < n ? first + Block_size : n);
+    int id = static_cast<int>(this->blocks.size());
+    this->blocks.push_back(Block());
+    Block &block = this->blocks.back();
+    block.rank = id;
+    block.people.assign(people.begin() + first, people.begin() + last);
+    count_groups(block);
+    this->order.push_back(id);
+    for(int i = first; i < last; ++i) {
+      this->block_of[people[i]->get_pop_index()] = id;
+    }
+  }
+  this->count = n;
+  build_tree();
+}
+
+void Vaccine_Queue::build_tree() {
+  int n = static_cast<int>(this->order.size());
+  this->tree.assign(n + 1, 0);
+  for(int i = 1; i <= n; ++i) {
+    this->tree[i] += static_cast<int>(this->blocks[this->order[i - 1]].people.size());
+    int parent = i + (i & -i);
+    if(parent <= n) {
+      this->tree[parent] += this->tree[i];
+    }
+  }
+
+  this->group_leaves = 1;
+  while(this->group_leaves < n) {
+    this->group_leaves *= 2;
+  }
+  this->group_tree.assign(2 * this->group_leaves, Group_Set());
+  for(int rank = 0; rank < n; ++rank) {
+    this->group_tree[this->group_leaves + rank] = this->blocks[this->order[rank]].groups;
+  }
+  for(int i = this->group_leaves - 1; i > 0; --i) {
+    this->group_tree[i] = this->group_tree[2 * i] | this->group_tree[2 * i + 1];
+  }
+}
+
+void Vaccine_Queue::add_to_tree(int rank, int delta) {
+  int n = static_cast<int>(this->order.size());
+  for(int i = rank + 1; i <= n; i += (i & -i)) {
+    this->tree[i] += delta;
+  }
+}
+
+void Vaccine_Queue::count_groups(Block &block) {
+  int size = static_cast<int>(block.people.size());
+  block.group.resize(size);
+  block.group_count.assign(Groups, 0);
+  block.groups.reset();
+  for(int i = 0; i < size; ++i) {
+    int group = get_group(block.people[i]);
+    block.group[i] = static_cast<unsigned char>(group);
+    block.group_count[group]++;
+    block.groups.set(group);
+  }
+}
+
+void Vaccine_Queue::add_to_group(int rank, int group, int delta) {
+  Block &block = this->blocks[this->order[rank]];
+  block.group_count[group] += delta;
+  bool held = (block.group_count[group] > 0);
+  if(block.groups[group] == held) {
+    return;
+  }
+  block.groups.set(group, held);
+  int i = this->group_leaves + rank;
+  this->group_tree[i] = block.groups;
+  for(i /= 2; i > 0; i /= 2) {
+    this->group_tree[i] = this->group_tree[2 * i] | this->group_tree[2 * i + 1];
+  }
+}
+
+int Vaccine_Queue::find(int position, int* offset) {
+  // descend the tree to the block whose range of positions holds position
+  int n = static_cast<int>(this->order.size());
+  int step = 1;
+  while(2 * step <= n) {
+    step *= 2;
+  }
+  int rank = 0;
+  for(; step > 0; step /= 2) {
+    if(rank + step <= n && this->tree[rank + step] <= position) {
+      rank += step;
+      position -= this->tree[rank];
+    }
+  }
+  *offset = position;
+  return rank;
+}
+
+int Vaccine_Queue::find_rank_with(int rank, const Group_Set &groups) const {
+  int n = static_cast<int>(this->order.size());
+  if(rank >= n) {
+    return n;
+  }
+  // climb to the first subtree at or right of rank holding one of groups
+  int i = this->group_leaves + rank;
+  while((this->group_tree[i] & groups).none()) {
+    while(i & 1) {
+      i /= 2;
+    }
+    if(i == 0) {
+      return n;
+    }
+    ++i;
+  }
+  // then down to its first such block
+  while(i < this->group_leaves) {
+    i *= 2;
+    if((this->group_tree[i] & groups).none()) {
+      ++i;
+    }
+  }
+  return i - this->group_leaves;
+}
+
+void Vaccine_Queue::skip_empty_blocks(Cursor &cursor) const {
+  int n = static_cast<int>(this->order.size());
+  while(cursor.rank < n
+        && cursor.offset >= static_cast<int>(this->blocks[this->order[cursor.rank]].people.size())) {
+    cursor.rank++;
+    cursor.offset = 0;
+  }
+}
+
+bool Vaccine_Queue::erase_from_block(int id, int offset) {
+  Block &block = this->blocks[id];
+  Person* person = block.people[offset];
+  int group = block.group[offset];
+  block.people.erase(block.people.begin() + offset);
+  block.group.erase(block.group.begin() + offset);
+  add_to_tree(block.rank, -1);
+  add_to_group(block.rank, group, -1);
+  this->count--;
+  int idx = person->get_pop_index();
+  this->copies[idx]--;
+  if(this->copies[idx] == 1) {
+    // block_of was not kept up while the person was queued twice
+    int other_offset;
+    this->block_of[idx] = scan_for(person, &other_offset);
+  }
+  if(block.people.empty() && static_cast<int>(this->order.size()) > 2 * (this->count / Block_size) + 8) {
+    // mostly empty blocks: rebuild from the people left
+    vector<Person*> left;
+    left.reserve(this->count);
+    for(int rank = 0; rank < static_cast<int>(this->order.size()); ++rank) {
+      vector<Person*> &block_people = this->blocks[this->order[rank]].people;
+      left.insert(left.end(), block_people.begin(), block_people.end());
+    }
+    build(left);
+    return true;
+  }
+  return false;
+}
+
+void Vaccine_Queue::split_block(int id) {
+  int new_id = static_cast<int>(this->blocks.size());
+  int rank = this->blocks[id].rank;
+  this->blocks.push_back(Block());
+  vector<Person*> &people = this->blocks[id].people;
+  int half = static_cast<int>(people.size()) / 2;
+  this->blocks[new_id].people.assign(people.begin() + half, people.end());
+  people.resize(half);
+  count_groups(this->blocks[id]);
+  count_groups(this->blocks[new_id]);
+  this->order.insert(this->order.begin() + rank + 1, new_id);
+  for(int r = rank + 1; r < static_cast<int>(this->order.size()); ++r) {
+    this->blocks[this->order[r]].rank = r;
+  }
+  vector<Person*> &moved = this->blocks[new_id].people;
+  for(int i = 0; i < static_cast<int>(moved.size()); ++i) {
+    this->block_of[moved[i]->get_pop_index()] = new_id;
+  }
+  build_tree();
+}
+
+int Vaccine_Queue::find_block(Person* person, int* offset) {
+  int idx = person->get_pop_index();
+  if(this->copies[idx] == 1) {
+    vector<Person*> &people = this->blocks[this->block_of[idx]].people;
+    *offset = static_cast<int>(std::find(people.begin(), people.end(), person) - people.begin());
+    assert(*offset < static_cast<int>(people.size()));
+    return this->block_of[idx];
+  }
+  // a person queued more than once: the first occurrence
+  return scan_for(person, offset);
+}
+
+int Vaccine_Queue::scan_for(Person* person, int* offset) {
+  for(int rank = 0; rank < static_cast<int>(this->order.size()); ++rank) {
+    vector<Person*> &people = this->blocks[this->order[rank]].people;
+    vector<Person*>::iterator found = std::find(people.begin(), people.end(), person);
+    if(found != people.end()) {
+      *offset = static_cast<int>(found - people.begin());
+      return this->order[rank];
+    }
+  }
+  assert(false);
+  return -1;
+}
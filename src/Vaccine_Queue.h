@@ -0,0 +1,157 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Vaccine_Queue.h
+//
+// Vaccine_Queue is an ordered queue of people waiting for a vaccine.  The
+// people are kept in contiguous blocks of a few hundred, in queue order,
+// with a Fenwick tree over the block sizes, so looking up, inserting or
+// erasing the person at a given position costs O(log n) plus a move
+// within one block.  A table indexed by population index records the
+// block holding each person, so removing a person (e.g. on death) does
+// not search the queue.
+//
+// Each block also records the year of birth (the group) of its people,
+// and a segment tree over the blocks records which groups each range of
+// blocks holds.  A Cursor walking the queue for the people born in some
+// years jumps over the blocks holding none of them in O(log n), and
+// within a block checks a byte per person instead of the person.
+//
+
+#ifndef _FRED_VACCINE_QUEUE_H
+#define _FRED_VACCINE_QUEUE_H
+
+#include <bitset>
+#include <vector>
+
+using namespace std;
+
+class Person;
+
+class Vaccine_Queue {
+public:
+  // groups of people by year of birth; the first and last groups also
+  // hold everyone born before or after them
+  static const int Groups = 128;
+  typedef bitset<Groups> Group_Set;
+
+  static int get_group(Person* person);
+
+  // the first and last birthday (in simulation time) in group
+  static void get_group_birthdays(int group, int* first, int* last);
+
+  // a place in the queue, for walking it in order
+  struct Cursor {
+    int rank;                       // of the block in order
+    int offset;                     // in the block
+  };
+
+  Vaccine_Queue() {
+    this->count = 0;
+    this->group_leaves = 0;
+  }
+
+  // replace the contents of the queue with people, in order
+  void assign(const vector<Person*> &people);
+
+  void clear();
+
+  int size() const {
+    return this->count;
+  }
+
+  bool empty() const {
+    return this->count == 0;
+  }
+
+  // the person at position (0 is the front of the queue)
+  Person* get(int position);
+
+  // insert person before position (size() appends)
+  void insert(int position, Person* person);
+
+  void push_front(Person* person) {
+    insert(0, person);
+  }
+
+  void push_back(Person* person) {
+    insert(this->count, person);
+  }
+
+  // erase the person at position
+  void erase(int position);
+
+  // erase the first occurrence of person; false if person is not queued
+  bool remove(Person* person);
+
+  // A cursor stays valid until the queue changes other than through
+  // erase(Cursor &).
+  Cursor begin() const;
+
+  bool at_end(const Cursor &cursor) const {
+    return cursor.rank == static_cast<int>(this->order.size());
+  }
+
+  Person* get(const Cursor &cursor) const {
+    return this->blocks[this->order[cursor.rank]].people[cursor.offset];
+  }
+
+  // move cursor to the next person
+  void next(Cursor &cursor) const;
+
+  // move cursor forward to the first person in one of groups, if it is
+  // not at one already (or to the end)
+  void seek(Cursor &cursor, const Group_Set &groups) const;
+
+  // erase the person at cursor; cursor moves to the next person
+  void erase(Cursor &cursor);
+
+private:
+  struct Block {
+    vector<Person*> people;
+    vector<unsigned char> group;    // of each of people
+    int rank;                       // position of the block in order
+    vector<int> group_count;        // people per group
+    Group_Set groups;               // the groups with people in the block
+  };
+
+  void build(const vector<Person*> &people);
+  void build_tree();
+  void add_to_tree(int rank, int delta);
+  void count_groups(Block &block);
+  void add_to_group(int rank, int group, int delta);
+  int find(int position, int* offset);
+  int find_rank_with(int rank, const Group_Set &groups) const;
+  void skip_empty_blocks(Cursor &cursor) const;
+  bool erase_from_block(int id, int offset);
+  void split_block(int id);
+  int find_block(Person* person, int* offset);
+  int scan_for(Person* person, int* offset);
+
+  vector<Block> blocks;
+  vector<int> order;                // block ids in queue order
+  vector<int> tree;                 // Fenwick tree over the sizes of order's blocks
+  int count;
+
+  // segment tree over the blocks in order: node i holds the groups of
+  // nodes 2i and 2i+1, and the leaves start at group_leaves
+  vector<Group_Set> group_tree;
+  int group_leaves;
+
+  // per population index: the block holding the person (valid when
+  // copies is 1) and the number of times the person is queued
+  vector<int> block_of;
+  vector<int> copies;
+};
+
+#endif // _FRED_VACCINE_QUEUE_H
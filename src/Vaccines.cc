@@ -120,6 +120,16 @@ int Vaccines::pick_from_applicable_vaccines(double real_age) const {
   return app_vaccs[randnum];
 }
 
+bool Vaccines::may_be_applicable(double low_age, double high_age) const {
+  for(unsigned int i=0;i<vaccines.size();i++){
+    if(vaccines[i]->get_current_stock() > 0 &&
+       vaccines[i]->get_dose(0)->get_efficacy_map()->has_nonzero_value(low_age, high_age)){
+      return true;
+    }
+  }
+  return false;
+}
+
 int Vaccines::get_total_vaccines_avail_today() const {
   int total=0;
   for(unsigned int i=0;i<vaccines.size();i++){
@@ -31,6 +31,8 @@ public:
   
   vector <int> which_vaccines_applicable(double real_age) const;
   int pick_from_applicable_vaccines(double real_age) const;
+  // whether a vaccine in stock may apply to someone aged from low to high
+  bool may_be_applicable(double low_age, double high_age) const;
   int get_total_vaccines_avail_today() const;
   
   
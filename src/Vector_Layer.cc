@@ -38,6 +38,7 @@ using namespace std;
 #include "Random.h"
 #include "Place.h"
 #include "Place_List.h"
+#include "Profile.h"
 #include "Household.h"
 #include "Tracker.h"
 
@@ -98,6 +99,9 @@ Vector_Layer::Vector_Layer() {
   this->life_span = 18.0; // From Chao and longini
   this->sucess_rate = 0.83; // Focks 2000
   this->female_ratio = 0.5; // Focks 2000
+  setup_binomial_draws(this->birth_draws, this->birth_rate);
+  setup_binomial_draws(this->death_draws, this->death_rate);
+  setup_binomial_draws(this->incubation_draws, this->incubation_rate);
 
   // get vector_control parameters
   int temp_int;
@@ -475,6 +479,12 @@ void Vector_Layer::read_temperature(){
     Utils::fred_abort("Cannot  open %s to read the average temperature grid \n", filename);
   }
   fclose(fp);
+  // the temperatures are fixed, so the vectors per host of each patch are too
+  for(int i = 0; i < this->rows; ++i) {
+    for(int j = 0; j < this->cols; ++j) {
+      this->grid[i][j].set_vectors_per_host(get_vectors_per_host(this->grid[i][j].get_temperature()));
+    }
+  }
 }
 void Vector_Layer::seed_patches_by_distance_in_km(fred::geo lat, fred::geo lon,
 						  double radius_in_km, int dis,int day_on, int day_off,double seeds_) {
@@ -927,6 +937,22 @@ void Vector_Layer::init_prior_immunity_by_county(int d) {
 
 
 double Vector_Layer::get_vectors_per_host(Place* place) {
+  // computed for each patch when the temperatures are read
+  double temperature = -999.9;
+  double vectors_per_host = 0.0;
+  fred::geo lat = place->get_latitude();
+  fred::geo lon = place->get_longitude();
+  Vector_Patch* patch = get_patch(lat,lon);
+  if(patch != NULL) {
+    temperature = patch->get_temperature();
+    vectors_per_host = patch->get_vectors_per_host();
+  }
+  FRED_VERBOSE(1, "SET TEMP: place %s lat %lg lon %lg temp %f vectors_per_host %f N_orig %d\n",
+	       place->get_label(), place->get_latitude(), place->get_longitude(), temperature, vectors_per_host, place->get_orig_size());
+  return vectors_per_host;
+}
+
+double Vector_Layer::get_vectors_per_host(double temperature) {
 
   double development_time = 1.0;
   double vectors_per_host = 0.0;
@@ -935,13 +961,6 @@ double Vector_Layer::get_vectors_per_host(Place* place) {
   double temps[8]= {15.0,20.0,22.0,24.0,26.0,28.0,30.0,32.0};  //temperatures
   double dev_times[8] =  {8.49,3.11,4.06,3.3,2.66,2.04,1.46,0.92};//development times
 
-  double temperature = -999.9;
-  fred::geo lat = place->get_latitude();
-  fred::geo lon = place->get_longitude();
-  Vector_Patch* patch = get_patch(lat,lon);
-  if(patch != NULL) {
-    temperature = patch->get_temperature();
-  }
   if(temperature > 32) {
     temperature = 32;
   }
@@ -957,153 +976,141 @@ double Vector_Layer::get_vectors_per_host(Place* place) {
     }
     vectors_per_host = pupae_per_host * female_ratio * sucess_rate * life_span / development_time;
   }
-  FRED_VERBOSE(1, "SET TEMP: place %s lat %lg lon %lg temp %f devtime %f vectors_per_host %f N_orig %d\n",
-	       place->get_label(), place->get_latitude(), place->get_longitude(),temperature, development_time, vectors_per_host,place->get_orig_size());
   return vectors_per_host;
 }
 
-vector_disease_data_t Vector_Layer::update_vector_population(int day, Place * place) {
-
-  place->mark_vectors_as_not_infected_today();
-
-  vector_disease_data_t v = place->get_vector_disease_data();
-
-  if(day > vector_control_day_off){
-    place->stop_vector_control();
+void Vector_Layer::setup_binomial_draws(std::vector<Alias_Table> &draws, double p) {
+  int max_n = 2 * this->life_span;
+  draws.resize(max_n);
+  for(int n = 0; n < max_n; ++n) {
+    std::vector<double> cdf(n + 1);
+    double coefficient = 1.0;
+    double sum = 0.0;
+    for(int k = 0; k <= n; ++k) {
+      sum += coefficient * pow(p, k) * pow(1.0 - p, n - k);
+      cdf[k] = sum;
+      coefficient = coefficient * (n - k) / (k + 1);
+    }
+    cdf[n] = 1.0;
+    draws[n].set_cdf(cdf);
   }
-  
-  if(place->is_neighborhood()){
-    return v;
+}
+
+// successes among n trials with probability p, from the table if n is small
+int Vector_Layer::draw_binomial(const std::vector<Alias_Table> &draws, int n, double p) {
+  if(n <= 0) {
+    return 0;
   }
-  
-  if(v.N_vectors <= 0) {
-    return v;
+  if(n < static_cast<int>(draws.size())) {
+    return draws[n].draw();
   }
+  return Random::draw_binomial(n, p);
+}
 
-  if(place->get_vector_control_status()){
-    int N_host_orig = place->get_orig_size();
-    v.N_vectors = N_host_orig * this->get_vectors_per_host(place) * (1 - vector_control_efficacy);
-    if(v.N_vectors < 0){
-      v.N_vectors = 0;
-    }
-    FRED_VERBOSE(1,"update vector pop::Vector_control day %d place %s  N_vectors: %d efficacy: %f\n",day,place->get_label(),v.N_vectors,vector_control_efficacy);
-  }
-  /*else{
-    int N_host_orig = place->get_orig_size();
-    v.N_vectors = N_host_orig * this->get_vectors_per_host(place);
-    }*/
-  FRED_VERBOSE(1,"update vector pop: day %d place %s initially: S %d, N: %d\n",
-	       day,place->get_label(),v.S_vectors,v.N_vectors);
-  
-  int born_infectious[DISEASE_TYPES];
-  int total_born_infectious = 0;
+void Vector_Layer::update_vector_population(int day) {
+  FRED_PROFILE("update_vector_population");
   int lifespan_ = 1/this->death_rate;
-
-  // new vectors are born susceptible
-  if(v.N_vectors < lifespan_){
-    for(int k = 0; k < v.N_vectors; k++){
-      double r = Random::draw_random(0,1);
-      if(r < this->birth_rate){
-	v.S_vectors++;
-      }
+  int number_of_places = this->vector_state.get_number_of_places();
+  Vector_State &v = this->vector_state;
+
+  // Each slot draws from its own keyed stream, so the counts do not
+  // depend on the number of threads.  Below the vector lifespan the
+  // births, deaths and incubations are binomial draws; above it they are
+  // the expected numbers.
+#pragma omp parallel for schedule(dynamic, 256)
+  for(int p = 0; p < number_of_places; ++p) {
+    v.infected_today[p] = false;
+    if(day > vector_control_day_off) {
+      v.vector_control[p] = false;
     }
-    for(int k = 0; k < v.S_vectors; k++){
-      double r = Random::draw_random(0,1);
-      if(r < this->death_rate){
-	v.S_vectors--;
-      }
+    // (neighborhoods have no vectors)
+    if(v.N_vectors[p] <= 0) {
+      continue;
     }
-  }else{
-    v.S_vectors += floor(this->birth_rate * v.N_vectors - this->death_rate * v.S_vectors);
-  }
-  FRED_VERBOSE(1,"vector_update_population:: S_vector: %d, N_vectors: %d\n", v.S_vectors, v.N_vectors);
-
-  // but some are infected
-  for(int d=0;d<DISEASE_TYPES;d++){
-    double seeds = place->get_seeds(d, day);
-    born_infectious[d] = ceil(v.S_vectors * seeds);
-    total_born_infectious += born_infectious[d];
-    if(born_infectious[d] > 0) {
-      FRED_VERBOSE(1,"vector_update_population:: Vector born infectious disease[%d] = %d \n",d, born_infectious[d]);
-      FRED_VERBOSE(1,"Total Vector born infectious: %d \n", total_born_infectious);
-    }
-  }
 
-  v.S_vectors -= total_born_infectious;
-  FRED_VERBOSE(1,"vector_update_population - seeds:: S_vector: %d, N_vectors: %d\n", v.S_vectors, v.N_vectors);
-  // print this 
-  if(total_born_infectious > 0){
-    FRED_VERBOSE(1,"Total Vector born infectious: %d \n", total_born_infectious);// 
-  }
-  if(v.S_vectors < 0) {
-    v.S_vectors = 0;
-  }
-    
-  // accumulate total number of vectors
-  v.N_vectors = v.S_vectors;
-  // we assume vectors can have at most one infection, if not susceptible
-  for(int i = 0; i < DISEASE_TYPES; ++i) {
-    // some die
-    FRED_VERBOSE(1,"vector_update_population:: E_vectors[%d] = %d \n",i, v.E_vectors[i]);
-    if(v.E_vectors[i] < lifespan_ && v.E_vectors[i] > 0){
-      for(int k = 0; k < v.E_vectors[i]; ++k) {
-	double r = Random::draw_random(0,1);
-	if(r < this->death_rate){
-	  v.E_vectors[i]--;
-	}
+    if(v.vector_control[p]) {
+      Place* place = v.places[p];
+      v.N_vectors[p] = place->get_orig_size() * v.vectors_per_host[p] * (1 - vector_control_efficacy);
+      if(v.N_vectors[p] < 0) {
+	v.N_vectors[p] = 0;
       }
-    } else {
-      v.E_vectors[i] -= floor(this->death_rate * v.E_vectors[i]);
-    } 
+      FRED_VERBOSE(1, "update vector pop::Vector_control day %d place %s  N_vectors: %d efficacy: %f\n",
+		   day, place->get_label(), v.N_vectors[p], vector_control_efficacy);
+    }
 
-    // some become infectious
-    int become_infectious = 0;
-    if(v.E_vectors[i] < lifespan_) {
-      for(int k = 0; k < v.E_vectors[i]; ++k) {
-	double r = Random::draw_random(0,1);
-	if(r < this->incubation_rate) {
-	  become_infectious++;
-	}
-      }
+    Random::begin_vector_stream(day, p);
+
+    // new vectors are born susceptible
+    int S = v.S_vectors[p];
+    if(v.N_vectors[p] < lifespan_) {
+      S += draw_binomial(this->birth_draws, v.N_vectors[p], this->birth_rate);
+      S -= draw_binomial(this->death_draws, S, this->death_rate);
     } else {
-      become_infectious = floor(this->incubation_rate * v.E_vectors[i]);
+      S += floor(this->birth_rate * v.N_vectors[p] - this->death_rate * S);
     }
-      
-    // int become_infectious = floor(incubation_rate * E_vectors[i]);
-    FRED_VERBOSE(1,"vector_update_population:: become infectious [%d] = %d, incubation rate: %f,E_vectors[%d] %d \n", i,
-		 become_infectious, this->incubation_rate, i, v.E_vectors[i]);
-    v.E_vectors[i] -= become_infectious;
-    if(v.E_vectors[i] < 0) v.E_vectors[i] = 0;
-    // some die
-    FRED_VERBOSE(1,"vector_update_population:: I_Vectors[%d] = %d \n", i, v.I_vectors[i]);
-    if(v.I_vectors[i] < lifespan_ && v.I_vectors[i] > 0){
-      for(int k = 0; k < v.I_vectors[i]; k++){
-	double r = Random::draw_random(0,1);
-	if(r < this->death_rate){
-	  v.I_vectors[i]--;
-	}
-      }
-    }else{
-      v.I_vectors[i] -= floor(this->death_rate * v.I_vectors[i]);
+
+    // but some are infected
+    int born_infectious[VECTOR_DISEASE_TYPES];
+    int total_born_infectious = 0;
+    for(int d = 0; d < VECTOR_DISEASE_TYPES; ++d) {
+      born_infectious[d] = (day == 0 ? ceil(S * v.get_seeds(p, d, day)) : 0);
+      total_born_infectious += born_infectious[d];
     }
-    FRED_VERBOSE(1,"vector_update_population:: I_Vectors[%d] = %d \n", i, v.I_vectors[i]);
-    // some become infectious
-    v.I_vectors[i] += become_infectious;
-    FRED_VERBOSE(1,"vector_update_population:: I_Vectors[%d] = %d \n", i, v.I_vectors[i]);
-    // some were born infectious
-    v.I_vectors[i] += born_infectious[i];
-    FRED_VERBOSE(1,"vector_update_population::+= born infectious I_Vectors[%d] = %d,born infectious[%d] = %d \n", i,
-		 v.I_vectors[i], i, born_infectious[i]);
-    if(v.I_vectors[i] < 0) {
-      v.I_vectors[i] = 0;
+    S -= total_born_infectious;
+    if(S < 0) {
+      S = 0;
+    }
+    v.S_vectors[p] = S;
+
+    // accumulate total number of vectors
+    int N = S;
+    // we assume vectors can have at most one infection, if not susceptible
+    for(int i = 0; i < VECTOR_DISEASE_TYPES; ++i) {
+      int E = v.E_vectors[i][p];
+      int I = v.I_vectors[i][p];
+      if(E == 0 && I == 0 && born_infectious[i] == 0) {
+	// nothing to update for this disease (the usual case)
+	continue;
+      }
+      // some die
+      if(E < lifespan_ && E > 0) {
+	E -= draw_binomial(this->death_draws, E, this->death_rate);
+      } else {
+	E -= floor(this->death_rate * E);
+      }
+      // some become infectious
+      int become_infectious = 0;
+      if(E < lifespan_) {
+	become_infectious = draw_binomial(this->incubation_draws, E, this->incubation_rate);
+      } else {
+	become_infectious = floor(this->incubation_rate * E);
+      }
+      E -= become_infectious;
+      if(E < 0) {
+	E = 0;
+      }
+      // some die
+      if(I < lifespan_ && I > 0) {
+	I -= draw_binomial(this->death_draws, I, this->death_rate);
+      } else {
+	I -= floor(this->death_rate * I);
+      }
+      // some become infectious and some were born infectious
+      I += become_infectious + born_infectious[i];
+      if(I < 0) {
+	I = 0;
+      }
+      v.E_vectors[i][p] = E;
+      v.I_vectors[i][p] = I;
+      // add to the total
+      N += E + I;
     }
-    // add to the total
-    v.N_vectors += (v.E_vectors[i] + v.I_vectors[i]);
-    FRED_VERBOSE(1, "update_vector_population entered S_vectors %d E_Vectors[%d] %d  I_Vectors[%d] %d N_Vectors %d\n",
-		 v.S_vectors, i, v.E_vectors[i], i, v.I_vectors[i], v.N_vectors);
+    v.N_vectors[p] = N;
+    Random::end_stream();
 
+    FRED_VERBOSE(1, "update_vector_population day %d place %s S_vectors %d born infectious %d N_vectors %d\n",
+		 day, v.places[p]->get_label(), S, total_born_infectious, N);
   }
-  return v;
 }
 
 
@@ -20,6 +20,8 @@
 #include "Global.h"
 #include "Abstract_Grid.h"
 #include "Neighborhood_Patch.h"
+#include "Random.h"
+#include "Vector_State.h"
 #include <fstream>
 
 class Epidemic;
@@ -42,6 +44,7 @@ public:
   void update_visualization_data(int disease_id, int day);
   void add_hosts(Place * p);
   double get_vectors_per_host(Place * p);
+  double get_vectors_per_host(double temperature);
   double get_seeds(Place * place, int dis, int day);
   void add_host(Person * person, Place * place);
   void read_temperature();
@@ -58,7 +61,13 @@ public:
   double get_day_start_seed(Place * p, int dis);
   double get_day_end_seed(Place * p, int dis);
   void report(int day, Epidemic * epidemic);
-  vector_disease_data_t update_vector_population(int day, Place * place);
+  Vector_State & get_vector_state() { return this->vector_state; }
+
+  /**
+   * Births, deaths, seeding and incubation of the vectors of every place
+   * for the day, in one parallel pass over the Vector_State.
+   */
+  void update_vector_population(int day);
   double get_bite_rate() { return this->bite_rate; }
   void get_vector_population(int disease_id);
 
@@ -78,7 +87,11 @@ protected:
   void immunize_by_age(int d);
   void seed_patches_by_distance_in_km(fred::geo lat, fred::geo lon, double radius_in_km, int dis,int day_on, int day_off,double seeds_);
 
+  void setup_binomial_draws(std::vector<Alias_Table> &draws, double p);
+  int draw_binomial(const std::vector<Alias_Table> &draws, int n, double p);
+
   Vector_Patch ** grid;			 // Rectangular array of patches
+  Vector_State vector_state;		 // vector counts of every place
 
   // fixed parameters for this disease vector
   double infection_efficiency;
@@ -95,6 +108,12 @@ protected:
   double sucess_rate;
   double female_ratio;
 
+  // binomial distributions of births, deaths and incubations among
+  // n < 2 * life_span vectors, indexed by n
+  std::vector<Alias_Table> birth_draws;
+  std::vector<Alias_Table> death_draws;
+  std::vector<Alias_Table> incubation_draws;
+
   std::vector<int>census_tracts_with_vector_control;
 
   int vector_pop;
@@ -40,6 +40,8 @@ public:
   void set_mosquito_index(double index_);	
   void set_vector_seeds(int dis,int day_on, int day_off,double seeds_);
   double get_temperature(){return temperature;}
+  void set_vectors_per_host(double vectors_per_host_){vectors_per_host = vectors_per_host_;}
+  double get_vectors_per_host(){return vectors_per_host;}
   double get_mosquito_index(){return house_index;}
   double get_seeds(int dis) { return seeds[dis];}
   int get_day_start_seed(int dis) { return day_start_seed[dis];}
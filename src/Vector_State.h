@@ -0,0 +1,136 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Vector_State.h
+//
+// The vector (mosquito) counts of every place in the vector transmission
+// model, one column per count.  A place gets a slot when its vector
+// model is set up (Place::setup_vector_model) and reads and changes its
+// counts through it; Vector_Layer::update_vector_population updates all
+// the slots in one pass without touching the places themselves.
+//
+
+#ifndef _FRED_VECTOR_STATE_H
+#define _FRED_VECTOR_STATE_H
+
+#include <vector>
+
+#include "Global.h"
+
+class Place;
+
+class Vector_State {
+public:
+
+  /**
+   * Add a place with N_vectors susceptible vectors.  Returns its slot.
+   */
+  int add_place(Place* place, double vectors_per_host, int N_vectors) {
+    int slot = this->places.size();
+    this->places.push_back(place);
+    this->vectors_per_host.push_back(vectors_per_host);
+    this->N_vectors.push_back(N_vectors);
+    this->S_vectors.push_back(N_vectors);
+    this->infected_today.push_back(false);
+    this->vector_control.push_back(false);
+    for(int i = 0; i < VECTOR_DISEASE_TYPES; ++i) {
+      this->E_vectors[i].push_back(0);
+      this->I_vectors[i].push_back(0);
+      this->place_seeds[i].push_back(0);
+      this->day_start_seed[i].push_back(0);
+      this->day_end_seed[i].push_back(0);
+    }
+    return slot;
+  }
+
+  void set_seeds(int slot, int disease_id, int seeds, int day_start, int day_end) {
+    this->place_seeds[disease_id][slot] = seeds;
+    this->day_start_seed[disease_id][slot] = day_start;
+    this->day_end_seed[disease_id][slot] = day_end;
+  }
+
+  int get_number_of_places() const {
+    return this->places.size();
+  }
+
+  Place* get_place(int slot) const {
+    return this->places[slot];
+  }
+
+  double get_vectors_per_host(int slot) const {
+    return this->vectors_per_host[slot];
+  }
+
+  int get_vector_population_size(int slot) const {
+    return this->N_vectors[slot];
+  }
+
+  int get_susceptible_vectors(int slot) const {
+    return this->S_vectors[slot];
+  }
+
+  int get_infected_vectors(int slot, int disease_id) const {
+    return this->E_vectors[disease_id][slot] + this->I_vectors[disease_id][slot];
+  }
+
+  int get_infectious_vectors(int slot, int disease_id) const {
+    return this->I_vectors[disease_id][slot];
+  }
+
+  void mark_vectors_as_infected_today(int slot) {
+    this->infected_today[slot] = true;
+  }
+
+  bool have_vectors_been_infected_today(int slot) const {
+    return this->infected_today[slot];
+  }
+
+  bool get_vector_control_status(int slot) const {
+    return this->vector_control[slot];
+  }
+
+  void set_vector_control(int slot) {
+    this->vector_control[slot] = true;
+  }
+
+  void expose_vectors(int slot, int disease_id, int exposed_vectors) {
+    this->E_vectors[disease_id][slot] += exposed_vectors;
+    this->S_vectors[slot] -= exposed_vectors;
+  }
+
+  // seeds are only born infectious on day 0
+  double get_seeds(int slot, int disease_id, int day) const {
+    if(day || day > this->day_end_seed[disease_id][slot]) {
+      return 0.0;
+    } else {
+      return this->place_seeds[disease_id][slot];
+    }
+  }
+
+private:
+  std::vector<Place*> places;
+  std::vector<double> vectors_per_host;
+  std::vector<int> N_vectors;
+  std::vector<int> S_vectors;
+  std::vector<int> E_vectors[VECTOR_DISEASE_TYPES];
+  std::vector<int> I_vectors[VECTOR_DISEASE_TYPES];
+  std::vector<int> place_seeds[VECTOR_DISEASE_TYPES];
+  std::vector<int> day_start_seed[VECTOR_DISEASE_TYPES];
+  std::vector<int> day_end_seed[VECTOR_DISEASE_TYPES];
+  std::vector<char> infected_today;
+  std::vector<char> vector_control;
+
+  friend class Vector_Layer;
+};
+
+#endif // _FRED_VECTOR_STATE_H
@@ -0,0 +1,81 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+// Converts an infections<run>.bin file written with
+// infection_log_format = binary to the text of infections<run>.txt.
+//
+// usage: fred_infections_dump infections.bin [infections.txt]
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "Infection_Log_Format.h"
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    fprintf(stderr, "usage: fred_infections_dump infections.bin [infections.txt]\n");
+    return 1;
+  }
+  FILE* in = fopen(argv[1], "rb");
+  if(in == NULL) {
+    fprintf(stderr, "fred_infections_dump: can't read %s\n", argv[1]);
+    return 1;
+  }
+  FILE* out = stdout;
+  if(argc > 2) {
+    out = fopen(argv[2], "w");
+    if(out == NULL) {
+      fprintf(stderr, "fred_infections_dump: can't write %s\n", argv[2]);
+      return 1;
+    }
+  }
+
+  Infection_Log_Header header;
+  if(fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, INFECTION_LOG_MAGIC, sizeof(header.magic)) != 0) {
+    fprintf(stderr, "fred_infections_dump: %s is not a FRED infection log\n", argv[1]);
+    return 1;
+  }
+  if(header.version != INFECTION_LOG_VERSION || header.record_size != (int) sizeof(Infection_Record)) {
+    fprintf(stderr, "fred_infections_dump: %s has version %d and record size %d, expected %d and %d\n",
+            argv[1], header.version, header.record_size, INFECTION_LOG_VERSION, (int) sizeof(Infection_Record));
+    return 1;
+  }
+  std::vector<std::string> names;
+  for(int d = 0; d < header.diseases; ++d) {
+    Infection_Log_Name name;
+    if(fread(&name, sizeof(name), 1, in) != 1) {
+      fprintf(stderr, "fred_infections_dump: %s is truncated\n", argv[1]);
+      return 1;
+    }
+    name.name[sizeof(name.name) - 1] = '\0';
+    names.push_back(name.name);
+  }
+
+  std::vector<Infection_Record> records(4096);
+  std::string text;
+  size_t n;
+  while((n = fread(records.data(), sizeof(Infection_Record), records.size(), in)) > 0) {
+    text.clear();
+    for(size_t i = 0; i < n; ++i) {
+      int disease = records[i].disease;
+      const char* name = (disease >= 0 && disease < (int) names.size() ? names[disease].c_str() : "?");
+      format_infection_record(records[i], header.level, name, text);
+    }
+    fputs(text.c_str(), out);
+  }
+  fclose(in);
+  if(out != stdout) {
+    fclose(out);
+  }
+  return 0;
+}